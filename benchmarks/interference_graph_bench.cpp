@@ -0,0 +1,833 @@
+// Benchmark: InterferenceGraph::update selon le mode d'énumération
+// Vérifie que FullNeighbour / HalfPair (serial et TBB) donnent le même graphe
+// et compare le nombre de tests de distance, puis le coût par paire candidate
+// des modèles de propagation (sans ombrage: même graphe que le disque) et le
+// mode SINR (agrégation lointaine contre la somme exacte en O(n^2)),
+// l'obstruction par des bâtiments (cache de visibilité froid puis chaud), et
+// les listes de Verlet sur une flotte en mouvement (taux de reconstruction),
+// le découpage du R-tree par classes de rayon (flottes à rayons mixtes),
+// les instanciations du noyau (rayon uniforme, métrique planaire),
+// le coût des métriques de topologie (GraphMetrics) selon l'échantillonnage,
+// la génération des beacons CAM (BeaconScheduler) sur le graphe de référence,
+// la lecture des versions publiées (GraphSnapshot) pendant des updates, et
+// le débit des requêtes spatiales (kNN, anneau, polygone, couloir) servies
+// par ces versions, l'association des véhicules aux RSU (grille de
+// couverture précalculée contre une requête R-tree par véhicule), et le
+// mode paresseux (update sans adjacence, lignes calculées à la demande).
+//
+// Usage: interference_graph_bench [nombreVehicules] [rayonsMixtes 0|1] [repetitions]
+
+#include "network/InterferenceGraph.hpp"
+#include "network/PropagationModel.hpp"
+#include "network/BuildingIndex.hpp"
+#include "network/GraphMetrics.hpp"
+#include "network/BeaconScheduler.hpp"
+#include "network/GraphSnapshot.hpp"
+#include "network/RoadsideUnits.hpp"
+#include "network/ChannelAssignment.hpp"
+#include "data/GeometryUtils.hpp"
+#include <cmath>
+#include "core/Vehicle.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using v2v::core::Vehicle;
+using v2v::network::InterferenceGraph;
+using v2v::network::PropagationModel;
+using v2v::network::BuildingIndex;
+using v2v::network::GraphMetrics;
+using v2v::network::BeaconScheduler;
+using v2v::network::Point2D;
+using v2v::network::Polygon2D;
+using v2v::network::NearVehicle;
+using v2v::network::RoadsideUnits;
+using v2v::network::ChannelAssignment;
+using v2v::data::GeometryUtils;
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+using v2v::network::LinkMetric;
+using v2v::network::LinkRadius;
+using Mode = InterferenceGraph::EnumerationMode;
+
+namespace {
+
+std::vector<std::shared_ptr<Vehicle>> makeFleet(int count, bool mixedRadii) {
+    std::mt19937 gen(7);
+    // Zone géographique de Mulhouse (comme SimulationEngine en mode simple)
+    std::uniform_real_distribution<> latDist(47.70, 47.80);
+    std::uniform_real_distribution<> lonDist(7.30, 7.40);
+    std::uniform_int_distribution<> radiusDist(100, 500);
+    
+    std::vector<std::shared_ptr<Vehicle>> vehicles;
+    vehicles.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto vehicle = std::make_shared<Vehicle>(i);
+        vehicle->setGeoPosition(latDist(gen), lonDist(gen));
+        if (mixedRadii) {
+            vehicle->setTransmissionRadius(radiusDist(gen));
+        }
+        vehicles.push_back(vehicle);
+    }
+    return vehicles;
+}
+
+// Quartier en damier sur la même zone: îlots de 80 m séparés par des rues de 20 m
+std::shared_ptr<BuildingIndex> makeBlocks() {
+    constexpr double METERS_PER_DEGREE = 111195.0;
+    const double cosLat = std::cos(47.75 * 3.14159265358979323846 / 180.0);
+    auto point = [&](double x, double y) {
+        return Point2D(7.30 + x / (METERS_PER_DEGREE * cosLat), 47.70 + y / METERS_PER_DEGREE);
+    };
+    
+    auto buildings = std::make_shared<BuildingIndex>();
+    for (double x = 20.0; x + 80.0 < 0.10 * METERS_PER_DEGREE * cosLat; x += 100.0) {
+        for (double y = 20.0; y + 80.0 < 0.10 * METERS_PER_DEGREE; y += 100.0) {
+            buildings->addFootprint({point(x, y), point(x + 80.0, y), point(x + 80.0, y + 80.0),
+                                     point(x, y + 80.0), point(x, y)});
+        }
+    }
+    buildings->build();
+    return buildings;
+}
+
+// Déplace chaque véhicule de meters mètres selon son cap (radians, fixe)
+void moveFleet(const std::vector<std::shared_ptr<Vehicle>>& vehicles, const std::vector<double>& headings,
+               double meters) {
+    constexpr double METERS_PER_DEGREE = 111195.0;
+    for (size_t i = 0; i < vehicles.size(); ++i) {
+        const double lat = vehicles[i]->getLatitude();
+        const double cosLat = std::cos(lat * 3.14159265358979323846 / 180.0);
+        vehicles[i]->setGeoPosition(lat + meters * std::cos(headings[i]) / METERS_PER_DEGREE,
+                                    vehicles[i]->getLongitude() + meters * std::sin(headings[i]) / (METERS_PER_DEGREE * cosLat));
+    }
+}
+
+bool sameGraph(const InterferenceGraph& a, const InterferenceGraph& b, int vehicleCount) {
+    if (a.getConnectionCount() != b.getConnectionCount()) {
+        return false;
+    }
+    for (int id = 0; id < vehicleCount; ++id) {
+        auto na = a.getNeighbors(id);
+        auto nb = b.getNeighbors(id);
+        if (!std::equal(na.begin(), na.end(), nb.begin(), nb.end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Liens présents dans un seul des deux graphes
+size_t linkDifference(const InterferenceGraph& a, const InterferenceGraph& b, int vehicleCount) {
+    size_t different = 0;
+    for (int id = 0; id < vehicleCount; ++id) {
+        auto na = a.getNeighbors(id);
+        auto nb = b.getNeighbors(id);
+        std::vector<int> only;
+        std::set_symmetric_difference(na.begin(), na.end(), nb.begin(), nb.end(), std::back_inserter(only));
+        different += only.size();
+    }
+    return different / 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int vehicleCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    const bool mixedRadii = argc > 2 ? std::atoi(argv[2]) != 0 : false;
+    const int repetitions = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+    
+    auto vehicles = makeFleet(vehicleCount, mixedRadii);
+    std::printf("InterferenceGraph::update: %d vehicles, %s radii, %d repetitions\n",
+                vehicleCount, mixedRadii ? "mixed 100-500 m" : "uniform 300 m", repetitions);
+    
+    struct Config { const char* name; Mode mode; bool parallel; };
+    const Config configs[] = {
+        {"full / serial", Mode::FullNeighbour, false},
+        {"full / TBB", Mode::FullNeighbour, true},
+        {"half-pair / serial", Mode::HalfPair, false},
+        {"half-pair / TBB", Mode::HalfPair, true},
+    };
+    
+    InterferenceGraph reference;
+    reference.setEnumerationMode(Mode::FullNeighbour);
+    reference.setParallelDiscovery(false);
+    reference.update(vehicles);
+    const double referenceEvaluations = static_cast<double>(reference.getDistanceEvaluations());
+    
+    bool allIdentical = true;
+    for (const auto& config : configs) {
+        InterferenceGraph graph;
+        graph.setEnumerationMode(config.mode);
+        graph.setParallelDiscovery(config.parallel);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions; ++rep) {
+            graph.update(vehicles);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        const bool identical = sameGraph(reference, graph, vehicleCount);
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  %-20s %8.2f ms/update  %10llu distance evals (%5.1f%%)  %zu links  %s\n",
+                    config.name,
+                    std::chrono::duration<double, std::milli>(end - start).count() / repetitions,
+                    static_cast<unsigned long long>(graph.getDistanceEvaluations()),
+                    100.0 * graph.getDistanceEvaluations() / std::max(referenceEvaluations, 1.0),
+                    graph.getConnectionCount(),
+                    identical ? "identical" : "MISMATCH");
+    }
+    
+    // Modèles de propagation (full / serial): coût par test de distance
+    std::printf("Propagation models (full / serial):\n");
+    const std::shared_ptr<const PropagationModel> models[] = {
+        nullptr,
+        std::make_shared<PropagationModel>(PropagationModel::Type::FreeSpace),
+        std::make_shared<PropagationModel>(PropagationModel::Type::TwoRayGround),
+        std::make_shared<PropagationModel>(PropagationModel::Type::LogDistanceShadowing),
+    };
+    
+    for (const auto& model : models) {
+        InterferenceGraph graph;
+        graph.setParallelDiscovery(false);
+        graph.setPropagationModel(model);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions; ++rep) {
+            graph.update(vehicles);
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+        
+        // Sans ombrage le graphe doit être celui du disque; avec ombrage,
+        // le mode HalfPair doit tirer les mêmes liens
+        bool identical;
+        if (!model || model->isDeterministic()) {
+            identical = sameGraph(reference, graph, vehicleCount);
+        } else {
+            InterferenceGraph halfPair;
+            halfPair.setEnumerationMode(Mode::HalfPair);
+            halfPair.setPropagationModel(model);
+            halfPair.update(vehicles);
+            identical = sameGraph(graph, halfPair, vehicleCount);
+        }
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  %-26s %8.2f ms/update  %6.1f ns/candidate  %zu links  %s\n",
+                    model ? PropagationModel::typeName(model->getType()) : "disk",
+                    ms,
+                    1e6 * ms / std::max<double>(graph.getDistanceEvaluations(), 1.0),
+                    graph.getConnectionCount(),
+                    identical ? "identical" : "MISMATCH");
+    }
+    
+    // Mode SINR: tous les véhicules émettent; 0 = somme exacte (petites flottes)
+    std::printf("SINR mode (full / TBB, all vehicles transmitting):\n");
+    const double openingAngles[] = {0.0, 0.5, 1.0};
+    for (double theta : openingAngles) {
+        if (theta == 0.0 && vehicleCount > 10000) continue;
+        
+        InterferenceGraph graph;
+        graph.setSinrMode(true);
+        graph.setFarFieldOpeningAngle(theta);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions; ++rep) {
+            graph.update(vehicles);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        std::printf("  theta %.1f  %8.2f ms/update  %8.1f power terms/receiver  %zu links\n",
+                    theta,
+                    std::chrono::duration<double, std::milli>(end - start).count() / repetitions,
+                    static_cast<double>(graph.getInterferenceTerms()) / vehicleCount,
+                    graph.getConnectionCount());
+    }
+    
+    // Bâtiments: premier update (cache vide) puis updates aux mêmes positions
+    std::printf("Building obstruction (full, obstructed links rejected):\n");
+    const auto buildings = makeBlocks();
+    InterferenceGraph serialGraph;
+    serialGraph.setParallelDiscovery(false);
+    serialGraph.setBuildingIndex(buildings);
+    for (bool parallel : {false, true}) {
+        InterferenceGraph graph;
+        graph.setParallelDiscovery(parallel);
+        graph.setBuildingIndex(buildings);
+        
+        auto start = std::chrono::steady_clock::now();
+        graph.update(vehicles);
+        auto cold = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions; ++rep) {
+            graph.update(vehicles);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        if (!parallel) {
+            serialGraph.update(vehicles);
+        }
+        const bool identical = sameGraph(serialGraph, graph, vehicleCount);
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  %-8s cold %8.2f ms  warm %8.2f ms/update  %llu LOS queries  %zu links  %s\n",
+                    parallel ? "TBB" : "serial",
+                    std::chrono::duration<double, std::milli>(cold - start).count(),
+                    std::chrono::duration<double, std::milli>(end - cold).count() / repetitions,
+                    static_cast<unsigned long long>(graph.getLosQueries()),
+                    graph.getConnectionCount(),
+                    identical ? "identical" : "MISMATCH");
+    }
+    
+    // Listes de Verlet: 25 m/s et un update toutes les 1/3 s (SimulationEngine),
+    // graphe comparé à chaque update au calcul sans listes
+    std::printf("Verlet lists (full / TBB, vehicles moving 8 m per update):\n");
+    const int steps = 10 * repetitions;
+    for (double skin : {0.0, 20.0, 50.0, 100.0}) {
+        auto fleet = makeFleet(vehicleCount, mixedRadii);
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<> headingDist(0.0, 2.0 * 3.14159265358979323846);
+        std::vector<double> headings(fleet.size());
+        for (double& heading : headings) {
+            heading = headingDist(gen);
+        }
+        
+        InterferenceGraph graph;
+        graph.setVerletSkin(skin);
+        InterferenceGraph check;
+        
+        double ms = 0.0;
+        uint64_t evaluations = 0;
+        bool identical = true;
+        for (int step = 0; step < steps; ++step) {
+            moveFleet(fleet, headings, 8.0);
+            auto start = std::chrono::steady_clock::now();
+            graph.update(fleet);
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            evaluations += graph.getDistanceEvaluations();
+            
+            if (skin > 0.0) {
+                check.update(fleet);
+                identical = identical && sameGraph(check, graph, vehicleCount);
+            }
+        }
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  skin %5.1f m  %8.2f ms/update  %10.0f distance evals/update  rebuild rate %.2f  %s\n",
+                    skin, ms / steps, static_cast<double>(evaluations) / steps,
+                    graph.getVerletRebuildRate(), identical ? "identical" : "MISMATCH");
+    }
+    
+    // Classes de rayon: rayons continus 100-500 m, puis profils par classe
+    // (80 % de voitures à 200 m, 15 % de camions à 400 m, 5 % de RSU à 500 m)
+    std::printf("Radius classes (full / TBB):\n");
+    auto profileFleet = makeFleet(vehicleCount, false);
+    for (size_t i = 0; i < profileFleet.size(); ++i) {
+        profileFleet[i]->setTransmissionRadius(i % 20 == 0 ? 500 : i % 20 < 4 ? 400 : 200);
+    }
+    const std::pair<const char*, std::vector<std::shared_ptr<Vehicle>>> radiusFleets[] = {
+        {"continuous 100-500 m", makeFleet(vehicleCount, true)},
+        {"car / truck / RSU", profileFleet},
+    };
+    for (const auto& [name, fleet] : radiusFleets) {
+        InterferenceGraph single;
+        InterferenceGraph classes;
+        classes.setRadiusClasses(true);
+        
+        double ms[2] = {0.0, 0.0};
+        InterferenceGraph* graphs[2] = {&single, &classes};
+        for (int g = 0; g < 2; ++g) {
+            auto start = std::chrono::steady_clock::now();
+            for (int rep = 0; rep < repetitions; ++rep) {
+                graphs[g]->update(fleet);
+            }
+            ms[g] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+        }
+        const bool identical = sameGraph(single, classes, vehicleCount);
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  %-22s single tree %8.2f ms  %10llu evals   %zu classes %8.2f ms  %10llu evals (%5.1f%%)  %s\n",
+                    name, ms[0], static_cast<unsigned long long>(single.getDistanceEvaluations()),
+                    classes.getRadiusClassCount(), ms[1],
+                    static_cast<unsigned long long>(classes.getDistanceEvaluations()),
+                    100.0 * classes.getDistanceEvaluations() / std::max<double>(single.getDistanceEvaluations(), 1.0),
+                    identical ? "identical" : "MISMATCH");
+    }
+    
+    // Instanciations du noyau sur une flotte à rayon unique: politique de
+    // rayon (graphe identique) puis métrique planaire (liens en limite de
+    // portée comptés, pas d'égalité attendue)
+    std::printf("Kernel policies (serial, uniform 300 m radii):\n");
+    auto uniformFleet = makeFleet(vehicleCount, false);
+    struct PolicyConfig { const char* name; Mode mode; double skin; };
+    const PolicyConfig policyConfigs[] = {
+        {"full", Mode::FullNeighbour, 0.0},
+        {"half-pair", Mode::HalfPair, 0.0},
+        {"Verlet 50 m", Mode::FullNeighbour, 50.0},
+    };
+    InterferenceGraph uniformReference;
+    uniformReference.setParallelDiscovery(false);
+    uniformReference.update(uniformFleet);
+    for (const auto& config : policyConfigs) {
+        const std::tuple<const char*, LinkRadius, LinkMetric> policies[] = {
+            {"per-vehicle / chord", LinkRadius::PerVehicle, LinkMetric::Chord},
+            {"uniform / chord", LinkRadius::Uniform, LinkMetric::Chord},
+            {"uniform / planar", LinkRadius::Uniform, LinkMetric::Planar},
+        };
+        for (const auto& [name, radius, metric] : policies) {
+            InterferenceGraph graph;
+            graph.setParallelDiscovery(false);
+            graph.setEnumerationMode(config.mode);
+            graph.setVerletSkin(config.skin);
+            graph.setRadiusPolicy(radius);
+            graph.setLinkMetric(metric);
+            graph.update(uniformFleet);
+            
+            auto start = std::chrono::steady_clock::now();
+            for (int rep = 0; rep < repetitions; ++rep) {
+                graph.update(uniformFleet);
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+            
+            const size_t different = linkDifference(uniformReference, graph, vehicleCount);
+            if (metric == LinkMetric::Chord) {
+                allIdentical = allIdentical && different == 0;
+            }
+            
+            std::printf("  %-12s %-20s %8.2f ms/update  %zu links  %s",
+                        config.name, name, ms, graph.getConnectionCount(),
+                        different == 0 ? "identical" : metric == LinkMetric::Chord ? "MISMATCH" : "");
+            if (metric == LinkMetric::Planar) {
+                std::printf("%zu links differ (%.3f%%)", different,
+                            100.0 * different / std::max<double>(uniformReference.getConnectionCount(), 1.0));
+            }
+            std::printf("\n");
+        }
+    }
+    
+    // Métriques de topologie sur le graphe de référence: résultats serial et
+    // TBB comparés (intermédiarité à l'arrondi près)
+    std::printf("Graph metrics (clustering samples / betweenness sources / diameter sweeps):\n");
+    struct Sampling { size_t clustering; size_t sources; size_t sweeps; };
+    const Sampling samplings[] = {{1024, 4, 2}, {2048, 16, 4}, {8192, 64, 8}};
+    for (const auto& sampling : samplings) {
+        GraphMetrics serial;
+        GraphMetrics parallel;
+        for (GraphMetrics* metrics : {&serial, &parallel}) {
+            metrics->setParallel(metrics == &parallel);
+            metrics->setClusteringSamples(sampling.clustering);
+            metrics->setBetweennessSources(sampling.sources);
+            metrics->setDiameterSweeps(sampling.sweeps);
+            metrics->compute(reference);
+        }
+        
+        const auto& a = serial.getSummary();
+        const auto& b = parallel.getSummary();
+        const bool identical = a.averageClustering == b.averageClustering && a.diameter == b.diameter &&
+                               a.averagePathLength == b.averagePathLength &&
+                               std::abs(a.maxBetweenness - b.maxBetweenness) <= 1e-9 * a.maxBetweenness;
+        allIdentical = allIdentical && identical;
+        
+        std::printf("  %5zu / %3zu / %zu  serial %8.1f ms  TBB %8.1f ms  clustering %.3f  diameter >= %d  "
+                    "path %.2f  max betweenness %.4f  %s\n",
+                    sampling.clustering, sampling.sources, sampling.sweeps, a.computeMs, b.computeMs,
+                    b.averageClustering, b.diameter, b.averagePathLength, b.maxBetweenness,
+                    identical ? "identical" : "MISMATCH");
+    }
+    
+    // Beacons CAM à 10 Hz sur le graphe de référence (figé), avancés par pas
+    // de frame: coût par seconde simulée, débit obtenu avec et sans DCC
+    std::printf("Beacon scheduling (10 Hz CAM, 2 s simulated, 30 advance per second):\n");
+    for (bool dcc : {false, true}) {
+        BeaconScheduler beacons;
+        auto parameters = beacons.getParameters();
+        parameters.dcc = dcc;
+        beacons.setParameters(parameters);
+        beacons.setEnabled(true);
+        
+        constexpr double simulatedSeconds = 2.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 1; frame <= 60; ++frame) {
+            beacons.advance(reference, frame * simulatedSeconds / 60);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        const auto summary = beacons.getSummary();
+        std::printf("  DCC %-3s  %8.1f ms per simulated s  %9.0f beacons/s  rate %5.2f Hz  CBR %.3f (max %.3f)  "
+                    "states %zu/%zu/%zu/%zu/%zu\n",
+                    dcc ? "on" : "off", ms / simulatedSeconds, beacons.getProcessedBeacons() / simulatedSeconds,
+                    summary.beaconRate, summary.channelBusyRatio, summary.maxChannelBusyRatio,
+                    summary.dccStates[0], summary.dccStates[1], summary.dccStates[2], summary.dccStates[3],
+                    summary.dccStates[4]);
+    }
+    
+    // Versions publiées: un thread lecteur vérifie chaque version obtenue
+    // (degrés = 2 x liens, adjacence symétrique) pendant des updates sur une
+    // flotte en mouvement; coût de publication = copie de l'adjacence
+    std::printf("Snapshot publication (reader thread during %d updates):\n", repetitions * 4);
+    {
+        InterferenceGraph published;
+        std::atomic<bool> done{false};
+        std::atomic<uint64_t> reads{0};
+        std::atomic<uint64_t> inconsistent{0};
+        std::thread reader([&]() {
+            uint64_t lastVersion = 0;
+            while (!done.load()) {
+                const auto snapshot = published.acquireSnapshot();
+                size_t degreeSum = 0;
+                for (int id : snapshot->getVehicleIds()) {
+                    const auto neighbors = snapshot->getNeighbors(id);
+                    degreeSum += neighbors.size();
+                    if (!neighbors.empty() && !snapshot->areConnected(neighbors.front(), id)) {
+                        inconsistent.fetch_add(1);
+                    }
+                }
+                if (degreeSum != 2 * snapshot->getConnectionCount() || snapshot->getVersion() < lastVersion) {
+                    inconsistent.fetch_add(1);
+                }
+                lastVersion = snapshot->getVersion();
+                reads.fetch_add(1);
+            }
+        });
+        
+        std::vector<double> headings(vehicles.size());
+        std::mt19937 headingGen(11);
+        std::uniform_real_distribution<> headingDist(0.0, 2.0 * 3.14159265358979323846);
+        for (double& heading : headings) heading = headingDist(headingGen);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < repetitions * 4; ++rep) {
+            moveFleet(vehicles, headings, 8.0);
+            published.update(vehicles, rep * 0.3);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        done.store(true);
+        reader.join();
+        
+        const bool consistent = inconsistent.load() == 0;
+        allIdentical = allIdentical && consistent;
+        std::printf("  %8.2f ms per update  %llu versions  %llu reads  %s\n", ms / (repetitions * 4),
+                    static_cast<unsigned long long>(published.getSnapshotVersion()),
+                    static_cast<unsigned long long>(reads.load()), consistent ? "consistent" : "INCONSISTENT");
+    }
+    
+    // Requêtes spatiales sur la version publiée du graphe de référence,
+    // centrées sur des véhicules: débit sur un thread puis sur tous les
+    // threads (une acquisition par thread), kNN et anneaux vérifiés contre
+    // un parcours linéaire des positions
+    const unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("Spatial queries on the published snapshot (1 / %u threads):\n", threadCount);
+    {
+        const auto snapshot = reference.acquireSnapshot();
+        const auto ids = snapshot->getVehicleIds();
+        constexpr size_t queryCount = 200000;
+        constexpr size_t checkedQueries = 200;
+        
+        auto centerOf = [&](size_t q, Point2D& center) {
+            const int id = ids[(q * 7919) % ids.size()];
+            snapshot->getPosition(id, center);
+            return id;
+        };
+        
+        // Losange de ~600 m de diagonale, itinéraire en zigzag de ~1,5 km (5 tronçons)
+        auto runQuery = [&](int type, size_t q, std::vector<NearVehicle>& near, std::vector<int>& found) {
+            Point2D center;
+            const int id = centerOf(q, center);
+            const double x = center.get<0>();
+            const double y = center.get<1>();
+            switch (type) {
+                case 0:
+                    snapshot->nearest(center, 8, near, id);
+                    return near.size();
+                case 1:
+                    snapshot->withinRing(center, 100.0, 300.0, found);
+                    return found.size();
+                case 2: {
+                    Polygon2D polygon;
+                    bg::append(polygon.outer(), Point2D(x, y + 0.0027));
+                    bg::append(polygon.outer(), Point2D(x + 0.004, y));
+                    bg::append(polygon.outer(), Point2D(x, y - 0.0027));
+                    bg::append(polygon.outer(), Point2D(x - 0.004, y));
+                    bg::correct(polygon);
+                    snapshot->withinPolygon(polygon, found);
+                    return found.size();
+                }
+                default: {
+                    const Point2D route[] = {
+                        center, Point2D(x + 0.003, y + 0.001), Point2D(x + 0.006, y - 0.001),
+                        Point2D(x + 0.009, y + 0.001), Point2D(x + 0.012, y - 0.001), Point2D(x + 0.015, y + 0.001),
+                    };
+                    snapshot->alongRoute(route, 25.0, found);
+                    return found.size();
+                }
+            }
+        };
+        
+        const char* names[] = {"kNN (k = 8)", "ring 100-300 m", "polygon", "route corridor 25 m"};
+        for (int type = 0; type < 4; ++type) {
+            std::vector<NearVehicle> near;
+            std::vector<int> found;
+            
+            // Vérification: kNN et anneau recalculés par Haversine sur toutes les positions
+            size_t mismatches = 0;
+            for (size_t q = 0; q < checkedQueries && type < 2; ++q) {
+                runQuery(type, q, near, found);
+                Point2D center;
+                const int id = centerOf(q, center);
+                std::vector<std::pair<double, int>> all;
+                for (int other : ids) {
+                    Point2D position;
+                    snapshot->getPosition(other, position);
+                    const double d = GeometryUtils::haversineDistance(center.get<1>(), center.get<0>(),
+                                                                      position.get<1>(), position.get<0>());
+                    if (type == 0 ? other != id : d >= 100.0 && d <= 300.0) {
+                        all.emplace_back(d, other);
+                    }
+                }
+                std::sort(all.begin(), all.end());
+                if (type == 0) {
+                    for (size_t i = 0; i < near.size(); ++i) {
+                        mismatches += std::abs(near[i].distance - all[i].first) > 1e-6;
+                    }
+                    mismatches += near.size() != std::min<size_t>(8, all.size());
+                } else {
+                    mismatches += found.size() != all.size();
+                }
+            }
+            allIdentical = allIdentical && mismatches == 0;
+            
+            size_t results = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t q = 0; q < queryCount; ++q) {
+                results += runQuery(type, q, near, found);
+            }
+            const double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, t]() {
+                    const auto local = reference.acquireSnapshot();
+                    std::vector<NearVehicle> localNear;
+                    std::vector<int> localFound;
+                    for (size_t q = t; q < queryCount; q += threadCount) {
+                        runQuery(type, q, localNear, localFound);
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+            const double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            std::printf("  %-20s %10.0f queries/s  %10.0f queries/s  %6.1f results/query  %s\n",
+                        names[type], queryCount / serialSeconds, queryCount / parallelSeconds,
+                        static_cast<double>(results) / queryCount,
+                        type >= 2 ? "" : mismatches == 0 ? "exact" : "MISMATCH");
+        }
+    }
+    
+    // Association V2I: RSU servante de chaque véhicule par lecture de la
+    // grille de couverture précalculée, contre une requête R-tree des RSU
+    // (boîte du plus grand rayon puis Haversine) par véhicule
+    std::printf("Roadside unit association (%d vehicles):\n", vehicleCount);
+    {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<> latDist(47.70, 47.80);
+        std::uniform_real_distribution<> lonDist(7.30, 7.40);
+        std::uniform_real_distribution<> radiusDist(200.0, 800.0);
+        const auto fleet = makeFleet(vehicleCount, false);
+        
+        for (int unitCount : {50, 200, 1000}) {
+            RoadsideUnits units;
+            std::vector<RoadsideUnits::Unit> layout;
+            for (int i = 0; i < unitCount; ++i) {
+                RoadsideUnits::Unit unit;
+                unit.id = i;
+                unit.latitude = latDist(gen);
+                unit.longitude = lonDist(gen);
+                unit.radius = radiusDist(gen);
+                unit.backhaul = i % 2 == 0;
+                units.addUnit(unit);
+                layout.push_back(unit);
+            }
+            auto start = std::chrono::steady_clock::now();
+            units.build();
+            const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            
+            constexpr int frames = 20;
+            start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame) {
+                units.update(fleet, frame * 0.1);
+            }
+            const double lookupNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                                    / (static_cast<double>(frames) * vehicleCount);
+            
+            using UnitValue = std::pair<Point2D, int>;
+            bgi::rtree<UnitValue, bgi::quadratic<16>> tree;
+            double maxRadius = 0.0;
+            for (int i = 0; i < unitCount; ++i) {
+                tree.insert({Point2D(layout[i].longitude, layout[i].latitude), i});
+                maxRadius = std::max(maxRadius, layout[i].radius);
+            }
+            std::vector<int> serving(vehicleCount, -1);
+            std::vector<UnitValue> candidates;
+            start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame) {
+                for (int v = 0; v < vehicleCount; ++v) {
+                    const double lat = fleet[v]->getLatitude();
+                    const double lon = fleet[v]->getLongitude();
+                    const double dLat = maxRadius / 111195.0;
+                    const double dLon = dLat / std::cos(lat * 3.14159265358979323846 / 180.0);
+                    candidates.clear();
+                    tree.query(bgi::intersects(v2v::network::Box(Point2D(lon - dLon, lat - dLat), Point2D(lon + dLon, lat + dLat))),
+                               std::back_inserter(candidates));
+                    int best = -1;
+                    double bestDistance = 0.0;
+                    for (const auto& [position, unit] : candidates) {
+                        const double d = GeometryUtils::haversineDistance(lat, lon, position.get<1>(), position.get<0>());
+                        if (d <= layout[unit].radius && (best < 0 || d < bestDistance)) {
+                            best = unit;
+                            bestDistance = d;
+                        }
+                    }
+                    serving[v] = best;
+                }
+            }
+            const double queryNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                                   / (static_cast<double>(frames) * vehicleCount);
+            
+            size_t mismatches = 0;
+            for (int v = 0; v < vehicleCount; ++v) {
+                mismatches += units.getServingUnit(fleet[v]->getId()) != serving[v];
+            }
+            allIdentical = allIdentical && mismatches == 0;
+            
+            const auto summary = units.getSummary();
+            std::printf("  %4d units: build %6.1f ms (%zu cells, %4.1f%% decided)  lookup %6.1f ns/vehicle"
+                        "  R-tree %6.1f ns/vehicle  covered %4.1f%%  %s\n",
+                        unitCount, buildMs, units.getCellCount(),
+                        units.getCoveredCellCount() > 0 ? 100.0 * units.getDecidedCellCount() / units.getCoveredCellCount() : 0.0,
+                        lookupNs, queryNs, 100.0 * summary.covered / std::max<size_t>(1, summary.vehicles),
+                        mismatches == 0 ? "identical" : "MISMATCH");
+        }
+    }
+    
+    // Attribution des canaux de service: coloration complète par vagues
+    // Jones-Plassmann (séquentielle puis TBB: canaux identiques attendus),
+    // puis recoloration incrémentale après un déplacement de 5 m au plus
+    // (une frame de graphe), conflits tenus à jour comparés à un recompte
+    std::printf("Channel assignment (%d vehicles):\n", vehicleCount);
+    {
+        std::mt19937 gen(13);
+        std::uniform_real_distribution<> stepDist(-5.0, 5.0);
+        auto moved = makeFleet(vehicleCount, mixedRadii);
+        for (auto& vehicle : moved) {
+            const double lat = vehicle->getLatitude();
+            const double cosLat = std::cos(lat * 3.14159265358979323846 / 180.0);
+            vehicle->setGeoPosition(lat + stepDist(gen) / 111195.0,
+                                    vehicle->getLongitude() + stepDist(gen) / (111195.0 * cosLat));
+        }
+        
+        InterferenceGraph graph;
+        for (int channelCount : {3, 6, 12}) {
+            graph.update(vehicles);
+            ChannelAssignment serial;
+            ChannelAssignment parallel;
+            ChannelAssignment::Parameters parameters;
+            parameters.channelCount = channelCount;
+            for (auto* assignment : {&serial, &parallel}) {
+                assignment->setParameters(parameters);
+                assignment->setEnabled(true);
+            }
+            serial.setParallel(false);
+            serial.update(graph);
+            parallel.update(graph);
+            const auto full = parallel.getSummary();
+            
+            size_t mismatches = 0;
+            for (int id : graph.getVehicleIds()) {
+                mismatches += serial.getChannel(id) != parallel.getChannel(id);
+            }
+            
+            graph.update(moved);
+            parallel.update(graph);
+            const auto incremental = parallel.getSummary();
+            mismatches += incremental.conflicts != parallel.countConflicts(graph);
+            allIdentical = allIdentical && mismatches == 0;
+            
+            std::printf("  %2d channels: full %7.2f ms serial %7.2f ms TBB (%d rounds, %5.2f%% conflicts)"
+                        "  incremental %6.2f ms (%zu candidates, %zu switches, %5.2f%% conflicts)  %s\n",
+                        channelCount, serial.getSummary().computeMs, full.computeMs, full.rounds,
+                        full.conflictRatio * 100.0, incremental.computeMs, incremental.candidates,
+                        incremental.recolored, incremental.conflictRatio * 100.0,
+                        mismatches == 0 ? "identical" : "MISMATCH");
+        }
+    }
+    
+    // Mode paresseux: update réduit à l'index spatial, puis lignes d'une
+    // région (un dixième de la zone) et de véhicules tirés au hasard,
+    // comparées au graphe complet
+    std::printf("Lazy graph (%d vehicles):\n", vehicleCount);
+    {
+        InterferenceGraph full;
+        InterferenceGraph lazy;
+        lazy.setLazy(true);
+        full.update(vehicles);
+        lazy.update(vehicles);
+        
+        double fullMs = 0.0;
+        double lazyMs = 0.0;
+        for (int r = 0; r < repetitions; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            full.update(vehicles);
+            fullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            start = std::chrono::steady_clock::now();
+            lazy.update(vehicles);
+            lazyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        
+        const auto snapshot = full.acquireSnapshot();
+        Point2D first;
+        snapshot->getPosition(snapshot->getVehicleIds()[0], first);
+        const v2v::network::Box region(first, Point2D(first.get<0>() + 0.03, first.get<1>() + 0.03));
+        auto start = std::chrono::steady_clock::now();
+        const size_t regionRows = lazy.materializeRegion(region);
+        const double regionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        std::mt19937 gen(17);
+        const auto ids = full.getVehicleIds();
+        std::vector<int> sample(1000);
+        for (int& id : sample) {
+            id = ids[gen() % ids.size()];
+        }
+        start = std::chrono::steady_clock::now();
+        size_t degreeSum = 0;
+        for (int id : sample) {
+            degreeSum += lazy.getNeighbors(id).size();
+        }
+        const double rowUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count()
+                             / sample.size();
+        
+        size_t mismatches = 0;
+        for (int id : ids) {
+            const auto expected = full.getNeighbors(id);
+            const auto row = lazy.getNeighbors(id);
+            mismatches += !std::equal(expected.begin(), expected.end(), row.begin(), row.end());
+        }
+        allIdentical = allIdentical && mismatches == 0;
+        
+        std::printf("  update: full %7.2f ms  lazy %7.2f ms  region %zu rows in %6.2f ms  random row %6.2f us"
+                    " (degree %4.1f)  %s\n",
+                    fullMs / repetitions, lazyMs / repetitions, regionRows, regionMs, rowUs,
+                    static_cast<double>(degreeSum) / sample.size(), mismatches == 0 ? "identical" : "MISMATCH");
+    }
+    
+    return allIdentical ? 0 : 1;
+}
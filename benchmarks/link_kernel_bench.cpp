@@ -0,0 +1,218 @@
+// Micro-benchmark: qualification des liens V2V
+// Haversine scalaire (chemin historique) vs LinkKernel scalaire vs LinkKernel AVX2,
+// puis instanciations par politiques (métrique, rayon, candidats contigus)
+//
+// Usage: link_kernel_bench [nombreVehicules] [repetitions]
+
+#include "network/LinkKernel.hpp"
+#include "data/GeometryUtils.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using v2v::data::GeometryUtils;
+using v2v::network::LinkFrame;
+using v2v::network::LinkKernel;
+using v2v::network::LinkMetric;
+using v2v::network::LinkRadius;
+
+namespace {
+
+struct Scenario {
+    std::vector<double> lat;
+    std::vector<double> lon;
+    std::vector<double> radius;
+    std::vector<int> blocks; // BLOCK_SIZE candidats par véhicule
+    std::vector<int> runs;   // BLOCK_SIZE candidats consécutifs par véhicule
+    LinkFrame frame;
+};
+
+Scenario makeScenario(int vehicleCount) {
+    Scenario s;
+    std::mt19937 gen(42);
+    // ~2 km x 2 km autour de Mulhouse: une bonne partie des paires sont à portée
+    std::uniform_real_distribution<> latDist(47.74, 47.76);
+    std::uniform_real_distribution<> lonDist(7.32, 7.35);
+    std::uniform_real_distribution<> radiusDist(100.0, 500.0);
+    std::uniform_int_distribution<> candidateDist(0, vehicleCount - 1);
+    
+    for (int i = 0; i < vehicleCount; ++i) {
+        s.lat.push_back(latDist(gen));
+        s.lon.push_back(lonDist(gen));
+        s.radius.push_back(radiusDist(gen));
+        s.frame.push(s.lat.back(), s.lon.back(), s.radius.back());
+    }
+    
+    s.blocks.resize(static_cast<size_t>(vehicleCount) * LinkKernel::BLOCK_SIZE);
+    for (auto& candidate : s.blocks) {
+        candidate = candidateDist(gen);
+    }
+    
+    // Suites contiguës (repère trié par cellule de grille)
+    std::uniform_int_distribution<> runDist(0, std::max(0, vehicleCount - static_cast<int>(LinkKernel::BLOCK_SIZE)));
+    s.runs.resize(s.blocks.size());
+    for (size_t b = 0; b < s.runs.size(); b += LinkKernel::BLOCK_SIZE) {
+        const int start = runDist(gen);
+        for (size_t k = 0; k < LinkKernel::BLOCK_SIZE; ++k) {
+            s.runs[b + k] = std::min(start + static_cast<int>(k), vehicleCount - 1);
+        }
+    }
+    return s;
+}
+
+LinkFrame makeFrame(const Scenario& s, LinkMetric metric, bool uniform) {
+    LinkFrame frame;
+    frame.setMetric(metric);
+    for (size_t i = 0; i < s.lat.size(); ++i) {
+        frame.push(s.lat[i], s.lon[i], uniform ? 300.0 : s.radius[i]);
+    }
+    return frame;
+}
+
+uint64_t haversineBlock(const Scenario& s, int i, const int* block) {
+    uint64_t mask = 0;
+    for (size_t k = 0; k < LinkKernel::BLOCK_SIZE; ++k) {
+        const int j = block[k];
+        const double d = GeometryUtils::haversineDistance(s.lat[i], s.lon[i], s.lat[j], s.lon[j]);
+        if (d <= s.radius[i] && d <= s.radius[j]) {
+            mask |= uint64_t(1) << k;
+        }
+    }
+    return mask;
+}
+
+template <typename Fn>
+double timeNsPerPair(const Scenario& s, int repetitions, Fn&& qualify, std::vector<uint64_t>& masks,
+                     const std::vector<int>* candidates = nullptr) {
+    const int n = static_cast<int>(s.lat.size());
+    const std::vector<int>& blocks = candidates ? *candidates : s.blocks;
+    masks.assign(n, 0);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep) {
+        for (int i = 0; i < n; ++i) {
+            masks[i] = qualify(i, blocks.data() + static_cast<size_t>(i) * LinkKernel::BLOCK_SIZE);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    const double pairs = static_cast<double>(n) * LinkKernel::BLOCK_SIZE * repetitions;
+    return std::chrono::duration<double, std::nano>(end - start).count() / pairs;
+}
+
+size_t countMismatches(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        mismatches += std::popcount(a[i] ^ b[i]);
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int vehicleCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50000;
+    const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20;
+    
+    Scenario s = makeScenario(vehicleCount);
+    std::printf("Link qualification: %d vehicles x %zu candidates x %d repetitions\n",
+                vehicleCount, LinkKernel::BLOCK_SIZE, repetitions);
+    
+    std::vector<uint64_t> reference;
+    const double haversineNs = timeNsPerPair(s, repetitions,
+        [&](int i, const int* block) { return haversineBlock(s, i, block); }, reference);
+    std::printf("  %-18s %7.2f ns/pair\n", "haversine (scalar)", haversineNs);
+    
+    for (auto backend : {LinkKernel::Backend::Scalar, LinkKernel::Backend::AVX2}) {
+        if (!LinkKernel::isSupported(backend)) {
+            std::printf("  %-18s unsupported on this CPU\n", LinkKernel::backendName(backend));
+            continue;
+        }
+        LinkKernel::setBackend(backend);
+        
+        std::vector<uint64_t> masks;
+        const double ns = timeNsPerPair(s, repetitions,
+            [&](int i, const int* block) {
+                return LinkKernel::qualifyBlock(s.frame, i, block, LinkKernel::BLOCK_SIZE);
+            }, masks);
+        
+        std::printf("  %-18s %7.2f ns/pair  speedup x%.1f  mismatches %zu\n",
+                    LinkKernel::backendName(backend), ns, haversineNs / ns,
+                    countMismatches(reference, masks));
+    }
+    
+    // Politiques: chaque instanciation comparée au noyau générique sur le
+    // même repère (Planar: aussi au repère Chord, écart dû à la projection)
+    LinkKernel::setBackend(LinkKernel::Backend::AVX2);
+    std::printf("Kernel policies (%s), mismatches vs generic kernel on the same frame:\n",
+                LinkKernel::backendName(LinkKernel::activeBackend()));
+    
+    for (const bool uniform : {false, true}) {
+        const LinkFrame chord = makeFrame(s, LinkMetric::Chord, uniform);
+        const LinkFrame planar = makeFrame(s, LinkMetric::Planar, uniform);
+        
+        std::vector<uint64_t> chordMasks;
+        for (const auto* candidates : {&s.blocks, &s.runs}) {
+            const bool contiguous = candidates == &s.runs;
+            
+            std::vector<uint64_t> generic;
+            const double genericNs = timeNsPerPair(s, repetitions,
+                [&](int i, const int* block) {
+                    return LinkKernel::qualifyBlock(chord, i, block, LinkKernel::BLOCK_SIZE);
+                }, generic, candidates);
+            std::printf("  %-8s %-10s %-28s %7.2f ns/pair\n", uniform ? "uniform" : "mixed",
+                        contiguous ? "contiguous" : "gathered", "generic", genericNs);
+            
+            for (const LinkMetric metric : {LinkMetric::Chord, LinkMetric::Planar}) {
+                const LinkFrame& frame = metric == LinkMetric::Chord ? chord : planar;
+                auto qualify = [&](int i, const int* block) -> uint64_t {
+                    const bool planarMetric = metric == LinkMetric::Planar;
+                    if (contiguous) {
+                        const size_t begin = static_cast<size_t>(block[0]);
+                        if (uniform) {
+                            return planarMetric
+                                ? LinkKernel::qualifyRun<LinkMetric::Planar, LinkRadius::Uniform>(frame, i, begin, LinkKernel::BLOCK_SIZE)
+                                : LinkKernel::qualifyRun<LinkMetric::Chord, LinkRadius::Uniform>(frame, i, begin, LinkKernel::BLOCK_SIZE);
+                        }
+                        return planarMetric
+                            ? LinkKernel::qualifyRun<LinkMetric::Planar, LinkRadius::PerVehicle>(frame, i, begin, LinkKernel::BLOCK_SIZE)
+                            : LinkKernel::qualifyRun<LinkMetric::Chord, LinkRadius::PerVehicle>(frame, i, begin, LinkKernel::BLOCK_SIZE);
+                    }
+                    if (uniform) {
+                        return planarMetric
+                            ? LinkKernel::qualifyBlockWith<LinkMetric::Planar, LinkRadius::Uniform>(frame, i, block, LinkKernel::BLOCK_SIZE)
+                            : LinkKernel::qualifyBlockWith<LinkMetric::Chord, LinkRadius::Uniform>(frame, i, block, LinkKernel::BLOCK_SIZE);
+                    }
+                    return planarMetric
+                        ? LinkKernel::qualifyBlockWith<LinkMetric::Planar, LinkRadius::PerVehicle>(frame, i, block, LinkKernel::BLOCK_SIZE)
+                        : LinkKernel::qualifyBlockWith<LinkMetric::Chord, LinkRadius::PerVehicle>(frame, i, block, LinkKernel::BLOCK_SIZE);
+                };
+                
+                std::vector<uint64_t> masks;
+                const double ns = timeNsPerPair(s, repetitions, qualify, masks, candidates);
+                
+                std::vector<uint64_t> sameFrame;
+                timeNsPerPair(s, 1, [&](int i, const int* block) {
+                    return LinkKernel::qualifyBlock(frame, i, block, LinkKernel::BLOCK_SIZE);
+                }, sameFrame, candidates);
+                
+                char label[64];
+                std::snprintf(label, sizeof(label), "%s / %s", metric == LinkMetric::Chord ? "chord" : "planar",
+                              uniform ? "uniform radius" : "per-vehicle radius");
+                std::printf("  %-8s %-10s %-28s %7.2f ns/pair  x%.2f  mismatches %zu",
+                            uniform ? "uniform" : "mixed", contiguous ? "contiguous" : "gathered",
+                            label, ns, genericNs / ns, countMismatches(sameFrame, masks));
+                if (metric == LinkMetric::Planar) {
+                    std::printf("  (vs chord %zu)", countMismatches(generic, masks));
+                }
+                std::printf("\n");
+            }
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,301 @@
+// Benchmark: graphe routier figé (RoadNetwork, CSR) contre le graphe Boost
+// de construction (adjacency_list): mémoire des deux représentations, puis
+// A* sur des paires de nœuds proches (Boost astar_search contre
+// PathPlanner::findPath, longueurs de chemin comparées), enfin nœud le plus
+// proche: R-tree de RoadGraph contre un parcours linéaire de référence
+// (Haversine), résultats comparés, k plus proches et requêtes parallèles.
+//
+// Grille routière synthétique (rues manquantes, sens uniques, noms répétés)
+// autour de Mulhouse.
+//
+// Usage: road_graph_bench [cotéGrille] [requetes]
+
+#include "network/RoadGraph.hpp"
+#include "network/PathPlanner.hpp"
+#include "data/GeometryUtils.hpp"
+#include <boost/graph/astar_search.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using v2v::data::GeometryUtils;
+using v2v::network::PathPlanner;
+using v2v::network::RoadEdge;
+using v2v::network::RoadGraph;
+using v2v::network::RoadGraphType;
+using v2v::network::RoadNetwork;
+using v2v::network::VertexDescriptor;
+
+namespace {
+
+const char* const ROAD_TYPES[] = {"primary", "residential", "service", "motorway_link", "tertiary"};
+
+void buildGrid(RoadGraph& roads, int side) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<> jitter(0.0, 0.0002);
+    std::uniform_real_distribution<> draw(0.0, 1.0);
+    
+    std::vector<VertexDescriptor> nodes(static_cast<size_t>(side) * side);
+    std::vector<std::pair<double, double>> positions(nodes.size());
+    for (int i = 0; i < side; ++i) {
+        for (int j = 0; j < side; ++j) {
+            const double lat = 47.70 + i * 0.0009 + jitter(gen);
+            const double lon = 7.30 + j * 0.0013 + jitter(gen);
+            nodes[i * side + j] = roads.addNode(lat, lon);
+            positions[i * side + j] = {lat, lon};
+        }
+    }
+    
+    auto connect = [&](int a, int b, bool twoWay, const std::string& type, const std::string& name) {
+        const double length = GeometryUtils::haversineDistance(positions[a].first, positions[a].second,
+                                                               positions[b].first, positions[b].second);
+        roads.addEdge(nodes[a], nodes[b], length, 13.9, type, name);
+        if (twoWay) {
+            roads.addEdge(nodes[b], nodes[a], length, 13.9, type, name);
+        }
+    };
+    for (int i = 0; i < side; ++i) {
+        for (int j = 0; j < side; ++j) {
+            const int a = i * side + j;
+            if (j + 1 < side && draw(gen) < 0.9) {
+                connect(a, a + 1, true, ROAD_TYPES[i % 5], "Rue " + std::to_string(i % 200));
+            }
+            if (i + 1 < side && draw(gen) < 0.9) {
+                connect(a, a + side, draw(gen) < 0.8, ROAD_TYPES[j % 5], "Avenue " + std::to_string(j % 200));
+            }
+        }
+    }
+}
+
+struct GoalReached {};
+
+class HaversineHeuristic : public boost::astar_heuristic<RoadGraphType, double> {
+public:
+    HaversineHeuristic(const RoadGraphType& graph, VertexDescriptor goal) : m_graph(graph), m_goal(goal) {}
+    
+    double operator()(VertexDescriptor v) const {
+        return GeometryUtils::haversineDistance(m_graph[v].latitude, m_graph[v].longitude,
+                                                m_graph[m_goal].latitude, m_graph[m_goal].longitude);
+    }
+
+private:
+    const RoadGraphType& m_graph;
+    VertexDescriptor m_goal;
+};
+
+class GoalVisitor : public boost::default_astar_visitor {
+public:
+    explicit GoalVisitor(VertexDescriptor goal) : m_goal(goal) {}
+    
+    void examine_vertex(VertexDescriptor v, const RoadGraphType&) const {
+        if (v == m_goal) {
+            throw GoalReached();
+        }
+    }
+
+private:
+    VertexDescriptor m_goal;
+};
+
+// Référence: parcours linéaire, premier nœud à distance minimale
+VertexDescriptor nearestLinear(const RoadNetwork& network, double lat, double lon) {
+    double minDist = std::numeric_limits<double>::max();
+    VertexDescriptor nearest = 0;
+    for (RoadNetwork::NodeId node = 0; node < network.getNodeCount(); ++node) {
+        const double dist = GeometryUtils::haversineDistance(lat, lon, network.getLatitude(node),
+                                                             network.getLongitude(node));
+        if (dist < minDist) {
+            minDist = dist;
+            nearest = node;
+        }
+    }
+    return nearest;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int side = argc > 1 ? std::max(2, std::atoi(argv[1])) : 300;
+    const int queries = argc > 2 ? std::max(1, std::atoi(argv[2])) : 500;
+    
+    RoadGraph roads;
+    buildGrid(roads, side);
+    const RoadGraphType reference = roads.getGraph();
+    
+    auto start = std::chrono::steady_clock::now();
+    roads.finalize();
+    const double finalizeMs = elapsedMs(start);
+    
+    const auto& report = roads.getMemoryReport();
+    std::printf("Road graph: %zu nodes, %zu edges, %zu names\n", report.nodes, report.edges, report.names);
+    std::printf("  adjacency list %8.2f MB (%5.1f B/edge)  CSR %8.2f MB (%5.1f B/edge)  %4.1fx smaller  finalize %6.1f ms\n",
+                report.adjacencyListBytes / (1024.0 * 1024.0),
+                static_cast<double>(report.adjacencyListBytes) / std::max<size_t>(1, report.edges),
+                report.compactBytes / (1024.0 * 1024.0),
+                static_cast<double>(report.compactBytes) / std::max<size_t>(1, report.edges),
+                static_cast<double>(report.adjacencyListBytes) / std::max<size_t>(1, report.compactBytes),
+                finalizeMs);
+    
+    // Paires à au plus 40 pas de grille (sous la limite d'itérations de findPath)
+    const RoadNetwork& network = roads.getNetwork();
+    PathPlanner planner(&roads);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> nodeDist(0, side * side - 1);
+    
+    double boostMs = 0.0;
+    double plannerMs = 0.0;
+    double nearestMs = 0.0;
+    int found = 0;
+    int mismatches = 0;
+    std::vector<VertexDescriptor> predecessors(boost::num_vertices(reference));
+    std::vector<double> distances(boost::num_vertices(reference));
+    for (int q = 0; q < queries; ++q) {
+        const int from = nodeDist(gen);
+        int to = from;
+        while (to == from || std::abs(to / side - from / side) + std::abs(to % side - from % side) > 40) {
+            to = nodeDist(gen);
+        }
+        
+        std::fill(distances.begin(), distances.end(), std::numeric_limits<double>::max());
+        bool reached = false;
+        start = std::chrono::steady_clock::now();
+        try {
+            boost::astar_search(reference, from, HaversineHeuristic(reference, to),
+                                boost::predecessor_map(predecessors.data())
+                                    .distance_map(distances.data())
+                                    .visitor(GoalVisitor(to))
+                                    .weight_map(boost::get(&RoadEdge::length, reference)));
+        } catch (const GoalReached&) {
+            reached = true;
+        }
+        boostMs += elapsedMs(start);
+        
+        const QPointF source = network.getPosition(from);
+        const QPointF target = network.getPosition(to);
+        start = std::chrono::steady_clock::now();
+        roads.getNearestNode(source.y(), source.x());
+        roads.getNearestNode(target.y(), target.x());
+        nearestMs += elapsedMs(start);
+        
+        start = std::chrono::steady_clock::now();
+        const auto path = planner.findPath(source, target);
+        plannerMs += elapsedMs(start);
+        
+        // Longueur hors points de départ et d'arrivée exacts
+        double length = 0.0;
+        for (size_t k = 2; k + 1 < path.size(); ++k) {
+            length += GeometryUtils::haversineDistance(path[k - 1].y(), path[k - 1].x(), path[k].y(), path[k].x());
+        }
+        if (reached != !path.empty()
+            || (reached && std::abs(length - distances[to]) > 1e-6 * std::max(1.0, distances[to]))) {
+            ++mismatches;
+        }
+        found += reached;
+    }
+    
+    std::printf("A* (%d queries, %d found): Boost %7.3f ms  CSR %7.3f ms (findPath %7.3f ms incl. nearest-node %7.3f ms)  %s\n",
+                queries, found, boostMs / queries, (plannerMs - nearestMs) / queries, plannerMs / queries,
+                nearestMs / queries, mismatches == 0 ? "identical lengths" : "MISMATCH");
+    
+    // Nœud le plus proche de points quelconques de l'emprise (et un peu au-delà)
+    std::uniform_real_distribution<> latDist(47.69, 47.71 + side * 0.0009);
+    std::uniform_real_distribution<> lonDist(7.29, 7.31 + side * 0.0013);
+    std::vector<std::pair<double, double>> points(queries);
+    for (auto& point : points) {
+        point = {latDist(gen), lonDist(gen)};
+    }
+    
+    double linearMs = 0.0;
+    double rtreeMs = 0.0;
+    int nearestMismatches = 0;
+    for (const auto& [lat, lon] : points) {
+        start = std::chrono::steady_clock::now();
+        const VertexDescriptor expected = nearestLinear(network, lat, lon);
+        linearMs += elapsedMs(start);
+        
+        start = std::chrono::steady_clock::now();
+        const VertexDescriptor nearest = roads.getNearestNode(lat, lon);
+        rtreeMs += elapsedMs(start);
+        
+        // Ex aequo possibles: seule la distance compte
+        const auto distanceTo = [&](VertexDescriptor node) {
+            return GeometryUtils::haversineDistance(lat, lon, network.getLatitude(node), network.getLongitude(node));
+        };
+        if (std::abs(distanceTo(nearest) - distanceTo(expected)) > 1e-6) {
+            ++nearestMismatches;
+        }
+    }
+    
+    // k plus proches: distances croissantes, le premier est le plus proche
+    const size_t k = 16;
+    std::vector<VertexDescriptor> neighbors;
+    int orderErrors = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& [lat, lon] : points) {
+        roads.getNearestNodes(lat, lon, k, neighbors);
+        double previous = 0.0;
+        for (VertexDescriptor node : neighbors) {
+            const double dist = GeometryUtils::haversineDistance(lat, lon, network.getLatitude(node),
+                                                                 network.getLongitude(node));
+            if (dist + 1e-6 < previous) {
+                ++orderErrors;
+            }
+            previous = dist;
+        }
+        if (neighbors.size() != std::min(k, network.getNodeCount())
+            || neighbors.front() != roads.getNearestNode(lat, lon)) {
+            ++orderErrors;
+        }
+    }
+    const double knnMs = elapsedMs(start);
+    
+    // Requêtes concurrentes (génération parallèle de routes)
+    const unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<int> parallelMismatches{0};
+    std::vector<VertexDescriptor> sequential(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        sequential[i] = roads.getNearestNode(points[i].first, points[i].second);
+    }
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = t; i < points.size(); i += threadCount) {
+                if (roads.getNearestNode(points[i].first, points[i].second) != sequential[i]) {
+                    parallelMismatches.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double parallelMs = elapsedMs(start);
+    
+    // Positions non finies: aucun nœud (pas le nœud 0)
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (roads.getNearestNode(nan, 7.34) != RoadGraph::nullVertex()
+        || roads.getNearestNode(47.75, std::numeric_limits<double>::infinity()) != RoadGraph::nullVertex()
+        || !planner.findPath(QPointF(nan, nan), network.getPosition(0)).empty()) {
+        ++nearestMismatches;
+    }
+    
+    std::printf("Nearest node (%d queries): linear %8.4f ms  R-tree %8.4f ms  (%6.0fx)  %d-nearest %8.4f ms  %u threads %8.4f ms  %s\n",
+                queries, linearMs / queries, rtreeMs / queries, linearMs / std::max(1e-9, rtreeMs),
+                static_cast<int>(k), knnMs / queries, threadCount, parallelMs,
+                nearestMismatches == 0 && orderErrors == 0 && parallelMismatches == 0 ? "identical" : "MISMATCH");
+    
+    return mismatches == 0 && nearestMismatches == 0 && orderErrors == 0 && parallelMismatches == 0 ? 0 : 1;
+}
@@ -2,8 +2,11 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QFutureWatcher>
 #include <vector>
 #include <memory>
+#include <array>
+#include <string>
 #include "Vehicle.hpp"
 
 namespace v2v {
@@ -12,7 +15,16 @@ namespace v2v {
 namespace network { 
     class RoadGraph; 
     class InterferenceGraph;
+    class ComponentTracker;
+    class LinkStatistics;
+    class TemporalGraphStore;
+    class GraphMetrics;
+    class DisseminationEngine;
+    class MacLayer;
+    class BeaconScheduler;
     class PathPlanner;
+    class RoadsideUnits;
+    class ChannelAssignment;
 }
 
 namespace core {
@@ -35,10 +47,10 @@ public:
         Running,
         Paused
     };
-
+    
     explicit SimulationEngine(QObject* parent = nullptr);
     ~SimulationEngine() override;
-
+    
     // Contrôle de la simulation
     void start();
     void pause();
@@ -50,12 +62,82 @@ public:
     void setTargetFPS(int fps);
     void setVehicleCount(int count);
     
+    /**
+     * @brief Profil de rayon par classe: appliqué en bloc aux véhicules de la
+     *        classe et aux véhicules créés ensuite; pour la classe RSU, aux
+     *        RSU chargées sans rayon (couverture reconstruite) et aux suivantes
+     * @return Nombre de véhicules (ou de RSU) mis à jour
+     */
+    int setClassRadius(VehicleClass vehicleClass, int radius);
+    int getClassRadius(VehicleClass vehicleClass) const { return m_classRadii[static_cast<int>(vehicleClass)]; }
+    
+    /**
+     * @brief Part de camions parmi les véhicules créés (0-1)
+     */
+    void setTruckFraction(double fraction);
+    double getTruckFraction() const { return m_truckFraction; }
+    
+    /**
+     * @brief Métriques de topologie recalculées tous les N updates du graphe
+     *        (0 = jamais), sur un thread de travail à partir de la version
+     *        publiée du graphe; émet graphMetricsUpdated à la fin du calcul
+     *        (un seul calcul en cours: l'échéance suivante compte depuis sa fin)
+     */
+    void setGraphMetricsInterval(int updates) { m_graphMetricsInterval = updates; }
+    int getGraphMetricsInterval() const { return m_graphMetricsInterval; }
+    
+    /**
+     * @brief Graphe V2V paresseux: update complet (delta, clusters, canaux,
+     *        métriques) seulement aux ticks où un consommateur le demande
+     *        (enregistrement, métriques dues, affichage des liens, canaux,
+     *        MAC, beacons, RSU); sinon voisins calculés à la demande
+     */
+    void setLazyGraph(bool lazy);
+    bool isLazyGraph() const;
+    
+    /**
+     * @brief Statistiques de liens et historique de connectivité (désactivés
+     *        par défaut: ils demandent l'adjacence complète à chaque update,
+     *        graphe paresseux ou non); réactivés en cours de run, ils repartent
+     *        de l'adjacence courante (liens rompus entre-temps clos, liens
+     *        ouverts sans début connu)
+     */
+    void setRecording(bool recording);
+    bool isRecording() const { return m_recording; }
+    
+    /**
+     * @brief Dossier des rapports écrits à l'arrêt de chaque run, nommés
+     *        avec l'heure de l'arrêt (vide, par défaut: aucun fichier écrit)
+     */
+    void setReportDirectory(const std::string& directory) { m_reportDirectory = directory; }
+    const std::string& getReportDirectory() const { return m_reportDirectory; }
+    
+    /**
+     * @brief Liens V2V affichés: adjacence complète demandée à chaque update
+     */
+    void setConnectionsVisible(bool visible) { m_connectionsVisible = visible; }
+    
+    /**
+     * @brief Charge les RSU d'un fichier CSV (rayon par défaut: profil de la
+     *        classe RSU); associées aux véhicules à chaque frame ensuite
+     */
+    bool loadRoadsideUnits(const std::string& filename);
+    
     // Accès aux données
     std::vector<std::shared_ptr<Vehicle>>& getVehicles() { return m_vehicles; }
     const std::vector<std::shared_ptr<Vehicle>>& getVehicles() const { return m_vehicles; }
     network::RoadGraph* getRoadGraph() const { return m_roadGraph.get(); }
     network::InterferenceGraph* getInterferenceGraph() const { return m_interferenceGraph.get(); }
+    network::ComponentTracker* getComponentTracker() const { return m_componentTracker.get(); }
+    network::LinkStatistics* getLinkStatistics() const { return m_linkStatistics.get(); }
+    network::TemporalGraphStore* getTemporalGraph() const { return m_temporalGraph.get(); }
+    network::GraphMetrics* getGraphMetrics() const { return m_graphMetrics.get(); }  // Après graphMetricsUpdated
+    network::DisseminationEngine* getDisseminationEngine() const { return m_disseminationEngine.get(); }
+    network::MacLayer* getMacLayer() const { return m_macLayer.get(); }
+    network::BeaconScheduler* getBeaconScheduler() const { return m_beaconScheduler.get(); }
     network::PathPlanner* getPathPlanner() const { return m_pathPlanner.get(); }
+    network::RoadsideUnits* getRoadsideUnits() const { return m_roadsideUnits.get(); }
+    network::ChannelAssignment* getChannelAssignment() const { return m_channelAssignment.get(); }
     
     // État
     State getState() const { return m_state; }
@@ -63,7 +145,7 @@ public:
     int getActiveVehicleCount() const;
     double getSimulationTime() const { return m_simulationTime; }
     int getCurrentFPS() const { return m_currentFPS; }
-    
+
 signals:
     void simulationStarted();
     void simulationPaused();
@@ -74,14 +156,40 @@ signals:
     void vehicleCountChanged(int count);
     /** Emitted every simulation update (frame) */
     void tick();
+    /** Emitted after each graph metrics computation */
+    void graphMetricsUpdated();
 
 private slots:
     void updateSimulation();
-    
+
 private:
     void createVehicles(int count);
+    
+    /**
+     * @brief Classe tirée selon la part de camions, rayon de son profil
+     */
+    void assignClass(Vehicle& vehicle, double draw) const;
+    
+    /**
+     * @brief Instanciation du noyau de découverte des liens selon les rayons
+     *        du scénario (chargement ou changement de profil)
+     */
+    void selectLinkKernel();
     void updateVehiclePositions(double deltaTime);
     void updateInterferenceGraph();
+    
+    /**
+     * @brief Tient (ou rend) l'abonnement au graphe qui demande un update
+     *        complet au nom des consommateurs du moteur
+     */
+    void holdGraphSubscription(bool needed);
+    
+    /**
+     * @brief Chemin d'un rapport du run dans le dossier des rapports
+     *        (vide si aucun dossier n'est configuré)
+     */
+    std::string reportPath(const std::string& name, const std::string& extension) const;
+    
     void calculateFPS();
     
     State m_state;
@@ -92,9 +200,28 @@ private:
     double m_simulationTime;
     
     std::vector<std::shared_ptr<Vehicle>> m_vehicles;
+    std::array<int, Vehicle::VEHICLE_CLASS_COUNT> m_classRadii;
+    double m_truckFraction;
     std::unique_ptr<network::RoadGraph> m_roadGraph;
     std::unique_ptr<network::InterferenceGraph> m_interferenceGraph;
+    std::unique_ptr<network::ComponentTracker> m_componentTracker;
+    std::unique_ptr<network::LinkStatistics> m_linkStatistics;
+    std::unique_ptr<network::TemporalGraphStore> m_temporalGraph;
+    std::unique_ptr<network::GraphMetrics> m_graphMetrics;
+    int m_graphMetricsInterval;
+    int m_graphUpdatesSinceMetrics;
+    QFutureWatcher<void>* m_metricsWatcher;
+    bool m_recording;
+    bool m_connectionsVisible;
+    std::string m_reportDirectory;
+    std::string m_reportStamp;          // Heure de l'arrêt, commune aux rapports d'un run
+    int m_graphSubscription;            // -1: aucun update complet demandé
+    std::unique_ptr<network::DisseminationEngine> m_disseminationEngine;
+    std::unique_ptr<network::MacLayer> m_macLayer;
+    std::unique_ptr<network::BeaconScheduler> m_beaconScheduler;
     std::unique_ptr<network::PathPlanner> m_pathPlanner;
+    std::unique_ptr<network::RoadsideUnits> m_roadsideUnits;
+    std::unique_ptr<network::ChannelAssignment> m_channelAssignment;
     
     // Performance monitoring
     qint64 m_lastUpdateTime;
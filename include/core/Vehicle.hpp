@@ -8,6 +8,16 @@
 namespace v2v {
 namespace core {
 
+/**
+ * @brief Classe de véhicule: son rayon de transmission suit le profil de la
+ *        classe (SimulationEngine::setClassRadius)
+ */
+enum class VehicleClass {
+    Car,
+    Truck,          // Antenne plus haute: portée supérieure
+    RoadsideUnit    // Unité de bord de route (RSU), fixe
+};
+
 /**
  * @brief Représente un véhicule dans la simulation V2V
  * 
@@ -15,6 +25,7 @@ namespace core {
  * - Position géographique (lat/lon)
  * - Vitesse et direction
  * - Rayon de transmission (100-500m)
+ * - Classe (voiture, camion, RSU)
  * - État de connexion aux autres véhicules
  */
 class Vehicle : public QObject {
@@ -32,6 +43,7 @@ public:
     double getSpeed() const { return m_speed; }
     double getDirection() const { return m_direction; }
     int getTransmissionRadius() const { return m_transmissionRadius; }
+    VehicleClass getVehicleClass() const { return m_vehicleClass; }
     bool isActive() const { return m_isActive; }
     
     // Setters
@@ -40,6 +52,7 @@ public:
     void setSpeed(double speed);
     void setDirection(double direction);
     void setTransmissionRadius(int radius);
+    void setVehicleClass(VehicleClass vehicleClass) { m_vehicleClass = vehicleClass; }
     void setActive(bool active);
     
     // Méthodes de simulation
@@ -52,6 +65,9 @@ public:
     void clearPath();
     bool hasPath() const;
     
+    static constexpr int VEHICLE_CLASS_COUNT = 3;
+    static const char* className(VehicleClass vehicleClass);
+    
 signals:
     void positionChanged(int vehicleId, QPointF newPosition);
     void speedChanged(int vehicleId, double newSpeed);
@@ -66,6 +82,7 @@ private:
     double m_speed;              // m/s
     double m_direction;          // Radians (0 = Nord)
     int m_transmissionRadius;    // Mètres (100-500)
+    VehicleClass m_vehicleClass;
     bool m_isActive;
     
     // Chemin à suivre
@@ -7,7 +7,7 @@
 namespace v2v {
 
 // Forward declaration
-namespace network { class RoadGraph; }
+namespace network { class RoadGraph; class BuildingIndex; }
 
 namespace data {
 
@@ -25,9 +25,12 @@ public:
      * @brief Charger un fichier OSM et construire le graphe routier
      * @param filename Chemin vers fichier .osm.pbf ou .osm
      * @param roadGraph Graphe routier à remplir
+     * @param buildings Si non nul, rempli avec les emprises des bâtiments
+     *        (chemins fermés building=*) puis construit
      * @return true si succès
      */
-    bool loadFile(const std::string& filename, network::RoadGraph* roadGraph);
+    bool loadFile(const std::string& filename, network::RoadGraph* roadGraph,
+                  network::BuildingIndex* buildings = nullptr);
 
 private:
     class Impl;
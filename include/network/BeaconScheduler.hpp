@@ -0,0 +1,208 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Génération des beacons périodiques (CAM) au niveau message, avec
+ *        contrôle de congestion DCC réactif
+ *
+ * Complément léger de MacLayer (pas d'accès au canal ni de collisions):
+ * - Chaque véhicule émet un CAM toutes les minInterval à maxInterval secondes
+ *   (10 Hz à 1 Hz), plus une gigue tirée par beacon; le premier est tiré à une
+ *   phase propre dans l'intervalle
+ * - Prochaines émissions rangées dans une roue temporelle hiérarchique
+ *   (créneaux de tickDuration, 256 puis 2 x 64 créneaux par niveau): insertion
+ *   en O(1), chaque entrée redescend au plus deux fois d'un niveau; un advance
+ *   coûte O(ticks écoulés + beacons échus), indépendamment du nombre de véhicules
+ * - Réception par tous les voisins courants d'InterferenceGraph: chaque beacon
+ *   occupe le canal frameDuration chez l'émetteur et chez chacun d'eux. Seul
+ *   un compteur de réceptions par véhicule (8 octets, voisins parcourus par ID
+ *   croissant) est touché par réception: le temps occupé s'en déduit
+ * - Taux d'occupation du canal (CBR) mesuré par véhicule entre deux de ses
+ *   beacons (fenêtre d'au moins cbrWindow), lissé sur la mesure précédente
+ * - DCC réactif (ETSI TS 102 687): état Relaxed à Restrictive selon le CBR
+ *   lissé, intervalle minimal entre deux beacons imposé par l'état; montée
+ *   immédiate, descente d'un état par mesure
+ *
+ * Présence des véhicules relue à chaque nouvel update du graphe (O(n) par
+ * update du graphe, pas par advance). Tirages pseudo-aléatoires par
+ * (véhicule, compteur): résultat reproductible.
+ */
+class BeaconScheduler {
+public:
+    enum class DccState : uint8_t {
+        Relaxed,
+        Active1,
+        Active2,
+        Active3,
+        Restrictive
+    };
+    
+    static constexpr int DCC_STATE_COUNT = 5;
+    
+    struct Parameters {
+        double minInterval = 0.1;           // 10 Hz
+        double maxInterval = 1.0;           // 1 Hz
+        double jitter = 0.005;              // Ajoutée à chaque intervalle, [0, jitter)
+        double frameDuration = 436e-6;      // 300 octets à 6 Mbit/s + préambule
+        double cbrWindow = 0.1;             // Fenêtre de mesure du CBR (ETSI: 100 ms)
+        double tickDuration = 1e-3;         // Résolution de la roue
+        bool dcc = true;                    // Adaptation du débit au CBR
+    };
+    
+    /**
+     * @brief Compteurs d'un véhicule depuis son apparition (ou resetStatistics)
+     */
+    struct VehicleStats {
+        uint64_t generated = 0;             // Beacons émis
+        uint64_t audience = 0;              // Voisins atteints par ses beacons
+        uint64_t received = 0;              // Beacons reçus par ce véhicule
+        double busyTime = 0.0;              // Canal occupé (beacons émis et reçus x frameDuration)
+        double observedTime = 0.0;          // Durée d'observation (secondes)
+        
+        double beaconRate() const {
+            return observedTime > 0.0 ? generated / observedTime : 0.0;
+        }
+        
+        double channelBusyRatio() const {
+            return observedTime > 0.0 ? std::min(busyTime / observedTime, 1.0) : 0.0;
+        }
+    };
+    
+    /**
+     * @brief Moyennes sur les véhicules présents
+     */
+    struct Summary {
+        size_t vehicles = 0;
+        uint64_t beacons = 0;
+        uint64_t receptions = 0;
+        double beaconRate = 0.0;            // Hz, moyenne par véhicule
+        double channelBusyRatio = 0.0;      // Moyenne des CBR lissés (DCC)
+        double maxChannelBusyRatio = 0.0;
+        std::array<size_t, DCC_STATE_COUNT> dccStates{};
+    };
+    
+    BeaconScheduler();
+    ~BeaconScheduler() = default;
+    
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const { return m_parameters; }
+    
+    /**
+     * @brief advance() ne fait rien tant que le beaconing est désactivé;
+     *        désactiver abandonne l'état (clear)
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    
+    /**
+     * @brief Émet les beacons échus jusqu'à simulationTime (à un tick près)
+     *        sur les voisinages du graphe courant
+     */
+    void advance(const InterferenceGraph& graph, double simulationTime);
+    
+    /**
+     * @brief Statistiques d'un véhicule, durée d'observation arrêtée au dernier advance
+     * @return false si l'ID n'a jamais été vu
+     */
+    bool getVehicleStats(int vehicleId, VehicleStats& stats) const;
+    
+    /**
+     * @brief État DCC, CBR lissé et intervalle courant d'un véhicule
+     */
+    DccState getDccState(int vehicleId) const;
+    double getChannelBusyRatio(int vehicleId) const;
+    double getBeaconInterval(int vehicleId) const;
+    
+    Summary getSummary() const;
+    
+    static const char* stateName(DccState state);
+    
+    /**
+     * @brief Beacons émis depuis clear() et entrées en attente dans la roue
+     */
+    uint64_t getProcessedBeacons() const { return m_processedBeacons; }
+    size_t getScheduledCount() const { return m_scheduled; }
+    
+    /**
+     * @brief Remet les compteurs à zéro sans toucher aux échéances ni aux états DCC
+     */
+    void resetStatistics();
+    
+    /**
+     * @brief Abandonne toutes les échéances et états (temps remis à zéro)
+     */
+    void clear();
+
+private:
+    struct WheelEntry {
+        double time;
+        int vehicleId;
+    };
+    
+    struct VehicleState {
+        bool scheduled = false;     // Une entrée dans la roue
+        bool present = false;
+        uint32_t seenEpoch = 0;     // Dernière relecture du graphe où il figurait
+        DccState dccState = DccState::Relaxed;
+        double interval = 0.0;
+        double cbr = 0.0;           // CBR lissé
+        double windowStart = 0.0;
+        uint64_t windowSent = 0;    // Beacons émis depuis windowStart
+        uint64_t windowReceived = 0;// Réceptions à windowStart
+        uint64_t receivedBase = 0;  // Réceptions au dernier resetStatistics
+        double observedSince = 0.0;
+        uint64_t draws = 0;
+        VehicleStats stats;
+    };
+    
+    // Roue: niveau 0 de 2^8 créneaux d'un tick, puis 2 niveaux de 2^6
+    // créneaux couvrant chacun tout le niveau inférieur (horizon 2^20 ticks)
+    static constexpr int WHEEL_LEVELS = 3;
+    static constexpr int LEVEL0_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    
+    Parameters m_parameters;
+    bool m_enabled;
+    double m_now;
+    uint64_t m_tick;                // Premier tick non traité
+    size_t m_scheduled;
+    uint64_t m_processedBeacons;
+    double m_syncedUpdateTime;
+    uint32_t m_syncEpoch;
+    
+    std::vector<VehicleState> m_states;     // Par ID véhicule
+    std::vector<uint64_t> m_received;       // Réceptions depuis clear(), par ID véhicule
+    std::array<std::vector<std::vector<WheelEntry>>, WHEEL_LEVELS> m_wheel;
+    std::vector<WheelEntry> m_firing;
+    
+    double draw(VehicleState& state, int vehicleId);
+    uint64_t tickOf(double time) const;
+    
+    /**
+     * @brief Relit les véhicules du graphe: les nouveaux reçoivent leur premier beacon
+     */
+    void synchronize(const InterferenceGraph& graph);
+    
+    void schedule(int vehicleId, double time);
+    void insert(const WheelEntry& entry);
+    
+    /**
+     * @brief Redescend les entrées du créneau courant du niveau donné
+     */
+    void cascade(int level);
+    
+    void fire(const InterferenceGraph& graph, const WheelEntry& entry);
+    void updateDcc(VehicleState& state) const;
+};
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Emprises des bâtiments (OSM building=*) pour les tests de visibilité
+ *
+ * Chaque emprise est un anneau fermé (x = lon, y = lat); ses murs (segments)
+ * sont rangés dans un R-tree construit en bloc (packing STR). Un test de
+ * visibilité directe (LOS) entre deux points interroge le R-tree avec la
+ * boîte du segment puis teste exactement l'intersection avec chaque mur
+ * candidat. À l'échelle d'une ville le plan lon/lat suffit: l'intersection de
+ * segments est invariante par l'étirement cos(lat).
+ */
+class BuildingIndex {
+public:
+    BuildingIndex();
+    
+    /**
+     * @brief Ajoute une emprise (anneau, fermé ou non); ignorée sous 3 sommets
+     */
+    void addFootprint(const std::vector<Point2D>& ring);
+    
+    /**
+     * @brief Construit le R-tree des murs (à appeler après les addFootprint)
+     */
+    void build();
+    
+    /**
+     * @brief Nombre de murs traversés par le segment [a, b]
+     * @param maxWalls Arrêt dès ce nombre atteint (1 = simple test d'obstruction)
+     */
+    int countWallCrossings(const Point2D& a, const Point2D& b, int maxWalls = 255) const;
+    
+    bool isLineOfSight(const Point2D& a, const Point2D& b) const {
+        return countWallCrossings(a, b, 1) == 0;
+    }
+    
+    size_t getBuildingCount() const { return m_buildingCount; }
+    size_t getWallCount() const { return m_walls.size(); }
+    bool empty() const { return m_walls.empty(); }
+    
+    void clear();
+
+private:
+    struct Wall {
+        double x1, y1, x2, y2;
+    };
+    
+    using WallValue = std::pair<Box, uint32_t>;    // (boîte du mur, index dans m_walls)
+    using WallTree = bgi::rtree<WallValue, bgi::quadratic<16>>;
+    
+    std::vector<Wall> m_walls;
+    WallTree m_tree;
+    size_t m_buildingCount;
+};
+
+} // namespace network
+} // namespace v2v
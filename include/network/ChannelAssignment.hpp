@@ -0,0 +1,185 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+class InterferenceGraph;
+
+/**
+ * @brief Attribution des canaux de service (SCH) aux véhicules: deux voisins
+ *        du graphe V2V partageant un canal sont en conflit
+ *
+ * Coloration gloutonne parallèle sur une palette limitée (channelCount):
+ * - Priorités: hachage de l'ID véhicule et de la graine, stables d'un tick à
+ *   l'autre (ex aequo: ID croissant)
+ * - Coloration complète (premier update, setParameters, recolorAll): style
+ *   Jones-Plassmann. Un véhicule est coloré dès que tous ses voisins de plus
+ *   forte priorité le sont; chaque vague est traitée en parallèle (TBB), un
+ *   compteur de voisins prioritaires restants par véhicule forme la vague
+ *   suivante: travail O(liens), résultat identique à la coloration gloutonne
+ *   séquentielle par priorité décroissante, quel que soit l'ordonnancement
+ * - Choix du canal: plus petit canal libre parmi les voisins déjà colorés;
+ *   palette épuisée: canal le moins partagé (conflits inévitables)
+ * - Ensuite, recoloration incrémentale à partir du delta de liens: seules les
+ *   extrémités de liens formés ou rompus et les nouveaux véhicules sont
+ *   candidats. Un candidat ne change de canal que s'il réduit strictement
+ *   ses conflits (pas de changement de canal inutile, pas d'oscillation).
+ *   Tours spéculatifs: propositions calculées en parallèle sur les canaux
+ *   du tour précédent; de deux voisins qui veulent changer, seul le plus
+ *   prioritaire change et l'autre est réexaminé au tour suivant (au plus
+ *   MAX_ROUNDS tours, reliquat traité séquentiellement). Chaque tour fait
+ *   donc strictement baisser le nombre de conflits.
+ * - La coloration complète est suivie des mêmes tours sur tous les
+ *   véhicules (les vagues ignorent les voisins moins prioritaires)
+ *
+ * Conflits (liens dont les deux extrémités ont le même canal) tenus à jour à
+ * chaque tick à partir du delta et des changements de canal, sans recompte.
+ */
+class ChannelAssignment {
+public:
+    static constexpr int MAX_CHANNELS = 64;
+    static constexpr int MAX_ROUNDS = 8;
+    
+    struct Parameters {
+        int channelCount = 6;       // Canaux de service de 10 MHz (ITS-G5 / DSRC)
+        uint64_t seed = 1;          // Graine des priorités
+    };
+    
+    /**
+     * @brief Dernier tick et cumuls depuis clear
+     */
+    struct Summary {
+        size_t vehicles = 0;
+        size_t links = 0;
+        size_t conflicts = 0;           // Liens entre véhicules de même canal
+        double conflictRatio = 0.0;     // conflicts / links
+        int channelsUsed = 0;
+        size_t candidates = 0;          // Véhicules réexaminés
+        size_t recolored = 0;           // Changements de canal (coloration complète: véhicules colorés)
+        int rounds = 0;                 // Vagues Jones-Plassmann et tours spéculatifs
+        bool fullColoring = false;
+        double computeMs = 0.0;
+        uint64_t updates = 0;
+        uint64_t totalRecolored = 0;    // Changements de canal hors colorations complètes
+    };
+    
+    ChannelAssignment();
+    ~ChannelAssignment() = default;
+    
+    /**
+     * @brief Nouvelle palette ou graine: recoloration complète au prochain update
+     */
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const { return m_parameters; }
+    
+    /**
+     * @brief update() ne fait rien tant que l'attribution est désactivée;
+     *        désactiver oublie les canaux (clear)
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    
+    /**
+     * @brief Calcul parallèle (TBB) ou séquentiel, mêmes canaux
+     */
+    void setParallel(bool parallel) { m_parallel = parallel; }
+    
+    /**
+     * @brief Applique le dernier delta du graphe (à appeler après chaque update)
+     */
+    void update(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Coloration complète du graphe courant (canaux précédents oubliés)
+     */
+    void recolorAll(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Canal d'un véhicule (0..channelCount-1, -1 si absent)
+     */
+    int getChannel(int vehicleId) const;
+    
+    /**
+     * @brief Véhicules par canal au dernier update
+     */
+    const std::vector<size_t>& getChannelUsage() const { return m_channelUsage; }
+    
+    const Summary& getSummary() const { return m_summary; }
+    
+    /**
+     * @brief Recompte complet des liens en conflit (vérification)
+     */
+    size_t countConflicts(const InterferenceGraph& graph) const;
+    
+    void logSummary() const;
+    
+    /**
+     * @brief Oublie canaux et cumuls (le prochain update recolore tout)
+     */
+    void clear();
+
+private:
+    Parameters m_parameters;
+    bool m_enabled;
+    bool m_parallel;
+    bool m_colored;                     // Coloration complète faite
+    
+    // Par ID véhicule
+    std::vector<int8_t> m_channel;      // -1: non coloré
+    std::vector<uint64_t> m_priority;
+    std::vector<uint32_t> m_seenStamp;
+    std::vector<uint32_t> m_candidateStamp;
+    std::vector<uint32_t> m_roundStamp; // Candidat au tour de ce numéro
+    std::vector<int8_t> m_proposal;     // Canal proposé à ce tour
+    uint32_t m_stamp;
+    uint32_t m_round;
+    
+    std::vector<int> m_trackedIds;
+    std::vector<int> m_candidates;
+    std::vector<int32_t> m_gains;       // Par candidat: conflits après - avant
+    std::vector<uint8_t> m_decisions;
+    
+    // Coloration complète: voisins prioritaires restants (par ID), vagues
+    std::vector<uint32_t> m_pending;
+    std::vector<int> m_wave;
+    std::vector<int> m_nextWave;
+    
+    std::vector<size_t> m_channelUsage;
+    size_t m_conflicts;
+    Summary m_summary;
+    
+    void ensureCapacity(int vehicleId);
+    uint64_t priorityOf(int vehicleId) const;
+    
+    bool higherPriority(int vehicleId1, int vehicleId2) const {
+        return m_priority[vehicleId1] > m_priority[vehicleId2]
+            || (m_priority[vehicleId1] == m_priority[vehicleId2] && vehicleId1 < vehicleId2);
+    }
+    
+    /**
+     * @brief Canal le moins partagé avec les voisins colorés (plus petit
+     *        ex aequo, sauf current conservé à égalité); conflicts reçoit le
+     *        nombre de voisins sur le canal retenu et currentConflicts celui
+     *        sur current
+     */
+    int chooseChannel(std::span<const int> neighbors, int current,
+                      size_t& conflicts, size_t& currentConflicts) const;
+    
+    /**
+     * @brief Tours spéculatifs sur m_candidates (vidé)
+     */
+    void recolorCandidates(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Occupation des canaux et résumé du tick
+     */
+    void finishUpdate(const InterferenceGraph& graph);
+};
+
+} // namespace network
+} // namespace v2v
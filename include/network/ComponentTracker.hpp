@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <utility>
+
+namespace v2v {
+namespace network {
+
+class InterferenceGraph;
+
+/**
+ * @brief Suivi incrémental des composantes connexes (clusters) du graphe V2V
+ *
+ * Consomme le delta de liens produit par InterferenceGraph::update au lieu
+ * de refaire un parcours complet à chaque tick:
+ * - Lien formé: fusion des deux clusters (le plus petit est réétiqueté dans
+ *   le plus grand, union par taille)
+ * - Lien rompu: écarté si les extrémités restent reliées (voisin commun, ou
+ *   recherche locale à budget fixe, qui détache au passage les fragments
+ *   qu'elle explore entièrement); sinon ses extrémités lancent, par cluster,
+ *   des recherches menées en alternance qui s'arrêtent dès qu'il ne reste
+ *   qu'un front actif: le coût est celui des fragments détachés, pas du
+ *   cluster entier
+ * - Delta de plus d'un huitième des liens: réétiquetage complet (BFS)
+ *
+ * Les véhicules sans lien forment des clusters de taille 1 (véhicules isolés).
+ */
+class ComponentTracker {
+public:
+    ComponentTracker();
+    ~ComponentTracker() = default;
+    
+    /**
+     * @brief Applique le dernier delta du graphe (à appeler après chaque update)
+     */
+    void update(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Identifiant du cluster d'un véhicule (-1 si absent)
+     *
+     * Stable tant que le cluster n'est pas fusionné ni scindé.
+     */
+    int getClusterId(int vehicleId) const;
+    size_t getClusterSize(int vehicleId) const;
+    
+    /**
+     * @brief Statistiques de partition du réseau
+     */
+    size_t getVehicleCount() const { return m_vehicleCount; }
+    size_t getClusterCount() const { return m_clusterCount; }
+    size_t getLargestClusterSize() const { return m_largestClusterSize; }
+    double getIsolatedFraction() const;
+    
+    /**
+     * @brief Histogramme des tailles de clusters, par classes de puissances de 2:
+     *        entrée k = nombre de clusters de taille dans [2^k, 2^(k+1))
+     */
+    const std::vector<size_t>& getSizeHistogram() const { return m_sizeHistogram; }
+    
+    /**
+     * @brief Nombre de voisins parcourus par les recherches de scission au dernier update
+     */
+    uint64_t getLastSplitVisits() const { return m_lastSplitVisits; }
+    
+    /**
+     * @brief Oublie tous les clusters (le prochain update repart du graphe courant)
+     */
+    void clear();
+
+private:
+    // Véhicule -> cluster et position dans la liste des membres (-1 si absent)
+    std::vector<int> m_clusterOf;
+    std::vector<int> m_memberPos;
+    
+    // Cluster -> membres (IDs véhicules); les clusters vides sont recyclés
+    std::vector<std::vector<int>> m_members;
+    std::vector<int> m_freeClusters;
+    
+    // Présence au dernier update (pour détecter arrivées et départs)
+    std::vector<int> m_trackedIds;
+    std::vector<uint32_t> m_seenStamp;
+    uint32_t m_stamp;
+    
+    // Extrémités de liens rompus par cluster (dédoublonnées par m_seedStamp)
+    std::vector<std::vector<int>> m_clusterSeeds;
+    std::vector<int> m_touchedClusters;
+    std::vector<uint32_t> m_seedStamp;
+    std::vector<uint32_t> m_detachedStamp;  // Détaché dans un fragment pendant cet update
+    std::vector<std::pair<int, int>> m_departedLinks; // (véhicule parti, ancien voisin)
+    
+    // Compteurs par taille (index = taille) et histogramme log2
+    std::vector<size_t> m_countBySize;
+    std::vector<size_t> m_sizeHistogram;
+    size_t m_vehicleCount;
+    size_t m_clusterCount;
+    size_t m_largestClusterSize;
+    uint64_t m_lastSplitVisits;
+    
+    // Recherche de scission: marque de visite par véhicule (avec époque)
+    // et fronts des recherches simultanées
+    struct Search {
+        std::vector<int> frontier;
+        std::vector<int> visited;
+        size_t head = 0;
+        int parent = 0;     // Union-find des recherches qui se sont rejointes
+    };
+    std::vector<Search> m_searches;
+    std::vector<int> m_roots;
+    std::vector<uint32_t> m_visitEpoch;
+    std::vector<int> m_visitedBy;
+    uint32_t m_epoch;
+    
+    void ensureCapacity(int vehicleId);
+    
+    int allocateCluster();
+    void releaseCluster(int cluster);
+    void addMember(int cluster, int vehicleId);
+    void removeMember(int vehicleId);
+    
+    /**
+     * @brief Le cluster change de taille: met à jour compteurs et histogramme
+     */
+    void countCluster(size_t size, int delta);
+    
+    void mergeClusters(int vehicleId1, int vehicleId2);
+    
+    /**
+     * @brief Étiquetage complet par parcours en largeur du graphe courant
+     */
+    void relabelAll(const InterferenceGraph& graph);
+    
+    static bool shareNeighbor(std::span<const int> row1, std::span<const int> row2);
+    
+    /**
+     * @brief Recherches simultanées depuis seeds (même cluster), en alternance
+     *
+     * Chaque fragment entièrement exploré sans rejoindre les autres est une
+     * composante complète et est détaché du cluster.
+     * @param visitBudget Abandon au-delà de ce nombre de voisins parcourus
+     * @return true si toutes les recherches se sont rejointes
+     */
+    bool exploreFromSeeds(const InterferenceGraph& graph, std::span<const int> seeds,
+                          size_t visitBudget);
+    
+    /**
+     * @brief Extrémités non résolues localement, à traiter par cluster
+     */
+    void addSeeds(std::span<const int> vehicleIds);
+    
+    int findSearch(int search);
+};
+
+} // namespace network
+} // namespace v2v
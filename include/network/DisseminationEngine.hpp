@@ -0,0 +1,187 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Moteur de dissémination multi-sauts sur le graphe d'interférences
+ *
+ * Les messages sont injectés (broadcast, geocast vers une zone, unicast) puis
+ * propagés saut par saut sur l'adjacence d'InterferenceGraph:
+ * - Un saut dure hopLatency secondes de temps de simulation; advance() joue
+ *   tous les sauts échus depuis l'appel précédent
+ * - Propagation par fronts: les véhicules atteints au saut k réémettent au
+ *   saut k + 1 selon la politique de réémission (inondation, probabiliste,
+ *   fondée sur la distance à l'émetteur)
+ * - Les messages sont indépendants: ils sont propagés en parallèle (TBB),
+ *   avec un tirage pseudo-aléatoire par (message, véhicule) donc un résultat
+ *   identique en serial
+ *
+ * Chaque message terminé produit un MessageResult (taux de livraison,
+ * latence, surcoût en émissions).
+ */
+class DisseminationEngine {
+public:
+    enum class MessageType {
+        Broadcast,  // Tous les véhicules
+        Geocast,    // Véhicules dans une zone (lat/lon) au moment de l'injection
+        Unicast     // Un véhicule destinataire; la propagation s'arrête à la livraison
+    };
+    
+    enum class RebroadcastPolicy {
+        Flooding,       // Tout véhicule atteint pour la première fois réémet
+        Probabilistic,  // Réémission avec probabilité p (gossip)
+        DistanceBased   // Réémission si assez loin de l'émetteur (couverture nouvelle)
+    };
+    
+    /**
+     * @brief Bilan d'un message terminé
+     */
+    struct MessageResult {
+        int messageId = -1;
+        MessageType type = MessageType::Broadcast;
+        int sourceId = -1;
+        double createdAt = 0.0;
+        double completedAt = 0.0;
+        
+        size_t targets = 0;         // Destinataires visés (hors source)
+        size_t delivered = 0;       // Destinataires atteints
+        double meanLatency = 0.0;   // Moyenne sur les destinataires atteints (s)
+        double maxLatency = 0.0;
+        int hops = 0;               // Nombre de sauts joués
+        
+        size_t transmissions = 0;   // Émissions (source + réémissions)
+        size_t receptions = 0;      // Réceptions, doublons compris
+        
+        double deliveryRatio() const {
+            return targets > 0 ? static_cast<double>(delivered) / targets : 0.0;
+        }
+        
+        /**
+         * @brief Émissions par destinataire atteint
+         */
+        double overhead() const {
+            return delivered > 0 ? static_cast<double>(transmissions) / delivered : 0.0;
+        }
+    };
+    
+    /**
+     * @brief Moyennes sur les messages terminés
+     */
+    struct Summary {
+        size_t messages = 0;
+        double deliveryRatio = 0.0;
+        double meanLatency = 0.0;
+        double transmissionsPerMessage = 0.0;
+        double overhead = 0.0;
+    };
+    
+    DisseminationEngine();
+    ~DisseminationEngine() = default;
+    
+    /**
+     * @brief Paramètres appliqués aux messages injectés ensuite
+     */
+    void setHopLatency(double seconds);
+    void setMaxHops(int hops);
+    void setRebroadcastPolicy(RebroadcastPolicy policy) { m_policy = policy; }
+    void setRebroadcastProbability(double probability);
+    void setMinRebroadcastDistance(double meters);
+    
+    double getHopLatency() const { return m_hopLatency; }
+    int getMaxHops() const { return m_maxHops; }
+    RebroadcastPolicy getRebroadcastPolicy() const { return m_policy; }
+    
+    /**
+     * @brief Propagation parallèle des messages (TBB); même résultat qu'en serial
+     */
+    void setParallel(bool enabled) { m_parallel = enabled; }
+    
+    /**
+     * @brief Injection d'un message émis par sourceId à l'instant simulationTime
+     * @return Identifiant du message
+     */
+    int broadcast(int sourceId, double simulationTime);
+    int geocast(int sourceId, const Box& region, double simulationTime);
+    int unicast(int sourceId, int destinationId, double simulationTime);
+    
+    /**
+     * @brief Joue tous les sauts échus jusqu'à simulationTime sur le graphe courant
+     */
+    void advance(const InterferenceGraph& graph, double simulationTime);
+    
+    size_t getActiveMessageCount() const { return m_active.size(); }
+    
+    /**
+     * @brief Messages terminés depuis le dernier clearCompleted
+     */
+    const std::vector<MessageResult>& getCompleted() const { return m_completed; }
+    Summary getSummary() const;
+    void clearCompleted() { m_completed.clear(); }
+    
+    /**
+     * @brief Abandonne les messages en cours et les bilans
+     */
+    void clear();
+
+private:
+    struct Message {
+        MessageResult result;
+        Box region;
+        int destinationId = -1;
+        RebroadcastPolicy policy = RebroadcastPolicy::Flooding;
+        double probability = 1.0;
+        double minDistance = 0.0;
+        double hopLatency = 0.0;
+        int maxHops = 0;
+        
+        bool started = false;
+        bool finished = false;
+        double latencySum = 0.0;
+        std::vector<int> targetIds;         // Geocast: destinataires, triés
+        std::vector<uint64_t> received;     // Bitset par ID véhicule (libéré à la fin)
+        std::vector<int> frontier;          // Véhicules qui émettent au prochain saut
+        std::vector<int> next;
+    };
+    
+    std::vector<Message> m_active;
+    std::vector<MessageResult> m_completed;
+    int m_nextMessageId;
+    
+    double m_hopLatency;
+    int m_maxHops;
+    RebroadcastPolicy m_policy;
+    double m_probability;
+    double m_minDistance;
+    bool m_parallel;
+    
+    int inject(MessageType type, int sourceId, double simulationTime);
+    
+    /**
+     * @brief Premier saut: source absente -> message terminé, sinon comptage
+     *        des destinataires et front initial
+     */
+    void start(Message& message, const InterferenceGraph& graph, int idBound) const;
+    
+    /**
+     * @brief Sauts échus d'un message (appelé en parallèle, un message par tâche)
+     */
+    void propagate(Message& message, const InterferenceGraph& graph, double simulationTime) const;
+    
+    // Émetteur courant (position et cos(lat) lues une fois par émission)
+    struct Sender {
+        Point2D position;
+        double cosLat;
+    };
+    
+    bool isTarget(const Message& message, int vehicleId) const;
+    bool shouldRebroadcast(const Message& message, const InterferenceGraph& graph,
+                           const Sender& sender, int receiverId) const;
+};
+
+} // namespace network
+} // namespace v2v
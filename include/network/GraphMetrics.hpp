@@ -0,0 +1,184 @@
+#pragma once
+
+#include <tbb/enumerable_thread_specific.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+class InterferenceGraph;
+class GraphSnapshot;
+
+/**
+ * @brief Métriques de topologie du graphe V2V, calculées en parallèle (TBB)
+ *        à la demande (typiquement tous les N updates)
+ *
+ * - Distribution des degrés: exacte, O(n)
+ * - Coefficient de clustering local: moyenne sur un échantillon de véhicules
+ *   (intersection des lignes triées, O(degré²) par véhicule échantillonné)
+ * - Centralité d'intermédiarité: algorithme de Brandes depuis un échantillon
+ *   de sources, extrapolé à toutes les sources; chaque parcours ne coûte que
+ *   la taille de la composante de sa source
+ * - Diamètre approché: double balayage (BFS depuis un véhicule, puis depuis
+ *   le plus éloigné), borne inférieure en sauts; les parcours de Brandes
+ *   donnent aussi la longueur moyenne des plus courts chemins
+ *
+ * Coût borné par les réglages d'échantillonnage, indépendamment de l'historique:
+ * O(n + E) pour les degrés et l'index dense, plus sources et balayages en
+ * O(n + E) chacun au pire. Échantillons tirés d'un générateur de graine fixe,
+ * renouvelés à chaque calcul: résultats reproductibles d'un run à l'autre
+ * (intermédiarité à l'arrondi près, sommée par thread).
+ */
+class GraphMetrics {
+public:
+    /**
+     * @brief Résultats du dernier calcul
+     */
+    struct Summary {
+        size_t vehicleCount = 0;
+        size_t linkCount = 0;
+        double meanDegree = 0.0;
+        size_t maxDegree = 0;
+        double isolatedFraction = 0.0;      // Véhicules de degré 0
+        double averageClustering = 0.0;     // Véhicules de degré 0 ou 1 comptés à 0
+        size_t clusteringSamples = 0;
+        double maxBetweenness = 0.0;        // Normalisée dans [0, 1]
+        int maxBetweennessVehicle = -1;
+        size_t betweennessSources = 0;
+        int diameter = 0;                   // Borne inférieure (sauts)
+        double averagePathLength = 0.0;     // Sauts, paires reliées depuis les sources
+        double computeMs = 0.0;
+    };
+    
+    GraphMetrics();
+    ~GraphMetrics() = default;
+    
+    /**
+     * @brief Calcule toutes les métriques sur le graphe courant
+     */
+    void compute(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Calcule toutes les métriques sur une version publiée complète,
+     *        p. ex. depuis un thread de travail pendant que le graphe avance
+     *        (un seul calcul à la fois par instance)
+     */
+    void compute(const GraphSnapshot& snapshot);
+    
+    /**
+     * @brief Réglages d'échantillonnage (0 = aucun; au-delà de n: tous les véhicules)
+     */
+    void setClusteringSamples(size_t samples) { m_clusteringSamples = samples; }
+    void setBetweennessSources(size_t sources) { m_betweennessSources = sources; }
+    void setDiameterSweeps(size_t sweeps) { m_diameterSweeps = sweeps; }
+    void setSeed(uint64_t seed) { m_seed = seed; }
+    size_t getClusteringSamples() const { return m_clusteringSamples; }
+    size_t getBetweennessSources() const { return m_betweennessSources; }
+    size_t getDiameterSweeps() const { return m_diameterSweeps; }
+    
+    void setParallel(bool enabled) { m_parallel = enabled; }
+    bool isParallel() const { return m_parallel; }
+    
+    const Summary& getSummary() const { return m_summary; }
+    uint64_t getComputeCount() const { return m_computeCount; }
+    
+    /**
+     * @brief Entrée d = nombre de véhicules de degré d
+     */
+    const std::vector<size_t>& getDegreeHistogram() const { return m_degreeHistogram; }
+    
+    /**
+     * @brief Intermédiarité estimée (normalisée dans [0, 1]) au dernier calcul,
+     *        0 si le véhicule était absent
+     */
+    double getBetweenness(int vehicleId) const;
+    
+    /**
+     * @brief Les count véhicules d'intermédiarité la plus forte (ID, valeur),
+     *        par valeur décroissante
+     */
+    std::vector<std::pair<int, double>> getTopBetweenness(size_t count) const;
+    
+    /**
+     * @brief Coefficient de clustering local exact d'un véhicule (0 si degré < 2)
+     */
+    static double localClustering(const InterferenceGraph& graph, int vehicleId);
+    
+    /**
+     * @brief Résumé dans le journal
+     */
+    void logSummary() const;
+    
+    void clear();
+
+private:
+    // Tampons d'un parcours (par thread): distances remises à -1 sur les seuls
+    // véhicules atteints, nombres de plus courts chemins et dépendances
+    struct Workspace {
+        std::vector<int> distance;
+        std::vector<double> pathCount;
+        std::vector<double> dependency;
+        std::vector<int> order;
+        std::vector<double> betweenness;
+        uint64_t pathLengthSum = 0;
+        uint64_t reachedPairs = 0;
+        int eccentricity = 0;
+    };
+    
+    size_t m_clusteringSamples;
+    size_t m_betweennessSources;
+    size_t m_diameterSweeps;
+    uint64_t m_seed;
+    bool m_parallel;
+    uint64_t m_computeCount;
+    
+    // Index dense du dernier calcul: ordre de getVehicleIds, adjacence CSR
+    std::vector<int> m_vehicleIds;
+    std::vector<int> m_indexOfId;
+    std::vector<size_t> m_offsets;
+    std::vector<int> m_adjacency;
+    
+    std::vector<size_t> m_degreeHistogram;
+    std::vector<double> m_betweenness;
+    Summary m_summary;
+    
+    tbb::enumerable_thread_specific<Workspace> m_workspaces;
+    
+    template <typename Graph>
+    void computeOn(const Graph& graph);
+    
+    template <typename Graph>
+    void buildDenseIndex(const Graph& graph);
+    
+    /**
+     * @brief Tirage de count indices distincts parmi n (tous si count >= n)
+     */
+    std::vector<int> sample(size_t count, uint64_t stream) const;
+    
+    template <typename Graph>
+    void computeClustering(const Graph& graph, const std::vector<int>& samples);
+    void computeBetweenness(const std::vector<int>& sources);
+    void computeDiameter(const std::vector<int>& starts);
+    
+    /**
+     * @brief Parcours en largeur depuis source: ordre de visite dans
+     *        workspace.order, retourne le véhicule le plus éloigné
+     */
+    int breadthFirst(int source, Workspace& workspace, bool countPaths) const;
+    
+    /**
+     * @brief Dimensionne les tampons au graphe courant et remet l'accumulateur à zéro
+     */
+    void prepareWorkspace(Workspace& workspace) const;
+    
+    /**
+     * @brief Remet à l'état initial les seuls véhicules atteints par le dernier parcours
+     */
+    static void resetVisited(Workspace& workspace);
+};
+
+} // namespace network
+} // namespace v2v
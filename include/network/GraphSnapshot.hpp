@@ -0,0 +1,266 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <array>
+#include <atomic>
+#include <span>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+using Polygon2D = bg::model::polygon<Point2D>;
+
+/**
+ * @brief Véhicule renvoyé par une requête des plus proches voisins
+ */
+struct NearVehicle {
+    int vehicleId;
+    double distance;    // Mètres
+};
+
+/**
+ * @brief Version immuable du graphe V2V, publiée à la fin de chaque update
+ *        (et de clear) d'InterferenceGraph
+ *
+ * Mêmes requêtes que le graphe (voisins triés par ID, positions), valides
+ * tant que le SnapshotHandle qui l'a obtenue est détenu, quel que soit le
+ * nombre d'updates entre-temps.
+ *
+ * Requêtes spatiales (k plus proches, anneau, polygone, couloir le long d'un
+ * itinéraire) servies par une grille uniforme des positions de la version,
+ * construite à la publication en O(n): véhicules triés par cellule, si bien
+ * que les cellules d'une ligne de la zone cherchée forment un seul bloc
+ * contigu (coordonnées métriques, positions et IDs). Méthodes const sans état
+ * partagé: appelables depuis autant de threads que voulu sur la même
+ * version. Résultats écrits dans out (vidé d'abord, capacité réutilisée d'un
+ * appel à l'autre). Points en (lon, lat) comme getPosition; distances dans la
+ * métrique des liens du graphe (Haversine exacte en LinkMetric::Chord).
+ */
+class GraphSnapshot {
+public:
+    std::span<const int> getNeighbors(int vehicleId) const;
+    bool getPosition(int vehicleId, Point2D& position) const;
+    bool areConnected(int vehicleId1, int vehicleId2) const;
+    
+    /**
+     * @brief Les k véhicules les plus proches de center, par distance
+     *        croissante (ex aequo: ID croissant); aucun si center n'est pas fini
+     * @param excludeId Véhicule ignoré (-1: aucun), p. ex. celui qui cherche
+     */
+    void nearest(const Point2D& center, size_t k, std::vector<NearVehicle>& out,
+                 int excludeId = -1) const;
+    
+    /**
+     * @brief Véhicules à distance d de center avec minMeters <= d <= maxMeters
+     *        (disque plein si minMeters = 0), IDs croissants; aucun si center
+     *        ou maxMeters n'est pas fini
+     */
+    void withinRing(const Point2D& center, double minMeters, double maxMeters,
+                    std::vector<int>& out) const;
+    
+    /**
+     * @brief Véhicules couverts par le polygone (bord inclus), IDs croissants
+     *
+     * Test dans le plan (lon, lat), comme les zones de geocast. Polygone
+     * orienté et fermé selon Polygon2D (bg::correct au besoin). Aucun
+     * véhicule si un sommet n'est pas fini.
+     */
+    void withinPolygon(const Polygon2D& polygon, std::vector<int>& out) const;
+    
+    /**
+     * @brief Véhicules à au plus halfWidthMeters de la polyligne route,
+     *        IDs croissants
+     *
+     * Distance à chaque segment mesurée dans une projection équirectangulaire
+     * centrée sur le segment (tronçons de route courts: écart négligeable).
+     * Points non finis ignorés (la polyligne relie les points finis).
+     */
+    void alongRoute(std::span<const Point2D> route, double halfWidthMeters,
+                    std::vector<int>& out) const;
+    
+    std::span<const int> getVehicleIds() const { return m_vehicleIds; }
+    size_t getVehicleCount() const { return m_vehicleIds.size(); }
+    size_t getConnectionCount() const { return m_linkCount; }
+    double getUpdateTime() const { return m_updateTime; }
+    
+    /**
+     * @brief false si publiée par un update paresseux du graphe: positions et
+     *        requêtes spatiales valides, mais aucune adjacence (voisins vides,
+     *        getConnectionCount() = 0)
+     */
+    bool isComplete() const { return m_complete; }
+    
+    /**
+     * @brief Numéro de publication (croissant, 0 = graphe vide initial)
+     */
+    uint64_t getVersion() const { return m_version; }
+
+private:
+    friend class InterferenceGraph;
+    friend class SnapshotPublisher;
+    
+    // Copie de l'index dense et de l'adjacence CSR du graphe
+    std::vector<int> m_vehicleIds;
+    std::vector<int> m_indexOfId;
+    std::vector<size_t> m_rowOffsets;
+    std::vector<int> m_neighborIds;
+    std::vector<Point2D> m_positions;
+    
+    // Requêtes spatiales: repère des liens, positions et IDs dans l'ordre des
+    // cellules (ligne par ligne), début de chaque cellule dans cet ordre
+    LinkFrame m_cellFrame;
+    std::vector<Point2D> m_cellPositions;
+    std::vector<int> m_cellVehicleIds;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellOf;     // Par index dense (construction)
+    std::vector<int> m_cellOrder;       // Index denses triés par cellule (construction)
+    Box m_bounds;                       // Emprise des positions
+    double m_cellLon = 1.0;             // Taille d'une cellule (degrés)
+    double m_cellLat = 1.0;
+    int m_cols = 0;
+    int m_rows = 0;
+    double m_areaPerVehicle = 0.0;      // m², rayon de départ des kNN
+    
+    size_t m_linkCount = 0;
+    bool m_complete = true;
+    double m_updateTime = 0.0;
+    uint64_t m_version = 0;
+    
+    int indexOf(int vehicleId) const;
+    
+    /**
+     * @brief Construit la grille des requêtes spatiales sur m_positions
+     *        (frame: repère des liens, dans l'ordre des index denses)
+     */
+    void buildSpatialIndex(const LinkFrame& frame);
+    
+    /**
+     * @brief Boîte (lon, lat) englobant le disque de rayon meters autour de center
+     */
+    Box searchBox(const Point2D& center, double meters) const;
+    
+    /**
+     * @brief Appelle visitor(begin, end) pour chaque bloc contigu de véhicules
+     *        (ordre des cellules) des cellules intersectant box
+     */
+    template <typename Visitor>
+    void forEachRun(const Box& box, Visitor&& visitor) const;
+};
+
+class SnapshotPublisher;
+
+/**
+ * @brief Accès en lecture à la version publiée au moment de l'acquisition
+ *
+ * Tant qu'il est détenu, la version ne peut pas être recyclée. Déplaçable,
+ * non copiable; à relâcher rapidement (une frame de rendu, un calcul de
+ * statistiques): il retient aussi les versions publiées après lui.
+ */
+class SnapshotHandle {
+public:
+    SnapshotHandle() = default;
+    SnapshotHandle(SnapshotHandle&& other) noexcept;
+    SnapshotHandle& operator=(SnapshotHandle&& other) noexcept;
+    SnapshotHandle(const SnapshotHandle&) = delete;
+    SnapshotHandle& operator=(const SnapshotHandle&) = delete;
+    ~SnapshotHandle() { release(); }
+    
+    const GraphSnapshot* get() const { return m_snapshot; }
+    const GraphSnapshot* operator->() const { return m_snapshot; }
+    const GraphSnapshot& operator*() const { return *m_snapshot; }
+    explicit operator bool() const { return m_snapshot != nullptr; }
+    
+    void release();
+
+private:
+    friend class SnapshotPublisher;
+    
+    SnapshotHandle(const SnapshotPublisher* publisher, size_t slot, const GraphSnapshot* snapshot)
+        : m_publisher(publisher), m_slot(slot), m_snapshot(snapshot) {}
+    
+    const SnapshotPublisher* m_publisher = nullptr;
+    size_t m_slot = 0;
+    const GraphSnapshot* m_snapshot = nullptr;
+};
+
+/**
+ * @brief Publication sans verrou des versions du graphe (un écrivain,
+ *        lecteurs sur n'importe quel thread)
+ *
+ * L'écrivain remplit un tampon privé (beginWrite) puis le publie par échange
+ * atomique du pointeur courant. Récupération par époques: un lecteur inscrit
+ * l'époque globale dans un emplacement libre (CAS) avant de lire le pointeur
+ * et l'efface en relâchant; une version remplacée à l'époque e est recyclée
+ * dès qu'aucun emplacement actif ne porte d'époque <= e. Les versions
+ * recyclées redeviennent tampons d'écriture (capacité conservée: aucune
+ * allocation en régime établi).
+ *
+ * Lecteurs: acquisition en O(1) hors contention, jamais bloqués par
+ * l'écrivain; au-delà de MAX_READERS lecteurs simultanés, l'acquisition
+ * attend qu'un emplacement se libère. Écrivain: jamais bloqué par les
+ * lecteurs, les versions encore lues restent simplement en attente.
+ */
+class SnapshotPublisher {
+public:
+    static constexpr size_t MAX_READERS = 64;
+    
+    SnapshotPublisher();
+    ~SnapshotPublisher();
+    
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+    
+    /**
+     * @brief Version courante (thread quelconque)
+     */
+    SnapshotHandle acquire() const;
+    
+    /**
+     * @brief Tampon d'écriture privé, à passer ensuite à publish (écrivain seul)
+     */
+    GraphSnapshot* beginWrite();
+    
+    /**
+     * @brief Publie le tampon comme version courante et recycle les versions
+     *        que plus aucun lecteur ne peut détenir (écrivain seul)
+     */
+    void publish(GraphSnapshot* snapshot);
+    
+    /**
+     * @brief Statistiques (écrivain seul)
+     */
+    uint64_t getVersion() const { return m_version; }
+    size_t getRetiredCount() const { return m_retired.size(); }
+    uint64_t getReclaimedCount() const { return m_reclaimed; }
+
+private:
+    friend class SnapshotHandle;
+    
+    // Époque inscrite par un lecteur (0 = emplacement libre), une ligne de cache chacun
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+    };
+    
+    // Tampons recyclés conservés au plus (au-delà: libérés)
+    static constexpr size_t MAX_POOLED = 2;
+    
+    std::atomic<GraphSnapshot*> m_current;
+    std::atomic<uint64_t> m_epoch;
+    mutable std::array<ReaderSlot, MAX_READERS> m_slots;
+    
+    // Écrivain seul: versions remplacées (avec leur époque), tampons libres
+    std::vector<std::pair<GraphSnapshot*, uint64_t>> m_retired;
+    std::vector<GraphSnapshot*> m_pool;
+    uint64_t m_version;
+    uint64_t m_reclaimed;
+    
+    void reclaim();
+    void releaseSlot(size_t slot) const;
+};
+
+} // namespace network
+} // namespace v2v
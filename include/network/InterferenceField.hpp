@@ -0,0 +1,120 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <tbb/enumerable_thread_specific.h>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace v2v {
+namespace network {
+
+class PropagationModel;
+
+/**
+ * @brief Puissance reçue cumulée de tous les émetteurs simultanés
+ *
+ * Agrégation hiérarchique façon Barnes-Hut sur une grille:
+ * - Niveau 0: grille uniforme (quelques émetteurs par cellule), émetteurs
+ *   triés par cellule
+ * - Niveaux supérieurs: cellules 2x2 fusionnées jusqu'à une seule racine;
+ *   chaque nœud garde sa puissance totale (mW) et son barycentre pondéré
+ * - Requête par cellule fine: descente depuis la racine. Un nœud assez petit
+ *   vu de la cellule (côté / distance < angle d'ouverture) compte comme un
+ *   émetteur unique placé à son barycentre; sinon ses enfants sont ouverts,
+ *   et les cellules proches du niveau 0 sont sommées exactement émetteur par
+ *   émetteur. La liste d'interactions obtenue sert à tous les récepteurs de
+ *   la cellule, évaluée à la position exacte de chacun
+ *
+ * Coût par récepteur O(log n + émetteurs proches) au lieu de O(n).
+ * Positions projetées dans un plan local (équirectangulaire), suffisant à
+ * l'échelle d'une ville.
+ */
+class InterferenceField {
+public:
+    InterferenceField();
+    
+    /**
+     * @brief Angle d'ouverture theta: 0 = somme exacte, 0.5 = erreur de l'ordre du pourcent
+     */
+    void setOpeningAngle(double theta);
+    double getOpeningAngle() const { return m_openingAngle; }
+    
+    /**
+     * @brief Construit la hiérarchie
+     * @param positions Positions (x = lon, y = lat) par index dense
+     * @param txPowerMw Puissance d'émission (mW) par index dense
+     */
+    void build(std::span<const Point2D> positions, std::span<const double> txPowerMw,
+               const PropagationModel& model);
+    
+    /**
+     * @brief Puissance reçue (mW) par chaque véhicule, somme sur tous les
+     *        autres émetteurs
+     * @param receivedMw Sortie par index dense (taille size())
+     * @param parallel Cellules réparties sur les threads TBB (même résultat)
+     */
+    void computeReceivedPower(std::span<double> receivedMw, bool parallel);
+    
+    /**
+     * @brief Termes de puissance sommés au dernier computeReceivedPower
+     */
+    uint64_t getEvaluations() const { return m_evaluations; }
+    
+    size_t size() const { return m_x.size(); }
+    double getCellMeters() const { return m_cellMeters; }
+    int getLevelCount() const { return static_cast<int>(m_levels.size()); }
+
+private:
+    struct Node {
+        double power = 0.0;     // Somme des puissances d'émission (mW)
+        double x = 0.0;         // Barycentre pondéré par la puissance (mètres)
+        double y = 0.0;
+    };
+    
+    struct Level {
+        int cols = 0;
+        int rows = 0;
+        double cellMeters = 0.0;
+        std::vector<Node> nodes;    // ligne * cols + colonne
+    };
+    
+    const PropagationModel* m_model;
+    double m_openingAngle;
+    double m_cellMeters;
+    
+    // Émetteurs dans le plan local, par index dense
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_power;
+    
+    // Niveau 0: indices denses triés par cellule, et copie des émetteurs dans
+    // cet ordre (somme exacte d'une cellule = parcours contigu)
+    std::vector<int> m_cellOf;
+    std::vector<size_t> m_cellStart;
+    std::vector<int> m_members;
+    std::vector<double> m_memberX;
+    std::vector<double> m_memberY;
+    std::vector<double> m_memberPower;
+    
+    // m_levels[0] = grille fine, m_levels.back() = racine (1 x 1)
+    std::vector<Level> m_levels;
+    
+    // Liste d'interactions d'une cellule fine: nœuds agrégés (SoA) et plages
+    // de m_members sommées exactement (buffers par thread, capacité conservée)
+    struct InteractionList {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> power;
+        std::vector<std::pair<size_t, size_t>> nearRanges;
+        size_t nearCount = 0;
+        uint64_t evaluations = 0;
+    };
+    tbb::enumerable_thread_specific<InteractionList> m_interactionLists;
+    uint64_t m_evaluations;
+    
+    void buildInteractionList(size_t cell, InteractionList& list) const;
+};
+
+} // namespace network
+} // namespace v2v
@@ -1,10 +1,17 @@
 #pragma once
 
-#include <boost/graph/adjacency_list.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <tbb/enumerable_thread_specific.h>
+#include "LinkKernel.hpp"
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <cstdint>
+#include <utility>
 
 namespace v2v {
 
@@ -19,28 +26,92 @@ namespace bgi = boost::geometry::index;
 // Point 2D pour R-tree
 using Point2D = bg::model::point<double, 2, bg::cs::cartesian>;
 using Box = bg::model::box<Point2D>;
-using RTreeValue = std::pair<Point2D, int>; // (position, vehicleId)
+using RTreeValue = std::pair<Point2D, int>; // (position, index dense du véhicule)
 using RTree = bgi::rtree<RTreeValue, bgi::quadratic<16>>;
 
+class PropagationModel;
+class InterferenceField;
+class BuildingIndex;
+class SnapshotPublisher;
+class SnapshotHandle;
+
+/**
+ * @brief Apparition ou rupture d'un lien, produite par InterferenceGraph::update
+ */
+struct LinkEvent {
+    enum class Type {
+        Up,     // Lien formé depuis l'update précédent
+        Down    // Lien rompu (hors de portée ou véhicule retiré)
+    };
+    
+    Type type;
+    int vehicleId1;     // vehicleId1 < vehicleId2
+    int vehicleId2;
+    double timestamp;   // Temps de simulation de l'update (secondes)
+};
+
 /**
  * @brief Graphe d'interférences V2V (véhicule à véhicule)
- * 
+ *
  * Caractéristiques:
  * - Graphe dynamique (change à chaque frame)
  * - Deux véhicules sont connectés si leurs zones de transmission se chevauchent
  * - Utilise un R-tree pour recherche spatiale efficace O(log n)
- * - Update incrémental pour éviter reconstruction complète
+ * - Stockage compact: indices denses + adjacence CSR (Compressed Sparse Row)
+ *   reconstruite à chaque update, voisins triés par ID
+ * - Découverte des voisins parallélisée avec TBB (résultat identique au serial)
+ * - Qualification des liens par blocs via LinkKernel (AVX2 / scalaire),
+ *   instancié par politiques (métrique, rayon uniforme ou par véhicule,
+ *   affinage par ombrage / bâtiments) choisies une fois par update
+ * - Deux modes d'énumération: voisinage complet (R-tree, chaque lien vu des
+ *   deux côtés) ou demi-paires (grille uniforme, demi-coquille, chaque lien
+ *   testé une seule fois)
+ * - Flux d'événements de liens (Up/Down) par diff des lignes triées entre
+ *   deux updates, et nombre de liens tenu à jour à partir de ce delta
+ * - Modèle de propagation optionnel (PropagationModel): sans modèle, test de
+ *   disque; avec un modèle à ombrage, lien tiré avec la probabilité du modèle
+ * - Mode SINR: liens à portée filtrés par le rapport signal / (bruit +
+ *   interférence de tous les émetteurs simultanés), interférence lointaine
+ *   agrégée hiérarchiquement (InterferenceField)
+ * - Obstruction par les bâtiments (BuildingIndex): chaque lien candidat est
+ *   testé en visibilité directe, résultat mis en cache par paire de cellules
+ *   de position quantifiées
+ * - R-tree découpé par classes de rayon (optionnel): la requête d'un véhicule
+ *   ne va dans chaque classe que jusqu'à min(rayon propre, rayon max de la classe)
+ * - Listes de Verlet optionnelles: candidats à rayon + skin conservés d'un
+ *   update à l'autre, seule la distance exacte est retestée tant qu'aucun
+ *   véhicule n'a bougé de plus de skin / 2
+ * - Version immuable publiée à chaque update (GraphSnapshot) pour les
+ *   lecteurs d'autres threads (rendu, statistiques), sans verrou
+ * - Mode paresseux (optionnel): sans abonné, l'update ne fait que l'index
+ *   spatial et la ligne d'un véhicule est calculée au premier accès puis
+ *   mémorisée jusqu'à l'update suivant
  */
 class InterferenceGraph {
 public:
+    /**
+     * @brief Stratégie d'énumération des paires candidates
+     */
+    enum class EnumerationMode {
+        FullNeighbour,  // Requête R-tree par véhicule, paire testée depuis chaque extrémité
+        HalfPair        // Grille + demi-coquille: seules les paires i < j sont testées
+    };
+    
+    /**
+     * @brief Abonné au flux d'événements: reçoit le delta complet de chaque update
+     */
+    using LinkEventListener = std::function<void(std::span<const LinkEvent>)>;
+    
     InterferenceGraph();
-    ~InterferenceGraph() = default;
-
+    ~InterferenceGraph();
+    
     /**
      * @brief Update complet du graphe (appelé chaque frame ou tous les N frames)
      * @param vehicles Liste des véhicules actifs
+     * @param simulationTime Temps de simulation, horodatage des événements de liens
      */
-    void update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles);
+    void update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles,
+                double simulationTime = 0.0);
     
     /**
      * @brief Update incrémental - seulement les véhicules qui ont bougé
@@ -51,9 +122,26 @@ public:
     /**
      * @brief Obtenir les voisins d'un véhicule (dans rayon de transmission)
      * @param vehicleId ID du véhicule
-     * @return IDs des véhicules connectés
+     * @return IDs des véhicules connectés, triés (vue sur le buffer interne,
+     *         valide jusqu'au prochain update/clear)
+     *
+     * Update paresseux: ligne calculée au premier appel (même résultat qu'un
+     * update complet), appelable depuis plusieurs threads.
+     */
+    std::span<const int> getNeighbors(int vehicleId) const;
+    
+    /**
+     * @brief Update paresseux: calcule d'avance (en parallèle) les lignes des
+     *        véhicules situés dans region, p. ex. la zone affichée
+     * @return Nombre de lignes calculées (0 après un update complet)
      */
-    std::vector<int> getNeighbors(int vehicleId) const;
+    size_t materializeRegion(const Box& region) const;
+    
+    /**
+     * @brief Position (x = lon, y = lat) d'un véhicule au dernier update
+     * @return false si le véhicule n'est pas dans le graphe
+     */
+    bool getPosition(int vehicleId, Point2D& position) const;
     
     /**
      * @brief Vérifie si deux véhicules sont connectés
@@ -67,49 +155,539 @@ public:
     std::vector<std::pair<int, int>> getAllConnections() const;
     
     /**
-     * @brief Statistiques
+     * @brief Statistiques (nombre de liens et degré moyen: au dernier update
+     *        complet)
      */
-    size_t getConnectionCount() const { return m_connections.size(); }
-    size_t getVehicleCount() const { return m_vehiclePositions.size(); }
+    size_t getConnectionCount() const { return m_linkCount; }
+    size_t getVehicleCount() const { return m_vehicleIds.size(); }
+    std::span<const int> getVehicleIds() const { return m_vehicleIds; }
     double getAverageConnections() const;
     
     /**
-     * @brief Clear
+     * @brief Active/désactive la découverte parallèle des voisins (TBB)
+     *
+     * Le graphe obtenu est identique dans les deux modes: chaque ligne est
+     * calculée indépendamment puis triée.
+     */
+    void setParallelDiscovery(bool enabled) { m_parallelDiscovery = enabled; }
+    bool isParallelDiscovery() const { return m_parallelDiscovery; }
+    
+    /**
+     * @brief Mode paresseux: un update n'est complet (adjacence, événements
+     *        de liens, version publiée avec liens) que si au moins un abonné
+     *        le demande (subscribe) ou en mode SINR
+     *
+     * Sinon seuls les positions et l'index spatial sont mis à jour: lignes
+     * calculées à la demande (getNeighbors, materializeRegion), aucun
+     * événement; le delta de l'update complet suivant couvre tout
+     * l'intervalle depuis le précédent update complet.
+     */
+    void setLazy(bool lazy) { m_lazy = lazy; }
+    bool isLazy() const { return m_lazy; }
+    
+    /**
+     * @brief Adjacence complète au dernier update (toujours hors mode paresseux)
+     */
+    bool isComplete() const { return m_complete; }
+    
+    /**
+     * @brief Lignes calculées à la demande depuis le dernier update
+     */
+    size_t getLazyRowCount() const;
+    
+    /**
+     * @brief Choix du mode d'énumération (même graphe dans les deux modes)
+     */
+    void setEnumerationMode(EnumerationMode mode) { m_enumerationMode = mode; }
+    EnumerationMode getEnumerationMode() const { return m_enumerationMode; }
+    
+    /**
+     * @brief Métrique du test de portée
+     *
+     * Chord (défaut): exactement le test de Haversine. Planar: projection
+     * locale, une coordonnée de moins par candidat mais approchée (voir
+     * LinkFrame): quelques liens en limite de portée peuvent différer.
+     * Invalide les listes de Verlet.
+     */
+    void setLinkMetric(LinkMetric metric);
+    LinkMetric getLinkMetric() const { return m_frame.metric(); }
+    
+    /**
+     * @brief Politique de rayon du noyau (défaut: PerVehicle)
+     *
+     * Uniform: instanciation à seuil constant (ni lecture du rayon du
+     * candidat ni min), à choisir quand le scénario n'a qu'un profil de
+     * rayon. Vérifiée à chaque update: si les rayons de recherche diffèrent
+     * (ombrage à budgets différents, rayon modifié), l'update utilise le
+     * noyau PerVehicle. Même graphe avec les deux politiques.
+     */
+    void setRadiusPolicy(LinkRadius policy) { m_radiusPolicy = policy; }
+    LinkRadius getRadiusPolicy() const { return m_radiusPolicy; }
+    
+    /**
+     * @brief Politique effectivement appliquée au dernier update
+     */
+    LinkRadius getActiveRadiusPolicy() const { return m_activeRadiusPolicy; }
+    
+    /**
+     * @brief Index spatial découpé par classes de rayon (modes FullNeighbour
+     *        et Verlet)
+     *
+     * Un lien exige d <= min(r1, r2). Les véhicules sont répartis en classes
+     * de rayon, une par rayon distinct (profils voiture / camion / RSU,
+     * jusqu'à MAX_RADIUS_CLASSES; au-delà, rayons continus: une seule
+     * classe). Un véhicule de classe k cherche avec son propre rayon parmi les classes >= k (un R-tree par suffixe de classes), et dans
+     * chaque classe inférieure seulement jusqu'au rayon max de celle-ci.
+     * La classe la plus basse fait une seule requête, comme sans découpage.
+     * Même graphe, environ un tiers de candidats en moins pour un profil
+     * 80/15/5 % à 200/400/500 m, mais une requête d'arbre de plus par classe
+     * inférieure: désactivé par défaut, utile quand l'évaluation d'un lien
+     * coûte plus que le parcours (modèle de propagation, ombrage).
+     */
+    void setRadiusClasses(bool enabled) { m_radiusClasses = enabled; }
+    bool isRadiusClasses() const { return m_radiusClasses; }
+    size_t getRadiusClassCount() const { return m_radiusClassMax.size(); }
+    
+    static constexpr size_t MAX_RADIUS_CLASSES = 4;
+    
+    /**
+     * @brief Listes de Verlet: épaisseur de peau (mètres), 0 = désactivées
+     *
+     * Les candidats de chaque véhicule sont cherchés dans le R-tree avec le rayon
+     * augmenté de skin, puis réutilisés: chaque update ne refait que le test
+     * de distance exacte. Les listes sont reconstruites dès qu'un véhicule
+     * s'est déplacé de plus de skin / 2 depuis la construction, que son rayon
+     * de recherche a augmenté ou qu'un véhicule est apparu (un véhicule retiré
+     * est simplement ôté des listes). Même graphe que sans listes; le mode
+     * d'énumération ne sert plus.
+     */
+    void setVerletSkin(double skinMeters);
+    double getVerletSkin() const { return m_verletSkin; }
+    
+    /**
+     * @brief Updates avec listes de Verlet, et reconstructions parmi eux
+     *        (depuis setVerletSkin ou clear)
+     */
+    uint64_t getVerletUpdateCount() const { return m_verletUpdates; }
+    uint64_t getVerletRebuildCount() const { return m_verletRebuilds; }
+    double getVerletRebuildRate() const {
+        return m_verletUpdates > 0 ? static_cast<double>(m_verletRebuilds) / m_verletUpdates : 0.0;
+    }
+    bool wasVerletRebuilt() const { return m_verletRebuilt; }
+    
+    /**
+     * @brief Modèle de propagation appliqué aux liens (nullptr: test de disque)
+     *
+     * Le rayon de transmission de chaque véhicule fixe sa puissance d'émission
+     * (puissance reçue moyenne = sensibilité au rayon nominal). Un lien est
+     * limité par le plus faible des deux budgets; avec ombrage il existe avec
+     * la probabilité Phi(marge / sigma), tirée une fois par paire (ombrage
+     * figé, symétrique, identique en serial et en parallèle).
+     */
+    void setPropagationModel(std::shared_ptr<const PropagationModel> model);
+    const std::shared_ptr<const PropagationModel>& getPropagationModel() const { return m_propagation; }
+    
+    /**
+     * @brief Bâtiments obstruant les liens (nullptr: propagation en espace dégagé)
+     *
+     * Chaque lien candidat est testé entre les centres des cellules de
+     * LOS_CELL_METERS qui contiennent ses extrémités; le nombre de murs
+     * traversés est mis en cache par paire de cellules (symétrique, conservé
+     * d'un update à l'autre: les véhicules changent rarement de cellule).
+     * Le résultat ne dépend que de la paire de cellules: graphe identique
+     * quel que soit l'état du cache, en serial comme en parallèle.
+     * L'interférence du mode SINR ignore les bâtiments.
+     */
+    void setBuildingIndex(std::shared_ptr<const BuildingIndex> buildings);
+    const std::shared_ptr<const BuildingIndex>& getBuildingIndex() const { return m_buildings; }
+    
+    /**
+     * @brief Atténuation par mur traversé (dB), déduite de la marge du lien
+     *        (modèle de propagation requis); <= 0: tout lien obstrué est rejeté
+     */
+    void setWallLossDb(double lossDb);
+    double getWallLossDb() const { return m_wallLossDb; }
+    
+    /**
+     * @brief Tests de visibilité demandés / calculés (hors cache) au dernier update
+     */
+    uint64_t getLosQueries() const { return m_losQueries; }
+    uint64_t getLosTests() const { return m_losTests; }
+    
+    /**
+     * @brief Mode SINR: un lien à portée n'est gardé que si chaque extrémité
+     *        décode l'autre (SINR >= seuil dans les deux sens)
+     *
+     * Tous les véhicules sont des émetteurs simultanés (pondérés par le taux
+     * d'activité); puissances moyennes du modèle de propagation, modèle à
+     * deux rayons si aucun n'est défini.
+     */
+    void setSinrMode(bool enabled) { m_sinrMode = enabled; }
+    bool isSinrMode() const { return m_sinrMode; }
+    void setSinrThresholdDb(double thresholdDb) { m_sinrThresholdDb = thresholdDb; }
+    double getSinrThresholdDb() const { return m_sinrThresholdDb; }
+    void setNoiseFloorDbm(double noiseDbm) { m_noiseFloorDbm = noiseDbm; }
+    double getNoiseFloorDbm() const { return m_noiseFloorDbm; }
+    
+    /**
+     * @brief Fraction des véhicules qui émettent en même temps (1 = tous)
+     */
+    void setTransmitterActivity(double fraction);
+    double getTransmitterActivity() const { return m_transmitterActivity; }
+    
+    /**
+     * @brief Précision de l'agrégation lointaine (0 = somme exacte en O(n^2))
+     */
+    void setFarFieldOpeningAngle(double theta);
+    
+    /**
+     * @brief Interférence reçue (dBm, bruit exclu) au dernier update en mode
+     *        SINR; -infini si le véhicule est absent ou hors mode SINR
+     */
+    double getInterferenceDbm(int vehicleId) const;
+    
+    /**
+     * @brief SINR (dB) du signal de transmitterId reçu par receiverId, au
+     *        dernier update en mode SINR; -infini sinon
+     */
+    double getSinrDb(int transmitterId, int receiverId) const;
+    
+    /**
+     * @brief Termes de puissance sommés (exacts + agrégés) au dernier update
+     */
+    uint64_t getInterferenceTerms() const { return m_interferenceTerms; }
+    
+    /**
+     * @brief Nombre de tests de distance effectués au dernier update
+     */
+    uint64_t getDistanceEvaluations() const { return m_distanceEvaluations; }
+    
+    /**
+     * @brief Événements du dernier update (liens formés et rompus), groupés
+     *        par véhicule; vide si le graphe n'a pas changé
+     */
+    const std::vector<LinkEvent>& getLinkEvents() const { return m_linkEvents; }
+    
+    /**
+     * @brief Temps de simulation du dernier update (horodatage des événements)
+     */
+    double getUpdateTime() const { return m_lastUpdateTime; }
+    
+    /**
+     * @brief Dernière version publiée du graphe, lisible depuis n'importe quel
+     *        thread pendant les updates suivants (inclure GraphSnapshot.hpp)
+     *
+     * Copie de l'adjacence et des positions publiée à la fin de chaque update
+     * et de clear (SnapshotPublisher: échange atomique, récupération par
+     * époques). Les accesseurs directs du graphe restent réservés au thread
+     * qui appelle update.
+     */
+    SnapshotHandle acquireSnapshot() const;
+    uint64_t getSnapshotVersion() const;
+    
+    /**
+     * @brief Abonnement au flux d'événements de liens
+     *
+     * Le listener est appelé à la fin de chaque update (et de clear) qui
+     * produit au moins un événement, sur le thread appelant. Il peut
+     * abonner ou désabonner (lui compris) pendant l'appel.
+     * @return Identifiant à passer à unsubscribe
+     */
+    int subscribe(LinkEventListener listener);
+    void unsubscribe(int subscriptionId);
+    
+    /**
+     * @brief Clear (les liens encore actifs sont publiés comme rompus)
      */
     void clear();
 
 private:
-    // R-tree pour recherche spatiale efficace
-    std::unique_ptr<RTree> m_rtree;
+    // Classes de rayon (une seule, de rayon infini, si le découpage est
+    // désactivé): R-tree des classes >= k et R-tree de la seule classe k,
+    // rayon de recherche max de chaque classe, classe de chaque index dense
+    std::vector<RTree> m_radiusSuffixTrees;
+    std::vector<RTree> m_radiusClassTrees;
+    std::vector<double> m_radiusClassMax;
+    std::vector<uint8_t> m_radiusClassOf;
+    bool m_radiusClasses;
+    
+    // Index dense -> ID véhicule, et ID véhicule -> index dense (-1 si absent)
+    std::vector<int> m_vehicleIds;
+    std::vector<int> m_indexOfId;
+    
+    // Positions (x = lon, y = lat) et rayons de recherche, par index dense
+    // (rayon de transmission, ou portée maximale du modèle avec ombrage)
+    std::vector<Point2D> m_positions;
+    std::vector<double> m_transmissionRadii;
+    
+    // Modèle de propagation et budget de perte (dB) par index dense
+    std::shared_ptr<const PropagationModel> m_propagation;
+    std::vector<double> m_linkBudgets;
+    bool m_shadowing;
+    
+    // Bâtiments: cellule de position quantifiée par index dense, et cache des
+    // murs traversés par paire de cellules: table associative par groupes,
+    // partagée entre threads sans verrou (entrées 64 bits atomiques, mémoire
+    // fixe), âge des entrées compté en updates (m_losEpoch)
+    std::shared_ptr<const BuildingIndex> m_buildings;
+    std::vector<uint64_t> m_losCells;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_losCache;
+    uint8_t m_losEpoch;
+    bool m_obstruction;
+    double m_wallLossDb;
+    uint64_t m_losQueries;
+    uint64_t m_losTests;
+    
+    // Mode SINR: puissances d'émission et interférence reçue (mW) par index dense
+    std::unique_ptr<InterferenceField> m_interferenceField;
+    std::vector<double> m_txPowerMw;
+    std::vector<double> m_interferenceMw;
+    bool m_sinrMode;
+    double m_sinrThresholdDb;
+    double m_noiseFloorDbm;
+    double m_transmitterActivity;
+    uint64_t m_interferenceTerms;
+    
+    // Mêmes véhicules dans le repère métrique du noyau de qualification
+    LinkFrame m_frame;
+    LinkRadius m_radiusPolicy;
+    LinkRadius m_activeRadiusPolicy;
+    
+    // Adjacence CSR: les voisins de l'index i sont
+    // m_neighborIds[m_rowOffsets[i] .. m_rowOffsets[i + 1]) (IDs véhicules triés)
+    std::vector<size_t> m_rowOffsets;
+    std::vector<int> m_neighborIds;
+    
+    // Graphe de l'update précédent, conservé pour le diff (échangé avec le
+    // graphe courant: pas de copie ni de réallocation en régime établi)
+    std::vector<int> m_previousVehicleIds;
+    std::vector<int> m_previousIndexOfId;
+    std::vector<size_t> m_previousRowOffsets;
+    std::vector<int> m_previousNeighborIds;
+    
+    // Versions publiées pour les lecteurs concurrents
+    std::unique_ptr<SnapshotPublisher> m_snapshots;
+    
+    // Delta du dernier update et abonnés
+    std::vector<LinkEvent> m_linkEvents;
+    std::vector<std::pair<int, LinkEventListener>> m_listeners;
+    int m_nextSubscriptionId;
+    size_t m_linkCount;
+    double m_lastUpdateTime;
     
-    // Connexions actives: map[vehicleId] -> set<connectedVehicleIds>
-    std::unordered_map<int, std::unordered_set<int>> m_connections;
+    // Grille uniforme du mode HalfPair: véhicules triés par cellule
+    // (cellule = ligne * cols + colonne, taille en degrés dérivée de cellMeters)
+    struct CellGrid {
+        double minLat = 0.0;
+        double minLon = 0.0;
+        double cellLat = 0.0;
+        double cellLon = 0.0;
+        double cellMeters = 0.0;
+        int cols = 0;
+        int rows = 0;
+        std::vector<int> cellOf;        // index dense -> cellule
+        std::vector<size_t> cellStart;  // cellule -> début dans vehicles (taille cols * rows + 1)
+        std::vector<int> vehicles;      // indices denses, triés par (cellule, index)
+        LinkFrame frame;                // m_frame dans l'ordre de vehicles (cellules contiguës)
+    };
+    CellGrid m_grid;
     
-    // Positions des véhicules (cache)
-    std::unordered_map<int, Point2D> m_vehiclePositions;
+    // Buffers de découverte par thread (capacité conservée entre les updates)
+    struct DiscoveryBuffers {
+        std::vector<RTreeValue> candidates;
+        std::vector<int> candidateIndices;
+        std::vector<int> neighbors;
+        std::vector<std::pair<int, int>> edges; // Mode HalfPair: (i, j) en indices denses
+        uint64_t evaluations = 0;
+        uint64_t losQueries = 0;
+        uint64_t losTests = 0;
+    };
+    mutable tbb::enumerable_thread_specific<DiscoveryBuffers> m_threadBuffers;
+    bool m_parallelDiscovery;
+    EnumerationMode m_enumerationMode;
+    uint64_t m_distanceEvaluations;
     
-    // Rayon de transmission par véhicule
-    std::unordered_map<int, double> m_transmissionRadii;
+    // Listes de Verlet: candidats (indices denses) en CSR par index dense (ordre
+    // des véhicules = m_verletIds, ramené à l'ordre courant à chaque update),
+    // et repère figé à la construction (positions, rayons en corde + skin)
+    double m_verletSkin;
+    bool m_verletValid;
+    std::vector<int> m_verletIds;
+    std::vector<size_t> m_verletOffsets;
+    std::vector<int> m_verletCandidates;
+    LinkFrame m_verletFrame;
+    uint64_t m_verletUpdates;
+    uint64_t m_verletRebuilds;
+    bool m_verletRebuilt;
+    
+    // Mode paresseux: lignes calculées à la demande (par index dense), rangées
+    // dans des blocs jamais réalloués (les vues rendues restent valides
+    // jusqu'à l'update suivant), capacité conservée d'un update à l'autre.
+    // Ligne prête: drapeau atomique lu sans verrou; calcul hors verrou, le
+    // verrou ne protège que le rangement (double vérification)
+    bool m_lazy;
+    bool m_complete;
+    mutable std::mutex m_lazyMutex;
+    mutable std::vector<std::span<const int>> m_lazyRows;
+    std::unique_ptr<std::atomic<uint8_t>[]> m_lazyReady;
+    size_t m_lazyReadyCapacity;
+    mutable tbb::enumerable_thread_specific<DiscoveryBuffers> m_lazyBuffers;
+    mutable std::vector<std::vector<int>> m_lazyChunks;
+    mutable size_t m_lazyChunk;
+    mutable size_t m_lazyRowCount;
+    
+    /**
+     * @brief Index dense d'un véhicule, -1 si absent du graphe
+     */
+    int indexOf(int vehicleId) const;
+    
+    /**
+     * @brief Passe le graphe courant en graphe précédent (avant reconstruction)
+     */
+    void swapToPrevious();
+    
+    /**
+     * @brief Vide le graphe courant; le graphe précédent est conservé (update
+     *        paresseux: il reste le dernier graphe complet, base du diff)
+     */
+    void resetCurrent();
+    
+    /**
+     * @brief Update paresseux: ligne d'un index dense, calculée si besoin
+     */
+    std::span<const int> lazyRow(int index) const;
+    
+    /**
+     * @brief Range une ligne calculée et la marque prête (verrou tenu, ligne
+     *        pas encore prête)
+     */
+    void storeLazyRow(int index, std::span<const int> row) const;
+    
+    /**
+     * @brief Copie le graphe courant dans un tampon du publisher, indexe ses
+     *        positions pour les requêtes spatiales et le publie
+     */
+    void publishSnapshot();
+    
+    /**
+     * @brief Diff graphe précédent / courant -> m_linkEvents, m_linkCount,
+     *        puis notification des abonnés
+     */
+    void publishLinkEvents(double timestamp);
     
     /**
-     * @brief Reconstruire le R-tree à partir des positions actuelles
+     * @brief Reconstruire les R-trees (par classe de rayon) à partir des
+     *        positions actuelles
      */
     void rebuildRTree();
     
     /**
-     * @brief Trouver les voisins d'un véhicule dans le R-tree
+     * @brief Reconstruire la grille uniforme (mode HalfPair)
+     */
+    void rebuildGrid();
+    
+    /**
+     * @brief Mode FullNeighbour: découverte ligne par ligne (serial ou TBB)
+     */
+    void buildAdjacencyFull(bool parallel);
+    
+    /**
+     * @brief Mode HalfPair: liste d'arêtes i < j puis écriture des deux lignes
+     */
+    void buildAdjacencyHalfPair(bool parallel);
+    
+    /**
+     * @brief Listes de Verlet: validité / reconstruction, puis lignes comme en
+     *        FullNeighbour avec les listes pour candidats
+     */
+    void buildAdjacencyVerlet(bool parallel);
+    
+    /**
+     * @brief Listes de Verlet réutilisables telles quelles (après retrait des
+     *        véhicules disparus)? Sinon elles sont reconstruites
+     */
+    bool verletListsValid();
+    bool remapVerletLists();
+    void rebuildVerletLists(bool parallel);
+    
+    /**
+     * @brief Offsets CSR par somme préfixe des degrés, retourne le total
+     */
+    size_t computeRowOffsets(const std::vector<size_t>& degree, bool parallel);
+    static size_t prefixSum(const std::vector<size_t>& degree, std::vector<size_t>& offsets, bool parallel);
+    
+    /**
+     * @brief Appelle visitor avec la politique du noyau de l'update courant
+     *        (type portant metric, radius et refine)
+     */
+    template <typename Visitor>
+    void dispatchKernel(Visitor&& visitor) const;
+    
+    /**
+     * @brief Ajoute à out les IDs des voisins de l'index donné, triés
+     */
+    template <typename Policy>
+    void collectNeighbors(int index, DiscoveryBuffers& scratch, std::vector<int>& out) const;
+    
+    /**
+     * @brief Ajoute à scratch.edges les liens (index, j) de la demi-coquille
+     *        avant du véhicule m_grid.vehicles[position]
+     */
+    template <typename Policy>
+    void collectHalfPairs(size_t position, DiscoveryBuffers& scratch) const;
+    
+    /**
+     * @brief Teste m_grid.vehicles[position] contre m_grid.vehicles[begin .. end)
+     *        (candidats contigus de m_grid.frame) et ajoute les arêtes
+     */
+    template <typename Policy>
+    void qualifyGridSlice(size_t position, size_t begin, size_t end, DiscoveryBuffers& scratch) const;
+    
+    /**
+     * @brief Modèle à ombrage ou bâtiments: retire du masque du noyau les
+     *        liens non tirés ou obstrués
+     */
+    uint64_t refineBlock(int index, const int* block, uint64_t mask, DiscoveryBuffers& scratch) const;
+    
+    /**
+     * @brief Murs traversés entre deux index denses (cache par paire de cellules),
+     *        compte arrêté à wallLimit
+     */
+    int wallCrossings(int index1, int index2, int wallLimit, DiscoveryBuffers& scratch) const;
+    std::atomic<uint64_t>* losBucket(uint64_t cell1, uint64_t cell2) const;
+    void clearLosCache();
+    
+    /**
+     * @brief Modèle des liens: celui défini, sinon deux rayons en mode SINR, sinon nullptr
+     */
+    const PropagationModel* linkModel() const;
+    
+    /**
+     * @brief Distance (mètres) entre deux index denses, par la corde du repère métrique
+     */
+    double frameDistance(int index1, int index2) const;
+    
+    /**
+     * @brief Mode SINR: interférence par récepteur puis retrait des liens
+     *        non décodables dans les deux sens (compaction du CSR)
      */
-    std::vector<int> queryNeighbors(int vehicleId, double radius) const;
+    void applySinrFilter(bool parallel);
     
     /**
-     * @brief Calculer distance entre deux véhicules (en degrés)
+     * @brief SINR linéaire du signal de l'index transmitter reçu par l'index receiver
      */
-    double distance(int vehicleId1, int vehicleId2) const;
+    double linkSinr(int transmitter, int receiver, double noiseMw) const;
     
     /**
-     * @brief Calculer distance en mètres entre deux véhicules (Haversine)
+     * @brief Candidats (indices denses) dans la boîte englobant le rayon
+     *        min(radiusMeters, rayon max de la classe) + slackMeters, par classe
+     * @param radiusMeters Rayon de recherche en mètres (celui du véhicule:
+     *        seules les classes inférieures à la sienne sont bornées)
+     * @param slackMeters Marge ajoutée après la limite de classe (skin de Verlet)
+     * @param results Buffer de sortie réutilisé (vidé avant la requête)
      */
-    double distanceInMeters(int vehicleId1, int vehicleId2) const;
+    void queryCandidates(int index, double radiusMeters, double slackMeters,
+                         std::vector<RTreeValue>& results) const;
 };
 
 } // namespace network
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+class InterferenceGraph;
+
+/**
+ * @brief Histogramme en flux à classes logarithmiques (mémoire fixe)
+ *
+ * binsPerDecade classes par décade entre minValue et maxValue, plus une
+ * classe sous minValue (zéro compris) et une au-delà de maxValue. Effectif,
+ * moyenne, minimum et maximum exacts; quantiles interpolés dans la classe
+ * (erreur relative bornée par la largeur d'une classe: ~6 % à 40 par décade).
+ */
+class LogHistogram {
+public:
+    LogHistogram(double minValue, double maxValue, int binsPerDecade);
+    
+    void add(double value, uint64_t count = 1);
+    void merge(const LogHistogram& other);  // Mêmes bornes et résolution
+    void clear();
+    
+    uint64_t count() const { return m_count; }
+    double mean() const { return m_count > 0 ? m_sum / m_count : 0.0; }
+    double min() const { return m_count > 0 ? m_min : 0.0; }
+    double max() const { return m_count > 0 ? m_max : 0.0; }
+    
+    /**
+     * @brief Quantile q dans [0, 1] (0 si vide)
+     */
+    double quantile(double q) const;
+    
+    /**
+     * @brief Classes: 0 = sous minValue, binCount() - 1 = au-delà de maxValue
+     */
+    size_t binCount() const { return m_bins.size(); }
+    uint64_t binValue(size_t bin) const { return m_bins[bin]; }
+    double binLower(size_t bin) const;
+    double binUpper(size_t bin) const;
+
+private:
+    double m_minValue;
+    double m_logMin;
+    double m_binsPerDecade;
+    std::vector<uint64_t> m_bins;
+    uint64_t m_count;
+    double m_sum;
+    double m_min;
+    double m_max;
+};
+
+/**
+ * @brief Statistiques de contacts V2V en flux: durée des liens, temps
+ *        inter-contacts et nombre de contacts par véhicule
+ *
+ * Consomme le delta de liens produit par InterferenceGraph::update:
+ * - Lien formé: heure de début rangée dans une table de hachage compacte
+ *   (adressage ouvert, clé = paire d'IDs sur 64 bits), temps inter-contacts
+ *   mesuré si la paire s'était déjà séparée
+ * - Lien rompu: durée = fin - début, la paire passe dans la table des
+ *   séparations (heure de fin)
+ *
+ * Mémoire bornée quelle que soit la durée de la simulation: durées dans des
+ * histogrammes logarithmiques fixes, table des liens ouverts proportionnelle
+ * au graphe courant, table des séparations de capacité fixe (associative par
+ * groupes, la séparation la plus ancienne du groupe est oubliée: le temps
+ * inter-contacts de cette paire n'est alors pas mesuré, compté à part).
+ * Les liens présents avant le premier update ne sont pas mesurés (début
+ * inconnu), de même que ceux présents à la reprise après resync().
+ */
+class LinkStatistics {
+public:
+    LinkStatistics();
+    ~LinkStatistics() = default;
+    
+    /**
+     * @brief Applique le dernier delta du graphe (à appeler après chaque update)
+     */
+    void update(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Fin de run: l'âge des liens encore ouverts va dans
+     *        getOpenLinkAges() (durées censurées, bornes inférieures)
+     */
+    void finish(double simulationTime);
+    
+    /**
+     * @brief Reprise après des updates non appliqués (enregistrement
+     *        interrompu): liens ouverts et séparations oubliés, leurs débuts
+     *        et fins n'étant plus sûrs; histogrammes et contacts conservés
+     */
+    void resync();
+    
+    const LogHistogram& getLinkDurations() const { return m_linkDurations; }
+    const LogHistogram& getInterContactTimes() const { return m_interContactTimes; }
+    const LogHistogram& getOpenLinkAges() const { return m_openLinkAges; }
+    
+    /**
+     * @brief Distribution du nombre de contacts (liens formés) par véhicule,
+     *        sur les véhicules vus depuis clear()
+     */
+    LogHistogram getContactsPerVehicle() const;
+    uint32_t getContactCount(int vehicleId) const;
+    
+    uint64_t getLinkUpCount() const { return m_linkUps; }
+    uint64_t getLinkDownCount() const { return m_linkDowns; }
+    size_t getOpenLinkCount() const { return m_openCount; }
+    uint64_t getForgottenSeparations() const { return m_forgottenSeparations; }
+    
+    /**
+     * @brief Nombre de séparations mémorisées au plus (arrondi aux puissances
+     *        de 2; vide la table)
+     */
+    void setSeparationCapacity(size_t pairs);
+    
+    /**
+     * @brief Mémoire occupée par les tables et histogrammes (octets)
+     */
+    size_t getMemoryBytes() const;
+    
+    /**
+     * @brief Résumé (quantiles) dans le journal
+     */
+    void logSummary() const;
+    
+    /**
+     * @brief Écrit le résumé et les histogrammes en CSV
+     *        (metric,bin_lower,bin_upper,count après les lignes de résumé)
+     * @return false si le fichier ne peut pas être ouvert
+     */
+    bool writeReport(const std::string& filename) const;
+    
+    void clear();
+
+private:
+    // Liens ouverts: adressage ouvert à sondage linéaire, clé 0 = vide
+    // (id1 < id2 donc la clé d'une paire n'est jamais nulle)
+    std::vector<uint64_t> m_openKeys;
+    std::vector<double> m_openStart;
+    size_t m_openCount;
+    
+    // Séparations: groupes de SEPARATION_WAYS entrées (clé, heure de fin)
+    std::vector<uint64_t> m_separationKeys;
+    std::vector<double> m_separationEnd;
+    uint64_t m_forgottenSeparations;
+    
+    // Contacts par ID véhicule, et véhicules déjà vus
+    std::vector<uint32_t> m_contacts;
+    std::vector<uint8_t> m_seen;
+    
+    LogHistogram m_linkDurations;
+    LogHistogram m_interContactTimes;
+    LogHistogram m_openLinkAges;
+    uint64_t m_linkUps;
+    uint64_t m_linkDowns;
+    
+    void countContact(int vehicleId);
+    
+    void insertOpen(uint64_t key, double start);
+    bool takeOpen(uint64_t key, double& start);
+    void growOpen();
+    
+    void insertSeparation(uint64_t key, double end);
+    bool takeSeparation(uint64_t key, double& end);
+};
+
+} // namespace network
+} // namespace v2v
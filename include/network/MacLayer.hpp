@@ -0,0 +1,193 @@
+#pragma once
+
+#include "InterferenceGraph.hpp"
+#include <queue>
+#include <vector>
+#include <cstdint>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Couche MAC CSMA/CA type 802.11p pour le beaconing périodique
+ *
+ * Simulation à événements discrets au niveau paquet sur les voisinages
+ * d'InterferenceGraph (voisin = à portée de détection et de réception):
+ * - Chaque véhicule émet un beacon toutes les beaconInterval secondes (phase
+ *   tirée par véhicule); un beacon non émis est remplacé par le suivant
+ * - Accès au canal EDCA: émission immédiate si le canal est libre depuis
+ *   AIFS, sinon tirage d'un backoff dans [0, CW], décompté par slots de canal
+ *   libre après AIFS et gelé quand le canal redevient occupé (broadcast: pas
+ *   d'acquittement ni de retransmission)
+ * - Chaque véhicule tient la chronologie de son canal: nombre d'émissions en
+ *   cours dans son voisinage (la sienne comprise), début de la période libre,
+ *   temps occupé cumulé
+ * - Réception: le récepteur se verrouille sur la première trame reçue canal
+ *   libre; toute trame qui la chevauche (collision) ou une émission propre
+ *   (semi-duplex) la perd
+ *
+ * Sorties par véhicule: taux de livraison (PDR, réceptions réussies / voisins
+ * visés par ses émissions) et taux d'occupation du canal (CBR).
+ * Tirages pseudo-aléatoires par (véhicule, compteur): résultat reproductible.
+ */
+class MacLayer {
+public:
+    struct Parameters {
+        double beaconInterval = 0.1;        // 10 Hz
+        double frameDuration = 436e-6;      // 300 octets à 6 Mbit/s + préambule
+        double slotTime = 13e-6;            // 802.11p (10 MHz)
+        double sifs = 32e-6;
+        int aifsn = 2;                      // AC_VO
+        int contentionWindow = 3;           // CWmin AC_VO
+    };
+    
+    /**
+     * @brief Compteurs d'un véhicule depuis son apparition (ou resetStatistics)
+     */
+    struct VehicleStats {
+        uint64_t generated = 0;             // Beacons produits
+        uint64_t transmitted = 0;           // Beacons émis
+        uint64_t dropped = 0;               // Remplacés avant d'avoir accédé au canal
+        uint64_t intendedReceptions = 0;    // Voisins visés par ses émissions
+        uint64_t deliveredReceptions = 0;   // Dont reçus sans collision
+        uint64_t received = 0;              // Beacons reçus par ce véhicule
+        double busyTime = 0.0;              // Canal occupé (secondes)
+        double observedTime = 0.0;          // Durée d'observation (secondes)
+        
+        double packetDeliveryRatio() const {
+            return intendedReceptions > 0 ? static_cast<double>(deliveredReceptions) / intendedReceptions : 0.0;
+        }
+        
+        double channelBusyRatio() const {
+            return observedTime > 0.0 ? busyTime / observedTime : 0.0;
+        }
+    };
+    
+    /**
+     * @brief Moyennes sur les véhicules présents
+     */
+    struct Summary {
+        size_t vehicles = 0;
+        double packetDeliveryRatio = 0.0;   // Toutes émissions confondues
+        double channelBusyRatio = 0.0;      // Moyenne des CBR par véhicule
+        double maxChannelBusyRatio = 0.0;
+        uint64_t transmissions = 0;
+        uint64_t dropped = 0;
+        uint64_t lostReceptions = 0;        // Chevauchement ou récepteur en émission
+    };
+    
+    MacLayer();
+    ~MacLayer() = default;
+    
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const { return m_parameters; }
+    
+    /**
+     * @brief advance() ne fait rien tant que la couche MAC est désactivée;
+     *        désactiver abandonne l'état (clear)
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    
+    /**
+     * @brief Joue les événements jusqu'à simulationTime sur les voisinages
+     *        du graphe courant; les véhicules apparus commencent à émettre
+     */
+    void advance(const InterferenceGraph& graph, double simulationTime);
+    
+    /**
+     * @brief Statistiques d'un véhicule, temps d'occupation arrêtés au dernier advance
+     * @return false si l'ID n'a jamais été vu
+     */
+    bool getVehicleStats(int vehicleId, VehicleStats& stats) const;
+    double getPacketDeliveryRatio(int vehicleId) const;
+    double getChannelBusyRatio(int vehicleId) const;
+    Summary getSummary() const;
+    
+    /**
+     * @brief Événements traités depuis clear()
+     */
+    uint64_t getProcessedEvents() const { return m_processedEvents; }
+    
+    /**
+     * @brief Remet les compteurs à zéro sans toucher aux émissions en cours
+     */
+    void resetStatistics();
+    
+    /**
+     * @brief Abandonne tous les événements et états (temps remis à zéro)
+     */
+    void clear();
+
+private:
+    enum class EventKind : uint8_t {
+        TxEnd,      // Fin d'émission (traitée avant un début au même instant)
+        Attempt,    // Fin d'AIFS + backoff: accès au canal
+        Beacon      // Production d'un beacon
+    };
+    
+    struct Event {
+        double time;
+        int vehicleId;
+        EventKind kind;
+        uint32_t stamp;     // Attempt: périmé si différent de VehicleState::attemptStamp
+        
+        // Ordre total (temps, type, véhicule): indépendant de l'ordre
+        // d'insertion; à un même instant, toutes les fins d'émission passent
+        // avant les accès au canal, quel que soit le véhicule
+        bool operator>(const Event& other) const {
+            if (time != other.time) return time > other.time;
+            if (kind != other.kind) return kind > other.kind;
+            return vehicleId > other.vehicleId;
+        }
+    };
+    
+    struct VehicleState {
+        bool present = false;       // Beacons programmés
+        bool pending = false;       // Beacon en attente d'accès au canal
+        bool transmitting = false;
+        int backoff = -1;           // Slots restants, -1 = pas de contention en cours
+        uint32_t attemptStamp = 0;
+        
+        // Chronologie du canal vue par ce véhicule
+        int activeTransmissions = 0;
+        double idleSince = 0.0;
+        double busySince = 0.0;
+        double observedSince = 0.0;
+        
+        // Réception en cours
+        int rxFrom = -1;
+        bool rxOk = false;
+        
+        uint64_t draws = 0;
+        std::vector<int> receivers; // Voisins figés au début de l'émission en cours
+        VehicleStats stats;
+    };
+    
+    Parameters m_parameters;
+    double m_aifs;
+    bool m_enabled;
+    double m_now;
+    uint64_t m_processedEvents;
+    
+    std::vector<VehicleState> m_states;     // Par ID véhicule
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> m_events;
+    
+    double draw(VehicleState& state, int vehicleId);
+    
+    void onBeacon(const InterferenceGraph& graph, int vehicleId, double time);
+    void onAttempt(const InterferenceGraph& graph, int vehicleId, double time, uint32_t stamp);
+    void onTxEnd(int vehicleId, double time);
+    
+    void startTransmission(const InterferenceGraph& graph, int vehicleId, double time);
+    void scheduleAttempt(VehicleState& state, int vehicleId, double time);
+    
+    /**
+     * @brief Début / fin d'une émission dans le voisinage (transitions libre <-> occupé)
+     */
+    void channelBusy(int vehicleId, double time);
+    void channelReleased(int vehicleId, double time);
+};
+
+} // namespace network
+} // namespace v2v
@@ -8,7 +8,10 @@ namespace v2v {
 namespace network {
 
 /**
- * @brief Planificateur de chemin utilisant A* ou Dijkstra
+ * @brief Planificateur de chemin: A* sur le graphe routier figé (RoadNetwork)
+ *
+ * Tableaux de travail par thread: findPath et generateRandomPath peuvent
+ * tourner en parallèle sur le même graphe.
  */
 class PathPlanner {
 public:
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Modèle de propagation radio (perte de trajet + ombrage)
+ *
+ * Trois modèles classiques:
+ * - Espace libre (Friis)
+ * - Deux rayons (sol): espace libre jusqu'à la distance de croisement, puis d^4
+ * - Log-distance avec ombrage log-normal (écart-type sigma en dB)
+ *
+ * Les pertes sont précalculées dans une table indexée par la distance
+ * (interpolation linéaire), et la probabilité de lien dans une table indexée
+ * par la marge en dB: évaluer un lien coûte deux lectures de table.
+ *
+ * Le rayon de transmission d'un véhicule reste le réglage de puissance: la
+ * puissance d'émission est calibrée pour que la puissance reçue moyenne au
+ * rayon nominal soit égale à la sensibilité du récepteur. Sans ombrage le
+ * graphe est donc identique au test de disque; avec ombrage, un lien à la
+ * distance d existe avec la probabilité Phi(marge / sigma).
+ */
+class PropagationModel {
+public:
+    enum class Type {
+        FreeSpace,
+        TwoRayGround,
+        LogDistanceShadowing
+    };
+    
+    struct Parameters {
+        double frequencyHz = 5.9e9;         // ITS-G5 / 802.11p
+        double txAntennaHeight = 1.5;       // Mètres (toit de voiture)
+        double rxAntennaHeight = 1.5;
+        double referenceDistance = 1.0;    // d0 du modèle log-distance (mètres)
+        double pathLossExponent = 2.7;      // Urbain / périurbain
+        double shadowingSigmaDb = 4.0;      // Ignoré hors LogDistanceShadowing
+        double sensitivityDbm = -85.0;      // 802.11p, 6 Mbit/s
+    };
+    
+    // Probabilité en dessous de laquelle un lien est considéré impossible
+    // (borne la portée de recherche des candidats)
+    static constexpr double LINK_PROBABILITY_EPSILON = 0.01;
+    
+    explicit PropagationModel(Type type);
+    PropagationModel(Type type, const Parameters& parameters);
+    
+    Type getType() const { return m_type; }
+    const Parameters& getParameters() const { return m_parameters; }
+    static const char* typeName(Type type);
+    
+    /**
+     * @brief Sans ombrage: lien certain sous la portée nominale, impossible au-delà
+     */
+    bool isDeterministic() const { return m_sigmaDb <= 0.0; }
+    
+    /**
+     * @brief Perte de trajet moyenne (dB), formule analytique
+     */
+    double pathLossDbExact(double distanceMeters) const;
+    
+    /**
+     * @brief Perte de trajet moyenne (dB) lue dans la table
+     */
+    double pathLossDb(double distanceMeters) const {
+        if (distanceMeters >= m_tableMaxDistance) {
+            return pathLossDbExact(distanceMeters);
+        }
+        return interpolate(m_pathLossTable, m_farPathLossTable, distanceMeters);
+    }
+    
+    /**
+     * @brief Gain de trajet linéaire 10^(-perte / 10), lu dans la table
+     *        (sommes de puissances en mW sans exponentielle)
+     */
+    double pathGain(double distanceMeters) const {
+        if (distanceMeters >= m_tableMaxDistance) {
+            return std::pow(10.0, -pathLossDbExact(distanceMeters) / 10.0);
+        }
+        return interpolate(m_pathGainTable, m_farPathGainTable, distanceMeters);
+    }
+    
+    /**
+     * @brief Probabilité de lien pour une marge moyenne (dB) au-dessus de la sensibilité
+     */
+    double linkProbability(double marginDb) const {
+        if (isDeterministic()) {
+            return marginDb >= 0.0 ? 1.0 : 0.0;
+        }
+        const double position = (marginDb - m_minMarginDb) * m_inverseMarginStep;
+        if (position <= 0.0) return 0.0;
+        if (position >= m_probabilityTable.size() - 1) return 1.0;
+        return m_probabilityTable[static_cast<size_t>(position + 0.5)];
+    }
+    
+    /**
+     * @brief Puissance d'émission (dBm) calibrée sur une portée nominale
+     */
+    double txPowerForRange(double nominalRangeMeters) const;
+    
+    /**
+     * @brief Puissance reçue moyenne (dBm)
+     */
+    double receivedPowerDbm(double txPowerDbm, double distanceMeters) const {
+        return txPowerDbm - pathLossDb(distanceMeters);
+    }
+    
+    /**
+     * @brief Distance au-delà de laquelle la probabilité de lien passe sous
+     *        LINK_PROBABILITY_EPSILON, pour un budget de perte donné (dB)
+     */
+    double maxRange(double pathLossBudgetDb) const;
+
+private:
+    Type m_type;
+    Parameters m_parameters;
+    double m_sigmaDb;
+    double m_wavelength;
+    
+    // Perte de trajet (dB) et gain linéaire: table fine (TABLE_RESOLUTION
+    // mètres) jusqu'à TABLE_MAX_DISTANCE, puis table grossière pour le champ
+    // lointain (interférence agrégée), formule au-delà de m_tableMaxDistance
+    std::vector<float> m_pathLossTable;
+    std::vector<float> m_pathGainTable;
+    std::vector<float> m_farPathLossTable;
+    std::vector<float> m_farPathGainTable;
+    double m_inverseResolution;
+    double m_lastIndex;
+    double m_nearMaxDistance;
+    double m_inverseFarResolution;
+    double m_tableMaxDistance;
+    
+    double interpolate(const std::vector<float>& nearTable, const std::vector<float>& farTable,
+                       double distanceMeters) const {
+        double position = distanceMeters * m_inverseResolution;
+        const std::vector<float>* table = &nearTable;
+        if (position >= m_lastIndex) {
+            position = (distanceMeters - m_nearMaxDistance) * m_inverseFarResolution;
+            table = &farTable;
+        }
+        const size_t bin = static_cast<size_t>(position);
+        const double t = position - bin;
+        return (*table)[bin] + t * ((*table)[bin + 1] - (*table)[bin]);
+    }
+    
+    // Phi(marge / sigma) échantillonnée sur [-6 sigma, +6 sigma]
+    std::vector<float> m_probabilityTable;
+    double m_minMarginDb;
+    double m_inverseMarginStep;
+};
+
+} // namespace network
+} // namespace v2v
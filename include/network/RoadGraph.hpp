@@ -1,8 +1,12 @@
 #pragma once
 
+#include "RoadNetwork.hpp"
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <QPointF>
+#include <string>
 #include <vector>
 #include <memory>
 #include <cmath>
@@ -15,17 +19,16 @@ namespace v2v {
 namespace network {
 
 /**
- * @brief Structure représentant un nœud routier
+ * @brief Structure représentant un nœud routier (graphe de construction)
  */
 struct RoadNode {
     int id;
     double latitude;
     double longitude;
-    QPointF position;
 };
 
 /**
- * @brief Structure représentant une arête (segment de route)
+ * @brief Structure représentant une arête (segment de route, graphe de construction)
  */
 struct RoadEdge {
     double length;        // Mètres
@@ -46,33 +49,86 @@ using RoadGraphType = boost::adjacency_list<
 using VertexDescriptor = boost::graph_traits<RoadGraphType>::vertex_descriptor;
 using EdgeDescriptor = boost::graph_traits<RoadGraphType>::edge_descriptor;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
 /**
  * @brief Graphe routier pour navigation des véhicules
  * 
- * Construit à partir de données OSM
- * Utilise Boost.Graph pour les algorithmes (Dijkstra, A*)
+ * Construit à partir de données OSM dans un graphe Boost (ajouts de nœuds
+ * et d'arêtes), puis figé par finalize() en RoadNetwork (CSR compact) sur
+ * lequel tournent A* (PathPlanner) et le rendu; le graphe Boost est alors
+ * libéré.
+ *
+ * Index spatial des nœuds: R-tree compacté (packing STR) sur les coordonnées
+ * cartésiennes 3D des nœuds sur la sphère terrestre. La corde croît avec la
+ * distance de Haversine: plus proches voisins exacts, en O(log V), sans
+ * coupure aux méridiens. Les requêtes (const) ne modifient rien: sûres
+ * depuis plusieurs threads après finalize (génération parallèle de routes).
  */
 class RoadGraph {
 public:
+    /**
+     * @brief Mémoire du graphe Boost de construction (estimée: vecteurs,
+     *        nœuds de la liste d'arêtes et chaînes, hors surcoût de
+     *        l'allocateur) et du RoadNetwork qui le remplace
+     */
+    struct MemoryReport {
+        size_t nodes = 0;
+        size_t edges = 0;
+        size_t names = 0;               // Noms de rue distincts
+        size_t adjacencyListBytes = 0;
+        size_t compactBytes = 0;
+    };
+    
     RoadGraph();
     ~RoadGraph() = default;
 
     // Construction du graphe
     void clear();
     
-    // Ajout de nœuds/arêtes
+    // Ajout de nœuds/arêtes (avant finalize, ou après clear)
     VertexDescriptor addNode(double lat, double lon);
     void addEdge(VertexDescriptor from, VertexDescriptor to, 
-                 double length, double speedLimit, const std::string& roadType);
+                 double length, double speedLimit, const std::string& roadType,
+                 const std::string& name = std::string());
+    
+    /**
+     * @brief Fin du chargement: construit le RoadNetwork et l'index spatial,
+     *        libère le graphe Boost et journalise le rapport mémoire
+     */
+    void finalize();
     
     // Requêtes
+    
+    /**
+     * @brief Nœud le plus proche
+     * @return nullVertex() si l'index est vide ou la position non finie
+     */
     VertexDescriptor getNearestNode(double lat, double lon) const;
     
+    /**
+     * @brief Aucun nœud (jamais un index de nœud valide)
+     */
+    static VertexDescriptor nullVertex() { return boost::graph_traits<RoadGraphType>::null_vertex(); }
+    
+    /**
+     * @brief Les k nœuds les plus proches, par distance croissante (out vidé)
+     */
+    void getNearestNodes(double lat, double lon, size_t k,
+                         std::vector<VertexDescriptor>& out) const;
+    
     // Statistiques
     size_t getNodeCount() const;
     size_t getEdgeCount() const;
+    const MemoryReport& getMemoryReport() const { return m_memoryReport; }
     
-    // Accès au graphe
+    /**
+     * @brief Graphe figé (vide avant finalize)
+     */
+    const RoadNetwork& getNetwork() const { return m_network; }
+    
+    // Accès au graphe de construction (vide après finalize)
     const RoadGraphType& getGraph() const { return m_graph; }
     RoadGraphType& getGraph() { return m_graph; }
     
@@ -81,15 +137,16 @@ public:
     
 private:
     RoadGraphType m_graph;
+    RoadNetwork m_network;
+    MemoryReport m_memoryReport;
     
-    // Spatial index pour recherche rapide
-    struct SpatialNode {
-        VertexDescriptor vertex;
-        double lat, lon;
-    };
-    std::vector<SpatialNode> m_spatialIndex;
+    // Spatial index pour recherche rapide (position 3D en mètres, nœud)
+    using NodePoint = bg::model::point<double, 3, bg::cs::cartesian>;
+    using NodeRTreeValue = std::pair<NodePoint, RoadNetwork::NodeId>;
+    using NodeRTree = bgi::rtree<NodeRTreeValue, bgi::quadratic<16>>;
+    NodeRTree m_spatialIndex;
     
-    double calculateDistance(double lat1, double lon1, double lat2, double lon2) const;
+    static NodePoint toPoint(double lat, double lon);
 };
 
 } // namespace network
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QPointF>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+/**
+ * @brief Classe de route OSM (tag highway), sur 8 bits
+ */
+enum class RoadClass : uint8_t {
+    Motorway,
+    Trunk,
+    Primary,
+    Secondary,
+    Tertiary,
+    Unclassified,
+    Residential,
+    Service,
+    Link,           // Bretelles (*_link)
+    Other
+};
+
+constexpr int ROAD_CLASS_COUNT = 10;
+
+/**
+ * @brief Classe d'un tag highway ("primary", "motorway_link"...), Other si inconnu
+ */
+RoadClass roadClassFromTag(std::string_view tag);
+const char* roadClassName(RoadClass roadClass);
+
+/**
+ * @brief Graphe routier figé en CSR (compressed sparse row), construit une
+ *        fois après le chargement par RoadGraph::finalize
+ *
+ * - Nœuds: index 0..n-1 (mêmes numéros que les VertexDescriptor du graphe de
+ *   construction), latitudes et longitudes en tableaux séparés
+ * - Arêtes sortantes de node: [outBegin(node), outEnd(node)), cibles sur 32
+ *   bits, longueurs et vitesses en float, classe de route sur 8 bits, nom
+ *   interné (index dans une table de noms distincts, 0: sans nom)
+ * - Arêtes entrantes (CSR inverse): [inBegin(node), inEnd(node)), source et
+ *   arête directe de chaque entrée
+ *
+ * Immuable après construction: lectures sans verrou depuis plusieurs threads.
+ */
+class RoadNetwork {
+public:
+    using NodeId = uint32_t;
+    using EdgeId = uint32_t;
+    
+    RoadNetwork();
+    
+    size_t getNodeCount() const { return m_latitudes.size(); }
+    size_t getEdgeCount() const { return m_targets.size(); }
+    bool empty() const { return m_latitudes.empty(); }
+    
+    double getLatitude(NodeId node) const { return m_latitudes[node]; }
+    double getLongitude(NodeId node) const { return m_longitudes[node]; }
+    
+    /**
+     * @brief Position (x = lon, y = lat), comme les chemins des véhicules
+     */
+    QPointF getPosition(NodeId node) const { return QPointF(m_longitudes[node], m_latitudes[node]); }
+    
+    EdgeId outBegin(NodeId node) const { return m_outOffsets[node]; }
+    EdgeId outEnd(NodeId node) const { return m_outOffsets[node + 1]; }
+    NodeId getTarget(EdgeId edge) const { return m_targets[edge]; }
+    float getLength(EdgeId edge) const { return m_lengths[edge]; }
+    float getSpeedLimit(EdgeId edge) const { return m_speedLimits[edge]; }
+    RoadClass getRoadClass(EdgeId edge) const { return m_roadClasses[edge]; }
+    const std::string& getName(EdgeId edge) const { return m_names[m_nameIds[edge]]; }
+    
+    uint32_t inBegin(NodeId node) const { return m_inOffsets[node]; }
+    uint32_t inEnd(NodeId node) const { return m_inOffsets[node + 1]; }
+    NodeId getInSource(uint32_t entry) const { return m_inSources[entry]; }
+    EdgeId getInEdge(uint32_t entry) const { return m_inEdges[entry]; }
+    
+    /**
+     * @brief Noms distincts (le nom vide compris)
+     */
+    size_t getNameCount() const { return m_names.size(); }
+    
+    /**
+     * @brief Octets occupés (capacités des tableaux et noms internés)
+     */
+    size_t getMemoryBytes() const;
+    
+    void clear();
+
+private:
+    friend class RoadGraph;
+    
+    std::vector<double> m_latitudes;
+    std::vector<double> m_longitudes;
+    
+    // CSR direct
+    std::vector<uint32_t> m_outOffsets;
+    std::vector<uint32_t> m_targets;
+    std::vector<float> m_lengths;
+    std::vector<float> m_speedLimits;
+    std::vector<RoadClass> m_roadClasses;
+    std::vector<uint32_t> m_nameIds;
+    
+    // CSR inverse
+    std::vector<uint32_t> m_inOffsets;
+    std::vector<uint32_t> m_inSources;
+    std::vector<uint32_t> m_inEdges;
+    
+    std::vector<std::string> m_names;
+};
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "LinkKernel.hpp"
+#include "LinkStatistics.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+
+namespace core {
+    class Vehicle;
+}
+
+namespace network {
+
+class ComponentTracker;
+
+/**
+ * @brief Unités de bord de route (RSU): nœuds fixes de l'infrastructure et
+ *        association V2I des véhicules
+ *
+ * - RSU chargées d'un fichier texte (id, lat, lon, rayon, backhaul) ou
+ *   ajoutées une à une, puis build()
+ * - Couverture précalculée une fois sur une grille uniforme (cellSize mètres)
+ *   englobant les disques: chaque cellule porte la liste des RSU qui la
+ *   touchent, marquées "pleine" si la cellule entière est dans le disque
+ *   (ses 4 coins y sont: disque et cellule convexes), en CSR; la plupart des
+ *   cellules ont de plus leur RSU décidée d'avance (une RSU pleine dont toute
+ *   autre est plus loin, en tout point, d'au moins l'hystérésis)
+ * - Association à chaque update par lecture de la cellule du véhicule, sans
+ *   requête spatiale: cellule vide -> hors couverture, cellule décidée ->
+ *   servi sans calcul de distance, sinon distance exacte aux seules RSU de
+ *   la cellule (corde 3D: même test "d <= r" que Haversine et les liens V2V)
+ * - Politique: RSU couvrante la plus proche; la RSU servante est conservée
+ *   tant qu'elle couvre le véhicule et qu'aucune autre n'est plus proche de
+ *   plus de hysteresis mètres (handover)
+ *
+ * Statistiques: taux de couverture (pondéré par le temps), couverture par
+ * une RSU reliée au backhaul, véhicules atteignant le backhaul en multi-saut
+ * V2V (cluster contenant un véhicule servi), handovers et ping-pongs (retour
+ * à la RSU précédente en moins de pingPongWindow secondes), durée de service
+ * continu par une même RSU, charge par RSU.
+ */
+class RoadsideUnits {
+public:
+    struct Unit {
+        int id = 0;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        double radius = 500.0;      // Mètres
+        bool backhaul = false;      // Reliée au réseau fixe
+        bool defaultRadius = false; // Rayon par défaut (ligne sans rayon): suit setDefaultRadius
+    };
+    
+    struct Parameters {
+        double cellSize = 25.0;         // Côté d'une cellule de couverture (mètres)
+        double hysteresis = 20.0;       // Avance requise pour un handover (mètres)
+        double pingPongWindow = 5.0;    // Retour à la RSU précédente compté ping-pong (s)
+    };
+    
+    /**
+     * @brief Compteurs d'une RSU depuis resetStatistics
+     */
+    struct UnitStats {
+        size_t attached = 0;            // Véhicules servis actuellement
+        size_t peakAttached = 0;
+        uint64_t attachments = 0;       // Prises en charge (entrée en couverture ou handover)
+        uint64_t handoversIn = 0;
+        uint64_t handoversOut = 0;
+        double servedTime = 0.0;        // Véhicules x secondes servis
+    };
+    
+    /**
+     * @brief État courant et cumuls depuis resetStatistics
+     */
+    struct Summary {
+        size_t units = 0;
+        size_t backhaulUnits = 0;
+        size_t vehicles = 0;
+        size_t covered = 0;             // Servis par une RSU
+        size_t backhaulCovered = 0;     // Servis par une RSU reliée au backhaul
+        size_t relayReachable = 0;      // Backhaul atteint en multi-saut V2V (servis compris)
+        double coverageRatio = 0.0;     // Part du temps véhicule passée couverte
+        double backhaulCoverageRatio = 0.0;
+        uint64_t attachments = 0;       // Entrées en couverture
+        uint64_t detachments = 0;       // Sorties de couverture
+        uint64_t handovers = 0;
+        uint64_t pingPongs = 0;
+        double handoverRate = 0.0;      // Handovers par heure de service
+        double meanServiceTime = 0.0;   // Durée moyenne de service continu (s)
+    };
+    
+    RoadsideUnits();
+    ~RoadsideUnits();
+    
+    /**
+     * @brief Lit les RSU d'un fichier CSV (lignes "id,lat,lon[,rayon[,backhaul]]",
+     *        en-tête et lignes # ignorés) et construit la couverture
+     * @param defaultRadius Rayon des lignes sans rayon (mètres)
+     * @return false si le fichier ne peut pas être lu ou ne contient aucune RSU
+     *         valide (RSU précédentes conservées); sinon elles sont remplacées
+     */
+    bool loadFile(const std::string& filename, double defaultRadius = 500.0);
+    
+    /**
+     * @brief Nouveau rayon des RSU au rayon par défaut, grille reconstruite si
+     *        l'une d'elles change (associations et compteurs oubliés, comme build)
+     * @return Nombre de RSU au rayon par défaut
+     */
+    size_t setDefaultRadius(double radius);
+    
+    /**
+     * @brief Ajoute une RSU (ID déjà présent: remplacée); effective au build()
+     */
+    void addUnit(const Unit& unit);
+    
+    /**
+     * @brief Précalcule la grille de couverture (oublie les associations;
+     *        refait par setParameters si cellSize ou hysteresis change)
+     */
+    void build();
+    
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const { return m_parameters; }
+    
+    /**
+     * @brief Associe les véhicules actifs à leur RSU à simulationTime et cumule
+     *        les durées depuis l'update précédent
+     * @param clusters Clusters V2V courants pour la portée multi-saut (optionnel)
+     */
+    void update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles,
+                double simulationTime, const ComponentTracker* clusters = nullptr);
+    
+    /**
+     * @brief RSU servant le véhicule (ID RSU, -1: hors couverture ou inconnu)
+     */
+    int getServingUnit(int vehicleId) const;
+    
+    /**
+     * @brief RSU qui servirait un véhicule en (lat, lon) sans RSU courante
+     *        (plus proche couvrante, -1 si aucune)
+     */
+    int findServingUnit(double latitude, double longitude) const;
+    
+    const std::vector<Unit>& getUnits() const { return m_units; }
+    const std::vector<UnitStats>& getUnitStats() const { return m_unitStats; }
+    bool empty() const { return m_units.empty(); }
+    
+    Summary getSummary() const;
+    
+    /**
+     * @brief Durées de service continu par une même RSU (terminées par un
+     *        handover ou une sortie de couverture)
+     */
+    const LogHistogram& getServiceTimes() const { return m_serviceTimes; }
+    
+    /**
+     * @brief Grille de couverture: cellules, cellules touchées par au moins
+     *        une RSU, cellules entièrement couvertes, cellules à RSU décidée
+     *        d'avance, entrées (RSU, cellule)
+     */
+    size_t getCellCount() const { return m_cellUnit.size(); }
+    size_t getCoveredCellCount() const { return m_coveredCells; }
+    size_t getFullCellCount() const { return m_fullCells; }
+    size_t getDecidedCellCount() const { return m_decidedCells; }
+    size_t getCoverageEntryCount() const { return m_coverage.size(); }
+    
+    void logSummary() const;
+    
+    /**
+     * @brief Écrit le résumé puis une ligne par RSU en CSV
+     * @return false si le fichier ne peut pas être ouvert
+     */
+    bool writeReport(const std::string& filename) const;
+    
+    /**
+     * @brief Oublie associations et compteurs (RSU et grille conservées)
+     */
+    void resetStatistics();
+    
+    /**
+     * @brief Retire toutes les RSU
+     */
+    void clear();
+
+private:
+    struct VehicleState {
+        int serving = -1;           // Index de RSU
+        int previous = -1;          // RSU quittée au dernier handover
+        double servingSince = 0.0;
+        double handoverTime = 0.0;
+        uint32_t seenEpoch = 0;     // Dernier update où il était actif
+    };
+    
+    // Entrée de couverture: index de RSU, bit de poids fort = cellule pleine
+    static constexpr uint32_t FULL_CELL = 0x80000000u;
+    
+    // RSU d'une cellule hors RSU décidée: aucune, à départager par distance
+    static constexpr int NO_UNIT = -1;
+    static constexpr int MIXED_CELL = -2;
+    
+    Parameters m_parameters;
+    std::vector<Unit> m_units;
+    std::vector<UnitStats> m_unitStats;
+    LinkFrame m_frame;                  // Positions des RSU (corde 3D), rayons en corde
+    
+    // Grille: cellule (lon, lat) -> RSU, ligne par ligne
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_coverage;
+    std::vector<int> m_cellUnit;        // RSU décidée, NO_UNIT ou MIXED_CELL
+    double m_minLon;
+    double m_minLat;
+    double m_cellLon;                   // Degrés
+    double m_cellLat;
+    int m_cols;
+    int m_rows;
+    size_t m_coveredCells;
+    size_t m_fullCells;
+    size_t m_decidedCells;
+    
+    // Associations (par ID véhicule) et cumuls
+    std::vector<VehicleState> m_states;
+    std::vector<int> m_present;         // IDs actifs au dernier update
+    std::vector<int> m_seen;            // IDs actifs à l'update en cours
+    std::vector<uint32_t> m_clusterMarks;
+    uint32_t m_epoch;
+    double m_lastTime;
+    bool m_hasTime;
+    size_t m_covered;
+    size_t m_backhaulCovered;
+    size_t m_relayReachable;
+    double m_vehicleTime;
+    double m_coveredTime;
+    double m_backhaulTime;
+    uint64_t m_attachments;
+    uint64_t m_detachments;
+    uint64_t m_handovers;
+    uint64_t m_pingPongs;
+    LogHistogram m_serviceTimes;
+    
+    /**
+     * @brief RSU choisie en (lat, lon) en partant de la RSU servante current
+     *        (-1: aucune), hystérésis comprise
+     */
+    int associate(double latitude, double longitude, int current) const;
+    
+    void detach(VehicleState& state, double time);
+    void countCoverage(int unit, int delta);
+};
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace v2v {
+namespace network {
+
+class InterferenceGraph;
+
+/**
+ * @brief Historique de la connectivité V2V pour l'analyse après la simulation
+ *
+ * Alimenté par InterferenceGraph::update (un appel à update par update du
+ * graphe): le temps est discrétisé en updates (frise des horodatages), et
+ * chaque lien est codé par plages (run-length): [update de formation, update
+ * de rupture). La présence des véhicules est codée de la même façon.
+ *
+ * finish() construit l'index des requêtes: plages triées par véhicule, par
+ * (voisin, début), chaque lien rangé chez ses deux extrémités. Requêtes en
+ * O(log) pour un lien à un instant, en O(degré cumulé) pour un véhicule.
+ * Un instant t désigne l'état au dernier update d'horodatage <= t.
+ *
+ * Format disque compact (save / load): frise, table d'index (ID véhicule ->
+ * offset), puis par véhicule ses plages de présence et les plages de ses liens
+ * vers des IDs supérieurs (chaque lien stocké une fois), en entiers variables
+ * (LEB128) codés par écarts. Entiers et flottants dans l'ordre d'octets de la
+ * machine.
+ */
+class TemporalGraphStore {
+public:
+    /**
+     * @brief Plage d'updates [start, end)
+     */
+    struct Run {
+        uint32_t start;
+        uint32_t end;
+    };
+    
+    TemporalGraphStore();
+    ~TemporalGraphStore() = default;
+    
+    /**
+     * @brief Enregistre le dernier update du graphe (horodatages croissants);
+     *        le premier appel part des liens existants. Au-delà de la limite
+     *        mémoire, l'historique s'arrête au dernier update enregistré
+     *        (updates suivants ignorés et comptés)
+     */
+    void update(const InterferenceGraph& graph);
+    
+    /**
+     * @brief Reprise après des updates non enregistrés (enregistrement
+     *        interrompu): le prochain update repart des liens existants,
+     *        comme le premier; les liens rompus entre-temps sont clos au
+     *        dernier update enregistré
+     */
+    void resync() { m_resync = true; }
+    
+    /**
+     * @brief Mémoire d'enregistrement au plus (octets, 0 = sans limite;
+     *        256 Mo par défaut)
+     */
+    void setMemoryLimit(size_t bytes) { m_memoryLimit = bytes; }
+    size_t getMemoryLimit() const { return m_memoryLimit; }
+    bool isTruncated() const { return m_droppedUpdates > 0; }
+    uint64_t getDroppedUpdateCount() const { return m_droppedUpdates; }
+    
+    /**
+     * @brief Construit l'index des requêtes (liens et présences encore
+     *        ouverts inclus jusqu'au dernier update); l'enregistrement peut
+     *        continuer, l'index est alors à reconstruire
+     */
+    void finish();
+    
+    /**
+     * @brief Requêtes sur l'index du dernier finish() ou load()
+     */
+    bool isConnected(int vehicleId1, int vehicleId2, double time) const;
+    bool isPresent(int vehicleId, double time) const;
+    std::vector<int> getNeighborsAt(int vehicleId, double time) const;
+    size_t getDegreeAt(int vehicleId, double time) const;
+    
+    /**
+     * @brief Voisins distincts rencontrés pendant [time0, time1] (triés)
+     */
+    std::vector<int> getNeighborsDuring(int vehicleId, double time0, double time1) const;
+    
+    /**
+     * @brief Degré au cours de [time0, time1]: (instant, degré) au début de
+     *        l'intervalle puis à chaque update où il change
+     */
+    std::vector<std::pair<double, size_t>> getDegreeSeries(int vehicleId, double time0, double time1) const;
+    
+    /**
+     * @brief Plages d'updates du lien (vides s'il n'a jamais existé)
+     */
+    std::vector<Run> getLinkRuns(int vehicleId1, int vehicleId2) const;
+    
+    /**
+     * @brief Instantané: véhicules présents et liens (id1 < id2) à l'instant donné
+     */
+    std::vector<int> getVehiclesAt(double time) const;
+    std::vector<std::pair<int, int>> getConnectionsAt(double time) const;
+    
+    /**
+     * @brief Exports de l'instantané à l'instant donné
+     * @return false si le fichier ne peut pas être écrit
+     */
+    bool exportCsv(const std::string& filename, double time) const;
+    bool exportGraphML(const std::string& filename, double time) const;
+    
+    /**
+     * @brief Sauvegarde de l'index dans le format compact / rechargement
+     *        (remplace le contenu; requêtes seulement après load)
+     */
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+    
+    /**
+     * @brief Statistiques
+     */
+    size_t getUpdateCount() const { return m_timeline.size(); }
+    double getUpdateTime(size_t update) const { return m_timeline[update]; }
+    size_t getVehicleCount() const { return m_vehicleIds.size(); }
+    size_t getLinkRunCount() const { return m_links.size() / 2; }
+    size_t getMemoryBytes() const;
+    
+    void clear();
+
+private:
+    // Plage fermée pendant l'enregistrement (lien: id1 < id2; présence: id2 = -1)
+    struct Record {
+        int id1;
+        int id2;
+        uint32_t start;
+        uint32_t end;
+    };
+    
+    // Plage d'un lien dans l'index, rangée chez chacune des deux extrémités
+    struct LinkEntry {
+        int neighbor;
+        Run run;
+    };
+    
+    static constexpr uint32_t ABSENT = UINT32_MAX;
+    
+    // Enregistrement: frise, plages fermées, liens ouverts (paire -> début),
+    // présence ouverte (début et dernier update vu, par ID)
+    std::vector<double> m_timeline;
+    std::vector<Record> m_closedLinks;
+    std::vector<Record> m_closedPresence;
+    std::unordered_map<uint64_t, uint32_t> m_openLinks;
+    std::vector<uint32_t> m_presenceStart;
+    std::vector<uint32_t> m_lastSeen;
+    bool m_resync;
+    size_t m_memoryLimit;
+    uint64_t m_droppedUpdates;
+    
+    // Index: véhicules triés par ID, présence et liens en CSR par véhicule
+    // (liens triés par (voisin, début))
+    std::vector<int> m_vehicleIds;
+    std::vector<int> m_indexOfId;
+    std::vector<size_t> m_presenceOffsets;
+    std::vector<Run> m_presenceRuns;
+    std::vector<size_t> m_linkOffsets;
+    std::vector<LinkEntry> m_links;
+    
+    void openLink(int vehicleId1, int vehicleId2, uint32_t update);
+    void closePresence(int vehicleId);
+    
+    /**
+     * @brief Index dense d'un véhicule dans l'index, -1 si inconnu
+     */
+    int indexOf(int vehicleId) const;
+    
+    /**
+     * @brief Update en vigueur à l'instant donné, -1 avant le premier
+     */
+    int64_t updateAt(double time) const;
+    
+    void buildIndex(const std::vector<Record>& links, const std::vector<Record>& presence);
+    
+    /**
+     * @brief Appelle visit(id1, id2, plage) pour chaque lien (id1 < id2) actif à l'update donné
+     */
+    template <typename Visitor>
+    void forEachLinkAt(int64_t update, Visitor&& visit) const;
+};
+
+} // namespace network
+} // namespace v2v
@@ -7,6 +7,7 @@
 #include <QPushButton>
 #include <QSlider>
 #include <QSpinBox>
+#include <QComboBox>
 #include <memory>
 
 namespace v2v {
@@ -46,12 +47,15 @@ private slots:
     void onTimeScaleChanged(int value);
     void onVehicleCountChanged(int value);
     void onTransmissionRadiusChanged(int value);
+    void onRadiusClassChanged(int index);
     
     // Updates
     void updateControls();
     
     // Fichiers
     void onLoadOSMFile();
+    void onLoadRoadsideUnits();
+    void onSelectReportDirectory();
 
 private:
     void createUI();
@@ -73,11 +77,18 @@ private:
     QSlider* m_timeScaleSlider;
     QLabel* m_timeScaleLabel;
     QSpinBox* m_vehicleCountSpinBox;
+    QComboBox* m_radiusClassComboBox;
     QSpinBox* m_transmissionRadiusSpinBox;
     
     // Status bar widgets
     QLabel* m_statusVehicles;
     QLabel* m_statusConnections;
+    QLabel* m_statusClusters;
+    QLabel* m_statusMac;
+    QLabel* m_statusBeacons;
+    QLabel* m_statusRsu;
+    QLabel* m_statusChannels;
+    QLabel* m_statusTopology;
     QLabel* m_statusSimTime;
     
     // State
@@ -14,6 +14,7 @@ Vehicle::Vehicle(int id, QObject* parent)
     , m_speed(0.0)
     , m_direction(0.0)
     , m_transmissionRadius(300)
+    , m_vehicleClass(VehicleClass::Car)
     , m_isActive(true)
     , m_currentPathIndex(0)
 {
@@ -45,6 +46,15 @@ void Vehicle::setTransmissionRadius(int radius) {
     m_transmissionRadius = std::clamp(radius, 100, 500);
 }
 
+const char* Vehicle::className(VehicleClass vehicleClass) {
+    switch (vehicleClass) {
+        case VehicleClass::Car: return "car";
+        case VehicleClass::Truck: return "truck";
+        case VehicleClass::RoadsideUnit: return "RSU";
+        default: return "?";
+    }
+}
+
 void Vehicle::setActive(bool active) {
     m_isActive = active;
 }
@@ -1,5 +1,6 @@
 #include "data/OSMParser.hpp"
 #include "network/RoadGraph.hpp"
+#include "network/BuildingIndex.hpp"
 #include "utils/Logger.hpp"
 #include <fstream>
 #include <sstream>
@@ -23,11 +24,15 @@ OSMParser::OSMParser() : m_impl(std::make_unique<Impl>()) {
 
 OSMParser::~OSMParser() = default;
 
-bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGraph) {
+bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGraph,
+                         network::BuildingIndex* buildings) {
     LOG_INFO(QString("Parsing OSM file: %1").arg(QString::fromStdString(filename)));
     
     // Effacer le graphe existant
     roadGraph->clear();
+    if (buildings) {
+        buildings->clear();
+    }
     
     // Si pas de fichier spécifié, générer données de test
     if (filename.empty()) {
@@ -51,7 +56,10 @@ bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGr
     
     qint64 currentWayId = 0;
     QString currentWayType;
+    std::string currentWayName;
+    bool currentWayIsBuilding = false;
     std::vector<qint64> currentWayNodes;
+    std::vector<network::Point2D> footprint;
     
     while (!xml.atEnd()) {
         xml.readNext();
@@ -66,6 +74,8 @@ bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGr
             } else if (xml.name() == QString("way")) {
                 currentWayId = xml.attributes().value("id").toLongLong();
                 currentWayType.clear();
+                currentWayName.clear();
+                currentWayIsBuilding = false;
                 currentWayNodes.clear();
                 
             } else if (xml.name() == QString("nd") && currentWayId != 0) {
@@ -78,6 +88,10 @@ bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGr
                 
                 if (key == "highway") {
                     currentWayType = value;
+                } else if (key == "name") {
+                    currentWayName = value.toStdString();
+                } else if (key == "building" && value != "no") {
+                    currentWayIsBuilding = true;
                 }
             }
             
@@ -121,14 +135,28 @@ bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGr
                                 
                                 // Créer des arêtes BIDIRECTIONNELLES (aller et retour)
                                 roadGraph->addEdge(nodeMap[prevNodeId], nodeMap[nodeId], 
-                                                 length, speed, currentWayType.toStdString());
+                                                 length, speed, currentWayType.toStdString(), currentWayName);
                                 roadGraph->addEdge(nodeMap[nodeId], nodeMap[prevNodeId], 
-                                                 length, speed, currentWayType.toStdString());
+                                                 length, speed, currentWayType.toStdString(), currentWayName);
                             }
                         }
                     }
                 }
                 
+                // Bâtiment: emprise = chemin fermé (les multipolygones ne sont pas lus)
+                if (buildings && currentWayIsBuilding && currentWayNodes.size() >= 4 &&
+                    currentWayNodes.front() == currentWayNodes.back()) {
+                    footprint.clear();
+                    for (qint64 nodeId : currentWayNodes) {
+                        auto it = osmNodes.find(nodeId);
+                        if (it == osmNodes.end()) break;
+                        footprint.emplace_back(it->second.second, it->second.first); // (lon, lat)
+                    }
+                    if (footprint.size() == currentWayNodes.size()) {
+                        buildings->addFootprint(footprint);
+                    }
+                }
+                
                 currentWayId = 0;
             }
         }
@@ -150,7 +178,10 @@ bool OSMParser::loadFile(const std::string& filename, network::RoadGraph* roadGr
     }
     
     LOG_INFO(QString("OSM file parsed successfully: %1 nodes, %2 edges").arg(nodeCount).arg(edgeCount));
-    roadGraph->buildSpatialIndex();
+    roadGraph->finalize();
+    if (buildings) {
+        buildings->build();
+    }
     return true;
 }
 
@@ -221,8 +252,8 @@ bool OSMParser::generateTestGraph(network::RoadGraph* roadGraph) {
                  .arg(roadGraph->getNodeCount())
                  .arg(roadGraph->getEdgeCount()));
         
-        // Construire l'index spatial
-        roadGraph->buildSpatialIndex();
+        // Figer le graphe (CSR) et construire l'index spatial
+        roadGraph->finalize();
         
         LOG_INFO("Test road graph built successfully (Mulhouse area)");
         return true;
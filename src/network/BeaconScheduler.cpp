@@ -0,0 +1,351 @@
+#include "network/BeaconScheduler.hpp"
+#include <limits>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Tirage uniforme dans [0, 1) déterministe par (véhicule, compteur) (SplitMix64)
+double uniformDraw(int vehicleId, uint64_t counter) {
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(vehicleId)) << 32) ^ counter;
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<double>(z >> 11) * 0x1.0p-53;
+}
+
+// DCC réactif (ETSI TS 102 687, trames d'environ 400 µs): seuils de CBR
+// d'entrée dans Active1..Restrictive et intervalle minimal (Toff) par état
+constexpr double DCC_CBR_THRESHOLDS[] = {0.30, 0.40, 0.50, 0.65};
+constexpr double DCC_MIN_INTERVALS[] = {0.06, 0.10, 0.18, 0.26, 1.0};
+}
+
+BeaconScheduler::BeaconScheduler()
+    : m_enabled(false)
+    , m_now(0.0)
+    , m_tick(0)
+    , m_scheduled(0)
+    , m_processedBeacons(0)
+    , m_syncedUpdateTime(std::numeric_limits<double>::quiet_NaN())
+    , m_syncEpoch(0)
+{
+    m_wheel[0].resize(size_t(1) << LEVEL0_BITS);
+    for (int level = 1; level < WHEEL_LEVELS; ++level) {
+        m_wheel[level].resize(size_t(1) << LEVEL_BITS);
+    }
+    setParameters(Parameters());
+}
+
+void BeaconScheduler::setParameters(const Parameters& parameters) {
+    // La résolution ne change pas sous des échéances déjà rangées
+    const double tickDuration = m_scheduled > 0 ? m_parameters.tickDuration : std::max(parameters.tickDuration, 1e-6);
+    m_parameters = parameters;
+    m_parameters.tickDuration = tickDuration;
+    m_parameters.minInterval = std::max(parameters.minInterval, tickDuration);
+    m_parameters.maxInterval = std::max(parameters.maxInterval, m_parameters.minInterval);
+    m_parameters.jitter = std::max(parameters.jitter, 0.0);
+    m_parameters.frameDuration = std::max(parameters.frameDuration, 1e-6);
+    m_parameters.cbrWindow = std::max(parameters.cbrWindow, 0.0);
+}
+
+void BeaconScheduler::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+double BeaconScheduler::draw(VehicleState& state, int vehicleId) {
+    return uniformDraw(vehicleId, state.draws++);
+}
+
+uint64_t BeaconScheduler::tickOf(double time) const {
+    return static_cast<uint64_t>(std::max(time, 0.0) / m_parameters.tickDuration);
+}
+
+void BeaconScheduler::advance(const InterferenceGraph& graph, double simulationTime) {
+    if (!m_enabled) return;
+    
+    // Roue vide: l'horloge rejoint la simulation (pas de rattrapage des
+    // beacons depuis l'activation)
+    if (m_scheduled == 0) {
+        m_now = simulationTime;
+        m_tick = tickOf(simulationTime);
+    }
+    
+    if (graph.getUpdateTime() != m_syncedUpdateTime) {
+        synchronize(graph);
+    }
+    
+    // Ticks entièrement écoulés; un tick vide ne coûte que le test de cascade
+    const uint64_t target = tickOf(simulationTime);
+    const uint64_t level0Mask = (uint64_t(1) << LEVEL0_BITS) - 1;
+    while (m_tick < target && m_scheduled > 0) {
+        if ((m_tick & level0Mask) == 0) {
+            // Début d'un tour du niveau 0: les niveaux supérieurs dont le
+            // créneau courant commence ici redescendent, du plus haut au plus bas
+            int top = 1;
+            while (top + 1 < WHEEL_LEVELS &&
+                   ((m_tick >> (LEVEL0_BITS + (top - 1) * LEVEL_BITS)) & ((uint64_t(1) << LEVEL_BITS) - 1)) == 0) {
+                ++top;
+            }
+            for (int level = top; level >= 1; --level) {
+                cascade(level);
+            }
+        }
+        
+        // Tick consommé avant les émissions: les échéances suivantes tombent
+        // au plus tôt au tick d'après, jamais dans le créneau en cours de traitement
+        auto& slot = m_wheel[0][m_tick & level0Mask];
+        ++m_tick;
+        if (!slot.empty()) {
+            m_firing.swap(slot);
+            m_scheduled -= m_firing.size();
+            for (const WheelEntry& entry : m_firing) {
+                fire(graph, entry);
+            }
+            m_firing.clear();
+        }
+    }
+    
+    if (m_scheduled == 0) {
+        m_tick = std::max(m_tick, target);
+    }
+    m_now = std::max(m_now, simulationTime);
+}
+
+void BeaconScheduler::synchronize(const InterferenceGraph& graph) {
+    m_syncedUpdateTime = graph.getUpdateTime();
+    ++m_syncEpoch;
+    
+    // Véhicules apparus: premier beacon à une phase propre dans l'intervalle
+    for (int id : graph.getVehicleIds()) {
+        if (static_cast<size_t>(id) >= m_states.size()) {
+            m_states.resize(id + 1);
+            m_received.resize(id + 1, 0);
+        }
+        VehicleState& state = m_states[id];
+        state.seenEpoch = m_syncEpoch;
+        if (state.present) continue;
+        
+        state.present = true;
+        state.observedSince = m_now;
+        state.windowStart = m_now;
+        state.windowSent = 0;
+        state.windowReceived = m_received[id];
+        if (!state.scheduled) {
+            state.interval = m_parameters.minInterval;
+            schedule(id, m_now + draw(state, id) * m_parameters.minInterval);
+        }
+    }
+}
+
+void BeaconScheduler::schedule(int vehicleId, double time) {
+    m_states[vehicleId].scheduled = true;
+    insert({time, vehicleId});
+    ++m_scheduled;
+}
+
+void BeaconScheduler::insert(const WheelEntry& entry) {
+    // Niveau le plus bas dont la portée couvre l'échéance; au-delà de
+    // l'horizon, rangée au dernier créneau et redescendue plus tard
+    uint64_t tick = std::max(tickOf(entry.time), m_tick);
+    const uint64_t delta = tick - m_tick;
+    
+    if (delta < (uint64_t(1) << LEVEL0_BITS)) {
+        m_wheel[0][tick & ((uint64_t(1) << LEVEL0_BITS) - 1)].push_back(entry);
+        return;
+    }
+    
+    for (int level = 1; level < WHEEL_LEVELS; ++level) {
+        const int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+        const uint64_t span = uint64_t(1) << (shift + LEVEL_BITS);
+        if (delta < span || level == WHEEL_LEVELS - 1) {
+            tick = std::min(tick, m_tick + span - 1);
+            m_wheel[level][(tick >> shift) & ((uint64_t(1) << LEVEL_BITS) - 1)].push_back(entry);
+            return;
+        }
+    }
+}
+
+void BeaconScheduler::cascade(int level) {
+    const int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+    auto& slot = m_wheel[level][(m_tick >> shift) & ((uint64_t(1) << LEVEL_BITS) - 1)];
+    if (slot.empty()) return;
+    
+    std::vector<WheelEntry> entries;
+    entries.swap(slot);
+    for (const WheelEntry& entry : entries) {
+        insert(entry);
+    }
+    
+    // Le créneau vidé garde sa capacité (sauf s'il a reçu une entrée au-delà de l'horizon)
+    if (slot.empty()) {
+        entries.clear();
+        slot.swap(entries);
+    }
+}
+
+void BeaconScheduler::fire(const InterferenceGraph& graph, const WheelEntry& entry) {
+    const int vehicleId = entry.vehicleId;
+    const double time = entry.time;
+    VehicleState& state = m_states[vehicleId];
+    state.scheduled = false;
+    m_now = std::max(m_now, time);
+    
+    if (state.seenEpoch != m_syncEpoch) {
+        // Absent du dernier update du graphe: plus de beacons
+        if (state.present) {
+            state.present = false;
+            state.stats.observedTime += time - state.observedSince;
+        }
+        return;
+    }
+    
+    ++m_processedBeacons;
+    ++state.stats.generated;
+    
+    // Réception par les voisins courants (m_received couvre tous les IDs du
+    // graphe depuis la dernière relecture)
+    const auto neighbors = graph.getNeighbors(vehicleId);
+    for (int receiverId : neighbors) {
+        ++m_received[receiverId];
+    }
+    ++state.windowSent;
+    state.stats.audience += neighbors.size();
+    
+    // Fin de fenêtre de mesure: CBR lissé puis état DCC
+    const double window = time - state.windowStart;
+    if (window > 0.0 && window >= m_parameters.cbrWindow) {
+        const uint64_t frames = state.windowSent + m_received[vehicleId] - state.windowReceived;
+        const double measured = std::min(frames * m_parameters.frameDuration / window, 1.0);
+        state.cbr = 0.5 * (state.cbr + measured);
+        state.windowStart = time;
+        state.windowSent = 0;
+        state.windowReceived = m_received[vehicleId];
+        if (m_parameters.dcc) {
+            updateDcc(state);
+        }
+    }
+    
+    double interval = m_parameters.minInterval;
+    if (m_parameters.dcc) {
+        interval = std::max(interval, DCC_MIN_INTERVALS[static_cast<int>(state.dccState)]);
+    }
+    state.interval = std::min(interval, m_parameters.maxInterval);
+    schedule(vehicleId, time + state.interval + draw(state, vehicleId) * m_parameters.jitter);
+}
+
+void BeaconScheduler::updateDcc(VehicleState& state) const {
+    int target = 0;
+    while (target < DCC_STATE_COUNT - 1 && state.cbr >= DCC_CBR_THRESHOLDS[target]) {
+        ++target;
+    }
+    
+    const int current = static_cast<int>(state.dccState);
+    if (target > current) {
+        state.dccState = static_cast<DccState>(target);
+    } else if (target < current) {
+        state.dccState = static_cast<DccState>(current - 1);
+    }
+}
+
+bool BeaconScheduler::getVehicleStats(int vehicleId, VehicleStats& stats) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return false;
+    }
+    const VehicleState& state = m_states[vehicleId];
+    stats = state.stats;
+    stats.received = m_received[vehicleId] - state.receivedBase;
+    stats.busyTime = (stats.generated + stats.received) * m_parameters.frameDuration;
+    if (state.present) {
+        stats.observedTime += m_now - state.observedSince;
+    }
+    return true;
+}
+
+BeaconScheduler::DccState BeaconScheduler::getDccState(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return DccState::Relaxed;
+    }
+    return m_states[vehicleId].dccState;
+}
+
+double BeaconScheduler::getChannelBusyRatio(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return 0.0;
+    }
+    return m_states[vehicleId].cbr;
+}
+
+double BeaconScheduler::getBeaconInterval(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return 0.0;
+    }
+    return m_states[vehicleId].interval;
+}
+
+BeaconScheduler::Summary BeaconScheduler::getSummary() const {
+    Summary summary;
+    
+    double observedTime = 0.0;
+    VehicleStats stats;
+    for (size_t id = 0; id < m_states.size(); ++id) {
+        const VehicleState& state = m_states[id];
+        if (!state.present || !getVehicleStats(static_cast<int>(id), stats)) continue;
+        
+        ++summary.vehicles;
+        summary.beacons += stats.generated;
+        summary.receptions += stats.received;
+        observedTime += stats.observedTime;
+        summary.channelBusyRatio += state.cbr;
+        summary.maxChannelBusyRatio = std::max(summary.maxChannelBusyRatio, state.cbr);
+        ++summary.dccStates[static_cast<int>(state.dccState)];
+    }
+    
+    if (summary.vehicles > 0) {
+        summary.channelBusyRatio /= summary.vehicles;
+    }
+    summary.beaconRate = observedTime > 0.0 ? summary.beacons / observedTime : 0.0;
+    return summary;
+}
+
+const char* BeaconScheduler::stateName(DccState state) {
+    switch (state) {
+        case DccState::Relaxed: return "Relaxed";
+        case DccState::Active1: return "Active1";
+        case DccState::Active2: return "Active2";
+        case DccState::Active3: return "Active3";
+        case DccState::Restrictive: return "Restrictive";
+        default: return "?";
+    }
+}
+
+void BeaconScheduler::resetStatistics() {
+    for (size_t id = 0; id < m_states.size(); ++id) {
+        VehicleState& state = m_states[id];
+        state.stats = VehicleStats();
+        state.receivedBase = m_received[id];
+        state.observedSince = m_now;
+    }
+}
+
+void BeaconScheduler::clear() {
+    m_states.clear();
+    m_received.clear();
+    for (auto& level : m_wheel) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    m_firing.clear();
+    m_now = 0.0;
+    m_tick = 0;
+    m_scheduled = 0;
+    m_processedBeacons = 0;
+    m_syncedUpdateTime = std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,87 @@
+#include "network/BuildingIndex.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Orientation du triangle (a, b, c): > 0 à gauche, < 0 à droite
+double orientation(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+}
+
+BuildingIndex::BuildingIndex()
+    : m_buildingCount(0)
+{
+}
+
+void BuildingIndex::addFootprint(const std::vector<Point2D>& ring) {
+    size_t count = ring.size();
+    if (count >= 2 && bg::equals(ring.front(), ring.back())) {
+        --count; // Anneau fermé OSM: dernier sommet = premier
+    }
+    if (count < 3) return;
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Point2D& a = ring[i];
+        const Point2D& b = ring[(i + 1) % count];
+        m_walls.push_back({a.get<0>(), a.get<1>(), b.get<0>(), b.get<1>()});
+    }
+    ++m_buildingCount;
+}
+
+void BuildingIndex::build() {
+    std::vector<WallValue> values;
+    values.reserve(m_walls.size());
+    for (size_t i = 0; i < m_walls.size(); ++i) {
+        const Wall& wall = m_walls[i];
+        values.emplace_back(Box(Point2D(std::min(wall.x1, wall.x2), std::min(wall.y1, wall.y2)),
+                                Point2D(std::max(wall.x1, wall.x2), std::max(wall.y1, wall.y2))),
+                            static_cast<uint32_t>(i));
+    }
+    
+    // Construction en bloc (packing STR), comme le R-tree des véhicules
+    m_tree = WallTree(values.begin(), values.end());
+    
+    LOG_INFO(QString("BuildingIndex built: %1 buildings, %2 walls")
+             .arg(m_buildingCount).arg(m_walls.size()));
+}
+
+int BuildingIndex::countWallCrossings(const Point2D& a, const Point2D& b, int maxWalls) const {
+    if (m_walls.empty()) return 0;
+    
+    const double ax = a.get<0>(), ay = a.get<1>();
+    const double bx = b.get<0>(), by = b.get<1>();
+    const Box query(Point2D(std::min(ax, bx), std::min(ay, by)),
+                    Point2D(std::max(ax, bx), std::max(ay, by)));
+    
+    // Itérateur de requête: arrêt dès que maxWalls murs sont trouvés
+    int crossings = 0;
+    for (auto it = m_tree.qbegin(bgi::intersects(query)); it != m_tree.qend(); ++it) {
+        const Wall& wall = m_walls[it->second];
+        
+        // Intersection propre: les extrémités de chaque segment strictement
+        // de part et d'autre de l'autre (un mur frôlé n'obstrue pas)
+        const double o1 = orientation(ax, ay, bx, by, wall.x1, wall.y1);
+        const double o2 = orientation(ax, ay, bx, by, wall.x2, wall.y2);
+        if ((o1 > 0.0) == (o2 > 0.0) || o1 == 0.0 || o2 == 0.0) continue;
+        const double o3 = orientation(wall.x1, wall.y1, wall.x2, wall.y2, ax, ay);
+        const double o4 = orientation(wall.x1, wall.y1, wall.x2, wall.y2, bx, by);
+        if ((o3 > 0.0) == (o4 > 0.0) || o3 == 0.0 || o4 == 0.0) continue;
+        
+        if (++crossings >= maxWalls) break;
+    }
+    return crossings;
+}
+
+void BuildingIndex::clear() {
+    m_walls.clear();
+    m_tree.clear();
+    m_buildingCount = 0;
+}
+
+} // namespace network
+} // namespace v2v
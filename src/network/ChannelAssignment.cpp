@@ -0,0 +1,428 @@
+#include "network/ChannelAssignment.hpp"
+#include "network/InterferenceGraph.hpp"
+#include "utils/Logger.hpp"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+
+// Exécute body sur [0, n) par blocs, via TBB ou d'un seul tenant
+template <typename Body>
+void forEachBlock(bool parallel, size_t n, size_t grain, const Body& body) {
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n, grain), body);
+    } else if (n > 0) {
+        body(tbb::blocked_range<size_t>(0, n));
+    }
+}
+
+// Somme de body(range) sur [0, n), via TBB ou d'un seul tenant
+template <typename T, typename Body>
+T sumBlocks(bool parallel, size_t n, size_t grain, const Body& body) {
+    if (parallel) {
+        return tbb::parallel_reduce(tbb::blocked_range<size_t>(0, n, grain), T(0),
+            [&](const tbb::blocked_range<size_t>& range, T sum) { return sum + body(range); },
+            [](T a, T b) { return a + b; });
+    }
+    return n > 0 ? body(tbb::blocked_range<size_t>(0, n)) : T(0);
+}
+
+// Mélange SplitMix64 (priorités bien réparties même pour des IDs consécutifs)
+uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Même canal (véhicules non colorés jamais en conflit)
+bool sameChannel(int channel1, int channel2) {
+    return channel1 >= 0 && channel1 == channel2;
+}
+}
+
+ChannelAssignment::ChannelAssignment()
+    : m_enabled(false)
+    , m_parallel(true)
+    , m_colored(false)
+    , m_stamp(0)
+    , m_round(0)
+    , m_conflicts(0)
+{
+}
+
+void ChannelAssignment::setParameters(const Parameters& parameters) {
+    const bool reseed = parameters.seed != m_parameters.seed;
+    m_parameters = parameters;
+    m_parameters.channelCount = std::clamp(m_parameters.channelCount, 1, MAX_CHANNELS);
+    if (reseed) {
+        for (size_t id = 0; id < m_priority.size(); ++id) {
+            m_priority[id] = priorityOf(static_cast<int>(id));
+        }
+    }
+    m_colored = false;
+}
+
+void ChannelAssignment::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+uint64_t ChannelAssignment::priorityOf(int vehicleId) const {
+    return mix64(static_cast<uint64_t>(vehicleId) ^ mix64(m_parameters.seed));
+}
+
+void ChannelAssignment::ensureCapacity(int vehicleId) {
+    const size_t size = static_cast<size_t>(vehicleId) + 1;
+    if (m_channel.size() >= size) return;
+    
+    const size_t first = m_channel.size();
+    const size_t capacity = std::max(size, first * 2);
+    m_channel.resize(capacity, -1);
+    m_proposal.resize(capacity, -1);
+    m_seenStamp.resize(capacity, 0);
+    m_candidateStamp.resize(capacity, 0);
+    m_roundStamp.resize(capacity, 0);
+    m_pending.resize(capacity, 0);
+    m_priority.resize(capacity);
+    for (size_t id = first; id < capacity; ++id) {
+        m_priority[id] = priorityOf(static_cast<int>(id));
+    }
+}
+
+int ChannelAssignment::getChannel(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_channel.size()) return -1;
+    return m_channel[vehicleId];
+}
+
+int ChannelAssignment::chooseChannel(std::span<const int> neighbors, int current,
+                                     size_t& conflicts, size_t& currentConflicts) const {
+    const int channelCount = m_parameters.channelCount;
+    std::array<uint32_t, MAX_CHANNELS> counts{};
+    for (int neighbor : neighbors) {
+        const int channel = m_channel[neighbor];
+        if (channel >= 0) {
+            ++counts[channel];
+        }
+    }
+    
+    int best = 0;
+    for (int channel = 1; channel < channelCount && counts[best] > 0; ++channel) {
+        if (counts[channel] < counts[best]) {
+            best = channel;
+        }
+    }
+    if (current >= 0) {
+        currentConflicts = counts[current];
+        if (counts[current] == counts[best]) {
+            best = current;
+        }
+    } else {
+        currentConflicts = std::numeric_limits<size_t>::max();
+    }
+    conflicts = counts[best];
+    return best;
+}
+
+void ChannelAssignment::update(const InterferenceGraph& graph) {
+    if (!m_enabled) return;
+    if (!m_colored) {
+        recolorAll(graph);
+        return;
+    }
+    
+    const auto start = std::chrono::steady_clock::now();
+    if (++m_stamp == 0) {
+        std::fill(m_seenStamp.begin(), m_seenStamp.end(), 0);
+        std::fill(m_candidateStamp.begin(), m_candidateStamp.end(), 0);
+        m_stamp = 1;
+    }
+    m_candidates.clear();
+    
+    // 1) Liens rompus ou formés: conflits comptés sur les canaux courants
+    //    (ceux des véhicules retirés sont encore connus); leurs extrémités
+    //    présentes sont candidates
+    const auto vehicleIds = graph.getVehicleIds();
+    for (int id : vehicleIds) {
+        ensureCapacity(id);
+        m_seenStamp[id] = m_stamp;
+    }
+    
+    auto addCandidate = [this](int vehicleId) {
+        if (m_seenStamp[vehicleId] == m_stamp && m_candidateStamp[vehicleId] != m_stamp) {
+            m_candidateStamp[vehicleId] = m_stamp;
+            m_candidates.push_back(vehicleId);
+        }
+    };
+    
+    for (const auto& event : graph.getLinkEvents()) {
+        ensureCapacity(event.vehicleId2);
+        if (sameChannel(m_channel[event.vehicleId1], m_channel[event.vehicleId2])) {
+            if (event.type == LinkEvent::Type::Up) {
+                ++m_conflicts;
+            } else {
+                --m_conflicts;
+            }
+        }
+        addCandidate(event.vehicleId1);
+        addCandidate(event.vehicleId2);
+    }
+    
+    // 2) Départs: canal libéré (leurs liens sont déjà comptés rompus)
+    for (int id : m_trackedIds) {
+        if (m_seenStamp[id] != m_stamp) {
+            m_channel[id] = -1;
+        }
+    }
+    m_trackedIds.assign(vehicleIds.begin(), vehicleIds.end());
+    
+    // 3) Arrivées sans lien: premier canal, sans conflit possible
+    for (int id : vehicleIds) {
+        if (m_channel[id] < 0) {
+            addCandidate(id);
+        }
+    }
+    
+    m_summary.candidates = m_candidates.size();
+    m_summary.recolored = 0;
+    m_summary.rounds = 0;
+    m_summary.fullColoring = false;
+    recolorCandidates(graph);
+    m_summary.totalRecolored += m_summary.recolored;
+    
+    finishUpdate(graph);
+    m_summary.computeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void ChannelAssignment::recolorCandidates(const InterferenceGraph& graph) {
+    enum : uint8_t { KEEP, SWITCH, DEFER };
+    
+    while (!m_candidates.empty() && m_summary.rounds < MAX_ROUNDS) {
+        ++m_summary.rounds;
+        if (++m_round == 0) {
+            std::fill(m_roundStamp.begin(), m_roundStamp.end(), 0);
+            m_round = 1;
+        }
+        
+        // Propositions sur les canaux du tour précédent: indépendantes de
+        // l'ordre de traitement
+        const size_t count = m_candidates.size();
+        m_gains.resize(count);
+        m_decisions.resize(count);
+        forEachBlock(m_parallel, count, PARALLEL_GRAIN_SIZE, [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                const int id = m_candidates[i];
+                const int current = m_channel[id];
+                size_t conflicts = 0;
+                size_t currentConflicts = 0;
+                const int best = chooseChannel(graph.getNeighbors(id), current, conflicts, currentConflicts);
+                const bool improves = conflicts < currentConflicts;
+                m_proposal[id] = static_cast<int8_t>(improves ? best : current);
+                m_roundStamp[id] = m_round;
+                m_gains[i] = static_cast<int32_t>(conflicts) - (current >= 0 ? static_cast<int32_t>(currentConflicts) : 0);
+                m_decisions[i] = improves ? SWITCH : KEEP;
+            }
+        });
+        
+        // Changements simultanés limités à un ensemble indépendant: un
+        // candidat cède si un voisin plus prioritaire change aussi. Le gain
+        // calculé sur les canaux du tour reste alors exact.
+        forEachBlock(m_parallel, count, PARALLEL_GRAIN_SIZE, [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                if (m_decisions[i] != SWITCH) continue;
+                const int id = m_candidates[i];
+                for (int neighbor : graph.getNeighbors(id)) {
+                    if (m_roundStamp[neighbor] == m_round && m_proposal[neighbor] != m_channel[neighbor]
+                        && higherPriority(neighbor, id)) {
+                        m_decisions[i] = DEFER;
+                        break;
+                    }
+                }
+            }
+        });
+        
+        size_t deferred = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const int id = m_candidates[i];
+            if (m_decisions[i] == SWITCH) {
+                if (m_channel[id] >= 0) {
+                    ++m_summary.recolored;
+                }
+                m_channel[id] = m_proposal[id];
+                m_conflicts = static_cast<size_t>(static_cast<int64_t>(m_conflicts) + m_gains[i]);
+            } else if (m_decisions[i] == DEFER) {
+                m_candidates[deferred++] = id;
+            }
+        }
+        m_candidates.resize(deferred);
+    }
+    
+    // Reliquat après MAX_ROUNDS tours: un par un (rare; garantit qu'aucun
+    // nouveau véhicule ne reste sans canal)
+    for (int id : m_candidates) {
+        const int current = m_channel[id];
+        size_t conflicts = 0;
+        size_t currentConflicts = 0;
+        const int best = chooseChannel(graph.getNeighbors(id), current, conflicts, currentConflicts);
+        if (conflicts < currentConflicts) {
+            if (current >= 0) {
+                ++m_summary.recolored;
+            }
+            m_conflicts = m_conflicts + conflicts - (current >= 0 ? currentConflicts : 0);
+            m_channel[id] = static_cast<int8_t>(best);
+        }
+    }
+    m_candidates.clear();
+}
+
+void ChannelAssignment::recolorAll(const InterferenceGraph& graph) {
+    const auto start = std::chrono::steady_clock::now();
+    
+    const auto vehicleIds = graph.getVehicleIds();
+    for (int id : vehicleIds) {
+        ensureCapacity(id);
+    }
+    std::fill(m_channel.begin(), m_channel.end(), -1);
+    m_trackedIds.assign(vehicleIds.begin(), vehicleIds.end());
+    
+    // Voisins plus prioritaires de chaque véhicule; sans aucun: première vague
+    const size_t n = vehicleIds.size();
+    forEachBlock(m_parallel, n, PARALLEL_GRAIN_SIZE, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const int id = vehicleIds[i];
+            uint32_t pending = 0;
+            for (int neighbor : graph.getNeighbors(id)) {
+                pending += higherPriority(neighbor, id);
+            }
+            m_pending[id] = pending;
+        }
+    });
+    m_wave.clear();
+    for (int id : vehicleIds) {
+        if (m_pending[id] == 0) {
+            m_wave.push_back(id);
+        }
+    }
+    
+    // Vagues: aucun lien à l'intérieur d'une vague (de deux voisins, le moins
+    // prioritaire attend l'autre), les voisins colorés sont exactement les
+    // plus prioritaires
+    m_nextWave.resize(n);
+    m_summary.rounds = 0;
+    while (!m_wave.empty()) {
+        ++m_summary.rounds;
+        std::atomic<size_t> nextCount{0};
+        forEachBlock(m_parallel, m_wave.size(), PARALLEL_GRAIN_SIZE, [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                const int id = m_wave[i];
+                const auto neighbors = graph.getNeighbors(id);
+                size_t conflicts = 0;
+                size_t currentConflicts = 0;
+                m_channel[id] = static_cast<int8_t>(chooseChannel(neighbors, -1, conflicts, currentConflicts));
+                for (int neighbor : neighbors) {
+                    if (higherPriority(id, neighbor)
+                        && std::atomic_ref<uint32_t>(m_pending[neighbor]).fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        m_nextWave[nextCount.fetch_add(1, std::memory_order_relaxed)] = neighbor;
+                    }
+                }
+            }
+        });
+        m_wave.assign(m_nextWave.begin(), m_nextWave.begin() + nextCount.load());
+    }
+    
+    // Affinage: les voisins moins prioritaires, ignorés par les vagues, font
+    // souvent préférer un autre canal; mêmes tours spéculatifs que l'update
+    // incrémental sur tous les véhicules, pour qu'un tick suivant ne change
+    // que les canaux touchés par le delta
+    m_conflicts = countConflicts(graph);
+    m_candidates.assign(vehicleIds.begin(), vehicleIds.end());
+    const int waves = m_summary.rounds;
+    m_summary.rounds = 0;
+    recolorCandidates(graph);
+    m_summary.rounds += waves;
+    
+    m_colored = true;
+    m_summary.candidates = n;
+    m_summary.recolored = n;
+    m_summary.fullColoring = true;
+    
+    finishUpdate(graph);
+    m_summary.computeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+size_t ChannelAssignment::countConflicts(const InterferenceGraph& graph) const {
+    const auto vehicleIds = graph.getVehicleIds();
+    return sumBlocks<size_t>(m_parallel, vehicleIds.size(), PARALLEL_GRAIN_SIZE,
+        [&](const tbb::blocked_range<size_t>& range) {
+            size_t conflicts = 0;
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                const int id = vehicleIds[i];
+                const int channel = getChannel(id);
+                for (int neighbor : graph.getNeighbors(id)) {
+                    conflicts += neighbor > id && sameChannel(channel, getChannel(neighbor));
+                }
+            }
+            return conflicts;
+        });
+}
+
+void ChannelAssignment::finishUpdate(const InterferenceGraph& graph) {
+    m_channelUsage.assign(m_parameters.channelCount, 0);
+    for (int id : graph.getVehicleIds()) {
+        ++m_channelUsage[m_channel[id]];
+    }
+    
+    ++m_summary.updates;
+    m_summary.vehicles = graph.getVehicleCount();
+    m_summary.links = graph.getConnectionCount();
+    m_summary.conflicts = m_conflicts;
+    m_summary.conflictRatio = m_summary.links > 0
+        ? static_cast<double>(m_conflicts) / m_summary.links : 0.0;
+    m_summary.channelsUsed = static_cast<int>(
+        std::count_if(m_channelUsage.begin(), m_channelUsage.end(), [](size_t used) { return used > 0; }));
+}
+
+void ChannelAssignment::logSummary() const {
+    LOG_INFO(QString("Channel assignment: %1 channels (%2 used), %3 vehicles, %4 links, "
+                     "%5 conflicts (%6%)")
+             .arg(m_parameters.channelCount)
+             .arg(m_summary.channelsUsed)
+             .arg(m_summary.vehicles)
+             .arg(m_summary.links)
+             .arg(m_summary.conflicts)
+             .arg(m_summary.conflictRatio * 100.0, 0, 'f', 2));
+    LOG_INFO(QString("Channel assignment: last update %1 candidates, %2 rounds, %3 ms; "
+                     "%4 channel switches over %5 updates")
+             .arg(m_summary.candidates)
+             .arg(m_summary.rounds)
+             .arg(m_summary.computeMs, 0, 'f', 2)
+             .arg(m_summary.totalRecolored)
+             .arg(m_summary.updates));
+}
+
+void ChannelAssignment::clear() {
+    std::fill(m_channel.begin(), m_channel.end(), -1);
+    m_trackedIds.clear();
+    m_candidates.clear();
+    m_channelUsage.clear();
+    m_conflicts = 0;
+    m_colored = false;
+    m_summary = Summary();
+}
+
+} // namespace network
+} // namespace v2v
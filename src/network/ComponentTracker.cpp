@@ -0,0 +1,472 @@
+#include "network/ComponentTracker.hpp"
+#include "network/InterferenceGraph.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Budget (voisins parcourus) de la recherche locale qui écarte un lien rompu
+// dont les extrémités restent reliées par un court détour
+constexpr size_t LOCAL_SEARCH_BUDGET = 512;
+
+// Au-delà de liens / ce ratio événements par update, réétiquetage complet
+// (mesuré: le parcours complet devient moins cher que le rejeu du delta)
+constexpr size_t FULL_RELABEL_EVENT_RATIO = 8;
+}
+
+ComponentTracker::ComponentTracker()
+    : m_stamp(0)
+    , m_vehicleCount(0)
+    , m_clusterCount(0)
+    , m_largestClusterSize(0)
+    , m_lastSplitVisits(0)
+    , m_epoch(0)
+{
+}
+
+void ComponentTracker::update(const InterferenceGraph& graph) {
+    m_lastSplitVisits = 0;
+    if (++m_stamp == 0) {
+        std::fill(m_seenStamp.begin(), m_seenStamp.end(), 0);
+        std::fill(m_seedStamp.begin(), m_seedStamp.end(), 0);
+        std::fill(m_detachedStamp.begin(), m_detachedStamp.end(), 0);
+        m_stamp = 1;
+    }
+    
+    // 1) Arrivées: chaque nouveau véhicule est d'abord un cluster isolé
+    const auto vehicleIds = graph.getVehicleIds();
+    for (int id : vehicleIds) {
+        ensureCapacity(id);
+        m_seenStamp[id] = m_stamp;
+        if (m_clusterOf[id] < 0) {
+            addMember(allocateCluster(), id);
+            countCluster(1, +1);
+        }
+    }
+    
+    // 2) Départs: retirés de leur cluster; leurs anciens voisins sont les
+    //    extrémités de liens rompus et serviront de points de départ au 4)
+    for (int id : m_trackedIds) {
+        if (m_seenStamp[id] == m_stamp) continue;
+        
+        const int cluster = m_clusterOf[id];
+        const size_t size = m_members[cluster].size();
+        removeMember(id);
+        if (size > 1) {
+            countCluster(size - 1, +1);
+        } else {
+            releaseCluster(cluster);
+        }
+        countCluster(size, -1);
+    }
+    m_trackedIds.assign(vehicleIds.begin(), vehicleIds.end());
+    m_vehicleCount = vehicleIds.size();
+    
+    // Gros delta (premier update, saut de temps): un étiquetage complet coûte
+    // moins cher que de rejouer les événements
+    const auto& events = graph.getLinkEvents();
+    if (events.size() * FULL_RELABEL_EVENT_RATIO > graph.getConnectionCount()) {
+        relabelAll(graph);
+        return;
+    }
+    
+    // 3) Liens formés: fusions. Après cette étape chaque cluster contient
+    //    entièrement les composantes du graphe courant qu'il recouvre
+    for (const auto& event : events) {
+        if (event.type == LinkEvent::Type::Up) {
+            mergeClusters(event.vehicleId1, event.vehicleId2);
+        }
+    }
+    
+    // 4) Liens rompus. Un cluster ne peut se scinder qu'entre extrémités de
+    //    liens rompus; un lien dont les extrémités restent reliées (voisin
+    //    commun, ou recherche locale bornée) ne sépare rien et est écarté.
+    //    Idem pour un véhicule parti dont les anciens voisins restent reliés.
+    //    Une recherche locale qui explore tout un fragment le détache aussitôt.
+    m_touchedClusters.clear();
+    m_departedLinks.clear();
+    
+    auto isTracked = [this](int vehicleId) {
+        return static_cast<size_t>(vehicleId) < m_clusterOf.size() && m_clusterOf[vehicleId] >= 0;
+    };
+    
+    int pair[2];
+    for (const auto& event : events) {
+        if (event.type != LinkEvent::Type::Down) continue;
+        
+        const int a = event.vehicleId1;
+        const int b = event.vehicleId2;
+        const bool hasA = isTracked(a);
+        const bool hasB = isTracked(b);
+        if (!hasA || !hasB) {
+            if (hasA || hasB) {
+                m_departedLinks.emplace_back(hasA ? b : a, hasA ? a : b);
+            }
+            continue;
+        }
+        
+        pair[0] = a;
+        pair[1] = b;
+        if (m_clusterOf[a] != m_clusterOf[b]) {
+            // Séparés par un fragment détaché pendant ce update: le côté restant
+            // peut encore être scindé ailleurs, ses extrémités restent à traiter
+            if (m_detachedStamp[a] == m_stamp || m_detachedStamp[b] == m_stamp) {
+                addSeeds(pair);
+            }
+            continue;
+        }
+        if (shareNeighbor(graph.getNeighbors(a), graph.getNeighbors(b))) continue;
+        
+        if (!exploreFromSeeds(graph, pair, LOCAL_SEARCH_BUDGET)) {
+            addSeeds(pair);
+        }
+    }
+    
+    // Anciens voisins de chaque véhicule parti (triés par véhicule parti)
+    std::sort(m_departedLinks.begin(), m_departedLinks.end());
+    std::vector<int> group;
+    for (size_t begin = 0; begin < m_departedLinks.size();) {
+        size_t end = begin;
+        group.clear();
+        while (end < m_departedLinks.size() && m_departedLinks[end].first == m_departedLinks[begin].first) {
+            group.push_back(m_departedLinks[end++].second);
+        }
+        begin = end;
+        if (group.size() < 2) continue;
+        
+        const bool sameCluster = std::all_of(group.begin(), group.end(), [&](int id) {
+            return m_clusterOf[id] == m_clusterOf[group.front()];
+        });
+        if (!sameCluster || !exploreFromSeeds(graph, group, LOCAL_SEARCH_BUDGET)) {
+            addSeeds(group);
+        }
+    }
+    
+    // 5) Extrémités non résolues localement, regroupées par cluster: même
+    //    recherche, sans budget
+    for (int cluster : m_touchedClusters) {
+        std::vector<int> seeds = std::move(m_clusterSeeds[cluster]);
+        m_clusterSeeds[cluster].clear();
+        // Les extrémités détachées depuis dans un fragment n'ont plus rien à scinder
+        std::erase_if(seeds, [&](int id) { return m_clusterOf[id] != cluster; });
+        // Une seule extrémité dans le cluster: il ne peut pas s'être scindé
+        if (seeds.size() > 1) {
+            exploreFromSeeds(graph, seeds, std::numeric_limits<size_t>::max());
+        }
+    }
+}
+
+void ComponentTracker::addSeeds(std::span<const int> vehicleIds) {
+    for (int vehicleId : vehicleIds) {
+        if (m_seedStamp[vehicleId] == m_stamp) continue;
+        m_seedStamp[vehicleId] = m_stamp;
+        
+        auto& seeds = m_clusterSeeds[m_clusterOf[vehicleId]];
+        if (seeds.empty()) {
+            m_touchedClusters.push_back(m_clusterOf[vehicleId]);
+        }
+        seeds.push_back(vehicleId);
+    }
+}
+
+void ComponentTracker::relabelAll(const InterferenceGraph& graph) {
+    for (int id : m_trackedIds) {
+        if (m_clusterOf[id] >= 0) {
+            removeMember(id);
+        }
+    }
+    m_members.clear();
+    m_clusterSeeds.clear();
+    m_freeClusters.clear();
+    std::fill(m_countBySize.begin(), m_countBySize.end(), 0);
+    std::fill(m_sizeHistogram.begin(), m_sizeHistogram.end(), 0);
+    m_clusterCount = 0;
+    m_largestClusterSize = 0;
+    
+    // Parcours en largeur; la liste des membres sert de file
+    for (int id : m_trackedIds) {
+        if (m_clusterOf[id] >= 0) continue;
+        
+        const int cluster = allocateCluster();
+        addMember(cluster, id);
+        for (size_t head = 0; head < m_members[cluster].size(); ++head) {
+            for (int neighborId : graph.getNeighbors(m_members[cluster][head])) {
+                if (m_clusterOf[neighborId] < 0) {
+                    addMember(cluster, neighborId);
+                }
+            }
+        }
+        countCluster(m_members[cluster].size(), +1);
+    }
+}
+
+bool ComponentTracker::shareNeighbor(std::span<const int> row1, std::span<const int> row2) {
+    // Lignes triées par ID: intersection par fusion
+    auto a = row1.begin();
+    auto b = row2.begin();
+    while (a != row1.end() && b != row2.end()) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ComponentTracker::exploreFromSeeds(const InterferenceGraph& graph, std::span<const int> seeds,
+                                        size_t visitBudget) {
+    if (++m_epoch == 0) {
+        std::fill(m_visitEpoch.begin(), m_visitEpoch.end(), 0);
+        m_epoch = 1;
+    }
+    
+    // Une recherche par extrémité; deux recherches qui se rencontrent sont
+    // dans le même fragment et fusionnent (union-find sur les recherches)
+    const int cluster = m_clusterOf[seeds.front()];
+    if (m_searches.size() < seeds.size()) {
+        m_searches.resize(seeds.size());
+    }
+    m_roots.resize(seeds.size());
+    for (size_t k = 0; k < seeds.size(); ++k) {
+        auto& search = m_searches[k];
+        search.frontier.assign(1, seeds[k]);
+        search.visited.assign(1, seeds[k]);
+        search.head = 0;
+        search.parent = static_cast<int>(k);
+        m_visitEpoch[seeds[k]] = m_epoch;
+        m_visitedBy[seeds[k]] = static_cast<int>(k);
+        m_roots[k] = static_cast<int>(k);
+    }
+    
+    // Expansion en alternance (un sommet par recherche et par tour): dès qu'il
+    // ne reste qu'une recherche active, elle garde le cluster d'origine sans
+    // avoir été parcourue jusqu'au bout
+    size_t visits = 0;
+    bool allJoined = true;
+    while (m_roots.size() > 1) {
+        for (size_t r = 0; r < m_roots.size() && m_roots.size() > 1;) {
+            int current = m_roots[r];
+            if (m_searches[current].parent != current) {
+                // Absorbée par une autre recherche pendant ce tour
+                m_roots[r] = m_roots.back();
+                m_roots.pop_back();
+                continue;
+            }
+            
+            auto* search = &m_searches[current];
+            if (search->head == search->frontier.size()) {
+                // Fragment entièrement exploré sans rencontrer les autres:
+                // c'est une composante complète, détachée du cluster
+                allJoined = false;
+                const int fragment = allocateCluster();
+                const size_t before = m_members[cluster].size();
+                for (int id : search->visited) {
+                    removeMember(id);
+                    addMember(fragment, id);
+                    m_detachedStamp[id] = m_stamp;
+                }
+                countCluster(before - search->visited.size(), +1);
+                countCluster(search->visited.size(), +1);
+                countCluster(before, -1);
+                
+                m_roots[r] = m_roots.back();
+                m_roots.pop_back();
+                continue;
+            }
+            
+            const int vehicleId = search->frontier[search->head++];
+            const auto neighbors = graph.getNeighbors(vehicleId);
+            visits += neighbors.size();
+            m_lastSplitVisits += neighbors.size();
+            if (visits > visitBudget) {
+                return false;
+            }
+            
+            for (int neighborId : neighbors) {
+                if (m_visitEpoch[neighborId] != m_epoch) {
+                    m_visitEpoch[neighborId] = m_epoch;
+                    m_visitedBy[neighborId] = current;
+                    search->frontier.push_back(neighborId);
+                    search->visited.push_back(neighborId);
+                    continue;
+                }
+                
+                const int other = findSearch(m_visitedBy[neighborId]);
+                if (other == current) continue;
+                
+                // Rencontre: la plus petite recherche est versée dans la plus grande
+                auto& a = m_searches[current];
+                auto& b = m_searches[other];
+                auto& big = a.visited.size() >= b.visited.size() ? a : b;
+                auto& small = &big == &a ? b : a;
+                big.frontier.insert(big.frontier.end(), small.frontier.begin() + small.head, small.frontier.end());
+                big.visited.insert(big.visited.end(), small.visited.begin(), small.visited.end());
+                small.parent = &big == &a ? current : other;
+                small.frontier.clear();
+                small.visited.clear();
+                small.head = 0;
+                
+                current = &big == &a ? current : other;
+                search = &m_searches[current];
+            }
+            ++r;
+        }
+    }
+    return allJoined;
+}
+
+int ComponentTracker::findSearch(int search) {
+    while (m_searches[search].parent != search) {
+        const int parent = m_searches[search].parent;
+        m_searches[search].parent = m_searches[parent].parent;
+        search = parent;
+    }
+    return search;
+}
+
+void ComponentTracker::mergeClusters(int vehicleId1, int vehicleId2) {
+    int keep = m_clusterOf[vehicleId1];
+    int absorb = m_clusterOf[vehicleId2];
+    if (keep == absorb) return;
+    
+    if (m_members[keep].size() < m_members[absorb].size()) {
+        std::swap(keep, absorb);
+    }
+    
+    const size_t keepSize = m_members[keep].size();
+    const size_t absorbSize = m_members[absorb].size();
+    for (int id : m_members[absorb]) {
+        m_clusterOf[id] = keep;
+        m_memberPos[id] = static_cast<int>(m_members[keep].size());
+        m_members[keep].push_back(id);
+    }
+    m_members[absorb].clear();
+    releaseCluster(absorb);
+    
+    countCluster(keepSize + absorbSize, +1);
+    countCluster(keepSize, -1);
+    countCluster(absorbSize, -1);
+}
+
+int ComponentTracker::getClusterId(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_clusterOf.size()) {
+        return -1;
+    }
+    return m_clusterOf[vehicleId];
+}
+
+size_t ComponentTracker::getClusterSize(int vehicleId) const {
+    const int cluster = getClusterId(vehicleId);
+    return cluster >= 0 ? m_members[cluster].size() : 0;
+}
+
+double ComponentTracker::getIsolatedFraction() const {
+    if (m_vehicleCount == 0 || m_countBySize.size() < 2) return 0.0;
+    
+    return static_cast<double>(m_countBySize[1]) / m_vehicleCount;
+}
+
+void ComponentTracker::clear() {
+    m_clusterOf.clear();
+    m_memberPos.clear();
+    m_members.clear();
+    m_freeClusters.clear();
+    m_trackedIds.clear();
+    m_seenStamp.clear();
+    m_seedStamp.clear();
+    m_detachedStamp.clear();
+    m_clusterSeeds.clear();
+    m_touchedClusters.clear();
+    m_countBySize.clear();
+    m_sizeHistogram.clear();
+    m_visitEpoch.clear();
+    m_visitedBy.clear();
+    m_stamp = 0;
+    m_epoch = 0;
+    m_vehicleCount = 0;
+    m_clusterCount = 0;
+    m_largestClusterSize = 0;
+    m_lastSplitVisits = 0;
+}
+
+void ComponentTracker::ensureCapacity(int vehicleId) {
+    if (static_cast<size_t>(vehicleId) < m_clusterOf.size()) return;
+    
+    const size_t size = static_cast<size_t>(vehicleId) + 1;
+    m_clusterOf.resize(size, -1);
+    m_memberPos.resize(size, -1);
+    m_seenStamp.resize(size, 0);
+    m_seedStamp.resize(size, 0);
+    m_detachedStamp.resize(size, 0);
+    m_visitEpoch.resize(size, 0);
+    m_visitedBy.resize(size, -1);
+}
+
+int ComponentTracker::allocateCluster() {
+    if (!m_freeClusters.empty()) {
+        const int cluster = m_freeClusters.back();
+        m_freeClusters.pop_back();
+        return cluster;
+    }
+    m_members.emplace_back();
+    m_clusterSeeds.emplace_back();
+    return static_cast<int>(m_members.size()) - 1;
+}
+
+void ComponentTracker::releaseCluster(int cluster) {
+    m_freeClusters.push_back(cluster);
+}
+
+void ComponentTracker::addMember(int cluster, int vehicleId) {
+    m_clusterOf[vehicleId] = cluster;
+    m_memberPos[vehicleId] = static_cast<int>(m_members[cluster].size());
+    m_members[cluster].push_back(vehicleId);
+}
+
+void ComponentTracker::removeMember(int vehicleId) {
+    // Retrait O(1): le dernier membre prend la place du véhicule retiré
+    auto& members = m_members[m_clusterOf[vehicleId]];
+    const int pos = m_memberPos[vehicleId];
+    members[pos] = members.back();
+    m_memberPos[members[pos]] = pos;
+    members.pop_back();
+    
+    m_clusterOf[vehicleId] = -1;
+    m_memberPos[vehicleId] = -1;
+}
+
+void ComponentTracker::countCluster(size_t size, int delta) {
+    // Appelants: nouvelles tailles comptées avant de retirer les anciennes,
+    // sinon la recherche du plus grand cluster redescend toutes les tailles
+    if (size == 0) return;
+    
+    if (m_countBySize.size() <= size) {
+        m_countBySize.resize(size + 1, 0);
+    }
+    const size_t bin = std::bit_width(size) - 1;
+    if (m_sizeHistogram.size() <= bin) {
+        m_sizeHistogram.resize(bin + 1, 0);
+    }
+    
+    m_countBySize[size] += delta;
+    m_sizeHistogram[bin] += delta;
+    m_clusterCount += delta;
+    
+    if (delta > 0) {
+        m_largestClusterSize = std::max(m_largestClusterSize, size);
+    } else {
+        while (m_largestClusterSize > 0 && m_countBySize[m_largestClusterSize] == 0) {
+            --m_largestClusterSize;
+        }
+    }
+}
+
+} // namespace network
+} // namespace v2v
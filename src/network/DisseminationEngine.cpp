@@ -0,0 +1,318 @@
+#include "network/DisseminationEngine.hpp"
+#include "data/GeometryUtils.hpp"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// En dessous de ce nombre de messages actifs, le coût de TBB dépasse le gain
+constexpr size_t PARALLEL_MIN_MESSAGES = 64;
+constexpr size_t PARALLEL_GRAIN_SIZE = 8;
+
+// Tolérance sur l'échéance d'un saut (accumulation des pas de temps)
+constexpr double HOP_TIME_EPSILON = 1e-9;
+
+// Mètres par degré de latitude (même rayon terrestre que Haversine)
+constexpr double METERS_PER_DEGREE =
+    data::GeometryUtils::EARTH_RADIUS_M * data::GeometryUtils::PI / 180.0;
+
+// Tirage uniforme dans [0, 1) déterministe par (message, véhicule), pour que
+// le gossip donne le même résultat quel que soit l'ordre d'exécution (SplitMix64)
+double uniformDraw(int messageId, int vehicleId) {
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(messageId)) << 32)
+               | static_cast<uint32_t>(vehicleId);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<double>(z >> 11) * 0x1.0p-53;
+}
+
+bool testBit(const std::vector<uint64_t>& bits, int index) {
+    const size_t word = static_cast<size_t>(index) >> 6;
+    return word < bits.size() && (bits[word] >> (index & 63)) & 1;
+}
+
+void setBit(std::vector<uint64_t>& bits, int index) {
+    const size_t word = static_cast<size_t>(index) >> 6;
+    if (word >= bits.size()) {
+        bits.resize(word + 1, 0);
+    }
+    bits[word] |= uint64_t(1) << (index & 63);
+}
+}
+
+DisseminationEngine::DisseminationEngine()
+    : m_nextMessageId(0)
+    , m_hopLatency(0.002)   // 2 ms par saut (accès canal + traitement)
+    , m_maxHops(32)
+    , m_policy(RebroadcastPolicy::Flooding)
+    , m_probability(0.6)
+    , m_minDistance(150.0)
+    , m_parallel(true)
+{
+}
+
+void DisseminationEngine::setHopLatency(double seconds) {
+    m_hopLatency = std::max(seconds, 1e-6);
+}
+
+void DisseminationEngine::setMaxHops(int hops) {
+    m_maxHops = std::max(hops, 1);
+}
+
+void DisseminationEngine::setRebroadcastProbability(double probability) {
+    m_probability = std::clamp(probability, 0.0, 1.0);
+}
+
+void DisseminationEngine::setMinRebroadcastDistance(double meters) {
+    m_minDistance = std::max(meters, 0.0);
+}
+
+int DisseminationEngine::broadcast(int sourceId, double simulationTime) {
+    return inject(MessageType::Broadcast, sourceId, simulationTime);
+}
+
+int DisseminationEngine::geocast(int sourceId, const Box& region, double simulationTime) {
+    const int messageId = inject(MessageType::Geocast, sourceId, simulationTime);
+    m_active.back().region = region;
+    return messageId;
+}
+
+int DisseminationEngine::unicast(int sourceId, int destinationId, double simulationTime) {
+    const int messageId = inject(MessageType::Unicast, sourceId, simulationTime);
+    m_active.back().destinationId = destinationId;
+    return messageId;
+}
+
+int DisseminationEngine::inject(MessageType type, int sourceId, double simulationTime) {
+    Message message;
+    message.result.messageId = m_nextMessageId++;
+    message.result.type = type;
+    message.result.sourceId = sourceId;
+    message.result.createdAt = simulationTime;
+    message.result.completedAt = simulationTime;
+    message.policy = m_policy;
+    message.probability = m_probability;
+    message.minDistance = m_minDistance;
+    message.hopLatency = m_hopLatency;
+    message.maxHops = m_maxHops;
+    
+    m_active.push_back(std::move(message));
+    return m_active.back().result.messageId;
+}
+
+void DisseminationEngine::advance(const InterferenceGraph& graph, double simulationTime) {
+    if (m_active.empty()) return;
+    
+    const auto vehicleIds = graph.getVehicleIds();
+    const int idBound = vehicleIds.empty() ? 0 : *std::max_element(vehicleIds.begin(), vehicleIds.end()) + 1;
+    
+    // Un message par tâche: seul le graphe (lecture seule) est partagé
+    auto body = [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t m = range.begin(); m != range.end(); ++m) {
+            Message& message = m_active[m];
+            if (!message.started) {
+                start(message, graph, idBound);
+            }
+            if (!message.finished) {
+                propagate(message, graph, simulationTime);
+            }
+        }
+    };
+    
+    if (m_parallel && m_active.size() >= PARALLEL_MIN_MESSAGES) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, m_active.size(), PARALLEL_GRAIN_SIZE), body);
+    } else {
+        body(tbb::blocked_range<size_t>(0, m_active.size()));
+    }
+    
+    // Bilans des messages terminés, dans l'ordre d'injection
+    size_t kept = 0;
+    for (size_t m = 0; m < m_active.size(); ++m) {
+        if (m_active[m].finished) {
+            m_completed.push_back(m_active[m].result);
+        } else {
+            if (kept != m) {
+                m_active[kept] = std::move(m_active[m]);
+            }
+            ++kept;
+        }
+    }
+    m_active.resize(kept);
+}
+
+void DisseminationEngine::start(Message& message, const InterferenceGraph& graph, int idBound) const {
+    message.started = true;
+    
+    const int sourceId = message.result.sourceId;
+    Point2D sourcePosition;
+    if (!graph.getPosition(sourceId, sourcePosition)) {
+        // Source absente du graphe (inactive): rien n'est émis
+        message.finished = true;
+        return;
+    }
+    
+    switch (message.result.type) {
+        case MessageType::Broadcast:
+            message.result.targets = graph.getVehicleCount() - 1;
+            break;
+        case MessageType::Geocast: {
+            // Destinataires figés à l'injection: véhicules présents dans la zone
+            Point2D position;
+            for (int id : graph.getVehicleIds()) {
+                if (id != sourceId && graph.getPosition(id, position) &&
+                    bg::covered_by(position, message.region)) {
+                    message.targetIds.push_back(id);
+                }
+            }
+            std::sort(message.targetIds.begin(), message.targetIds.end());
+            message.result.targets = message.targetIds.size();
+            break;
+        }
+        case MessageType::Unicast:
+            message.result.targets = message.destinationId != sourceId ? 1 : 0;
+            break;
+    }
+    
+    message.received.assign(static_cast<size_t>(std::max(idBound, sourceId + 1) + 63) / 64, 0);
+    setBit(message.received, sourceId);
+    message.frontier.assign(1, sourceId);
+    
+    if (message.result.targets == 0) {
+        message.finished = true;
+    }
+}
+
+void DisseminationEngine::propagate(Message& message, const InterferenceGraph& graph,
+                                    double simulationTime) const {
+    auto& result = message.result;
+    auto& next = message.next;
+    
+    while (!message.finished) {
+        const double hopTime = result.createdAt + (result.hops + 1) * message.hopLatency;
+        if (hopTime > simulationTime + HOP_TIME_EPSILON) {
+            return; // Saut suivant pas encore échu
+        }
+        
+        next.clear();
+        bool destinationReached = false;
+        for (int senderId : message.frontier) {
+            const auto neighbors = graph.getNeighbors(senderId);
+            Sender sender{Point2D(), 0.0};
+            if (message.policy == RebroadcastPolicy::DistanceBased) {
+                graph.getPosition(senderId, sender.position);
+                sender.cosLat = std::cos(data::GeometryUtils::degToRad(sender.position.get<1>()));
+            }
+            ++result.transmissions;
+            result.receptions += neighbors.size();
+            
+            for (int receiverId : neighbors) {
+                if (testBit(message.received, receiverId)) continue;
+                setBit(message.received, receiverId);
+                
+                if (isTarget(message, receiverId)) {
+                    const double latency = hopTime - result.createdAt;
+                    ++result.delivered;
+                    message.latencySum += latency;
+                    result.maxLatency = std::max(result.maxLatency, latency);
+                    destinationReached = destinationReached || result.type == MessageType::Unicast;
+                }
+                
+                if (shouldRebroadcast(message, graph, sender, receiverId)) {
+                    next.push_back(receiverId);
+                }
+            }
+        }
+        
+        ++result.hops;
+        result.completedAt = hopTime;
+        message.frontier.swap(next);
+        
+        if (destinationReached || message.frontier.empty() || result.hops >= message.maxHops) {
+            message.finished = true;
+        }
+    }
+    
+    result.meanLatency = result.delivered > 0 ? message.latencySum / result.delivered : 0.0;
+    
+    // Mémoire rendue dès la fin: seuls les messages en vol gardent leur état
+    std::vector<uint64_t>().swap(message.received);
+    std::vector<int>().swap(message.frontier);
+    std::vector<int>().swap(message.next);
+    std::vector<int>().swap(message.targetIds);
+}
+
+bool DisseminationEngine::isTarget(const Message& message, int vehicleId) const {
+    switch (message.result.type) {
+        case MessageType::Broadcast:
+            return true;
+        case MessageType::Geocast:
+            return std::binary_search(message.targetIds.begin(), message.targetIds.end(), vehicleId);
+        case MessageType::Unicast:
+            return vehicleId == message.destinationId;
+    }
+    return false;
+}
+
+bool DisseminationEngine::shouldRebroadcast(const Message& message, const InterferenceGraph& graph,
+                                            const Sender& sender, int receiverId) const {
+    // Le destinataire d'un unicast ne relaie pas
+    if (message.result.type == MessageType::Unicast && receiverId == message.destinationId) {
+        return false;
+    }
+    
+    switch (message.policy) {
+        case RebroadcastPolicy::Flooding:
+            return true;
+        case RebroadcastPolicy::Probabilistic:
+            return uniformDraw(message.result.messageId, receiverId) < message.probability;
+        case RebroadcastPolicy::DistanceBased: {
+            // Un récepteur proche de l'émetteur n'apporte presque pas de couverture
+            // nouvelle. Distance locale équirectangulaire: à quelques centaines
+            // de mètres l'écart avec Haversine est négligeable, sans trigonométrie
+            Point2D receiver;
+            if (!graph.getPosition(receiverId, receiver)) {
+                return false;
+            }
+            const double dx = (receiver.get<0>() - sender.position.get<0>()) * METERS_PER_DEGREE * sender.cosLat;
+            const double dy = (receiver.get<1>() - sender.position.get<1>()) * METERS_PER_DEGREE;
+            return dx * dx + dy * dy >= message.minDistance * message.minDistance;
+        }
+    }
+    return false;
+}
+
+DisseminationEngine::Summary DisseminationEngine::getSummary() const {
+    Summary summary;
+    summary.messages = m_completed.size();
+    if (m_completed.empty()) return summary;
+    
+    size_t delivered = 0;
+    size_t transmissions = 0;
+    double latencySum = 0.0;
+    for (const auto& result : m_completed) {
+        summary.deliveryRatio += result.deliveryRatio();
+        latencySum += result.meanLatency * result.delivered;
+        delivered += result.delivered;
+        transmissions += result.transmissions;
+    }
+    
+    summary.deliveryRatio /= m_completed.size();
+    summary.meanLatency = delivered > 0 ? latencySum / delivered : 0.0;
+    summary.transmissionsPerMessage = static_cast<double>(transmissions) / m_completed.size();
+    summary.overhead = delivered > 0 ? static_cast<double>(transmissions) / delivered : 0.0;
+    return summary;
+}
+
+void DisseminationEngine::clear() {
+    m_active.clear();
+    m_completed.clear();
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,393 @@
+#include "network/GraphMetrics.hpp"
+#include "network/InterferenceGraph.hpp"
+#include "network/GraphSnapshot.hpp"
+#include "utils/Logger.hpp"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <span>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+
+// Réglages par défaut: ~2,5 s sur un seul cœur pour 100 000 véhicules de
+// degré moyen 40 (un parcours de Brandes ~140 ms, un BFS ~50 ms)
+constexpr size_t DEFAULT_CLUSTERING_SAMPLES = 2048;
+constexpr size_t DEFAULT_BETWEENNESS_SOURCES = 16;
+constexpr size_t DEFAULT_DIAMETER_SWEEPS = 4;
+
+// Flux de tirage distincts par métrique
+constexpr uint64_t CLUSTERING_STREAM = 1;
+constexpr uint64_t BETWEENNESS_STREAM = 2;
+constexpr uint64_t DIAMETER_STREAM = 3;
+
+// Exécute body sur [0, n) par blocs, via TBB ou d'un seul tenant
+template <typename Body>
+void forEachBlock(bool parallel, size_t n, size_t grain, const Body& body) {
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n, grain), body);
+    } else if (n > 0) {
+        body(tbb::blocked_range<size_t>(0, n));
+    }
+}
+
+// Nombre d'éléments communs à deux lignes triées
+size_t countCommon(std::span<const int> row1, std::span<const int> row2) {
+    size_t common = 0;
+    auto it1 = row1.begin();
+    auto it2 = row2.begin();
+    while (it1 != row1.end() && it2 != row2.end()) {
+        if (*it1 < *it2) {
+            ++it1;
+        } else if (*it2 < *it1) {
+            ++it2;
+        } else {
+            ++common;
+            ++it1;
+            ++it2;
+        }
+    }
+    return common;
+}
+
+// Coefficient de clustering local sur un graphe (ou une version publiée)
+// aux lignes triées par ID
+template <typename Graph>
+double clusteringOf(const Graph& graph, int vehicleId) {
+    const auto neighbors = graph.getNeighbors(vehicleId);
+    const size_t degree = neighbors.size();
+    if (degree < 2) return 0.0;
+    
+    // Chaque lien entre deux voisins est vu depuis ses deux extrémités
+    size_t common = 0;
+    for (int neighborId : neighbors) {
+        common += countCommon(neighbors, graph.getNeighbors(neighborId));
+    }
+    return static_cast<double>(common) / (degree * (degree - 1));
+}
+}
+
+GraphMetrics::GraphMetrics()
+    : m_clusteringSamples(DEFAULT_CLUSTERING_SAMPLES)
+    , m_betweennessSources(DEFAULT_BETWEENNESS_SOURCES)
+    , m_diameterSweeps(DEFAULT_DIAMETER_SWEEPS)
+    , m_seed(0x5EED)
+    , m_parallel(true)
+    , m_computeCount(0)
+{
+}
+
+void GraphMetrics::compute(const InterferenceGraph& graph) {
+    computeOn(graph);
+}
+
+void GraphMetrics::compute(const GraphSnapshot& snapshot) {
+    computeOn(snapshot);
+}
+
+template <typename Graph>
+void GraphMetrics::computeOn(const Graph& graph) {
+    const auto start = std::chrono::steady_clock::now();
+    
+    buildDenseIndex(graph);
+    const size_t n = m_vehicleIds.size();
+    
+    m_summary = Summary{};
+    m_summary.vehicleCount = n;
+    m_summary.linkCount = m_adjacency.size() / 2;
+    
+    // Distribution des degrés
+    m_degreeHistogram.clear();
+    for (size_t i = 0; i < n; ++i) {
+        const size_t degree = m_offsets[i + 1] - m_offsets[i];
+        if (degree >= m_degreeHistogram.size()) {
+            m_degreeHistogram.resize(degree + 1, 0);
+        }
+        ++m_degreeHistogram[degree];
+    }
+    if (n > 0) {
+        m_summary.meanDegree = static_cast<double>(m_adjacency.size()) / n;
+        m_summary.maxDegree = m_degreeHistogram.size() - 1;
+        m_summary.isolatedFraction = static_cast<double>(m_degreeHistogram[0]) / n;
+    }
+    
+    computeClustering(graph, sample(m_clusteringSamples, CLUSTERING_STREAM));
+    computeBetweenness(sample(m_betweennessSources, BETWEENNESS_STREAM));
+    computeDiameter(sample(m_diameterSweeps, DIAMETER_STREAM));
+    
+    ++m_computeCount;
+    m_summary.computeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Graph>
+void GraphMetrics::buildDenseIndex(const Graph& graph) {
+    const auto vehicleIds = graph.getVehicleIds();
+    const size_t n = vehicleIds.size();
+    m_vehicleIds.assign(vehicleIds.begin(), vehicleIds.end());
+    
+    const int idBound = vehicleIds.empty() ? 0 : *std::max_element(vehicleIds.begin(), vehicleIds.end()) + 1;
+    m_indexOfId.assign(idBound, -1);
+    for (size_t i = 0; i < n; ++i) {
+        m_indexOfId[m_vehicleIds[i]] = static_cast<int>(i);
+    }
+    
+    // Lignes du graphe (IDs) traduites en indices denses
+    m_offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        m_offsets[i + 1] = m_offsets[i] + graph.getNeighbors(m_vehicleIds[i]).size();
+    }
+    m_adjacency.resize(m_offsets[n]);
+    forEachBlock(m_parallel, n, PARALLEL_GRAIN_SIZE, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            size_t k = m_offsets[i];
+            for (int neighborId : graph.getNeighbors(m_vehicleIds[i])) {
+                m_adjacency[k++] = m_indexOfId[neighborId];
+            }
+        }
+    });
+}
+
+std::vector<int> GraphMetrics::sample(size_t count, uint64_t stream) const {
+    const size_t n = m_vehicleIds.size();
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    if (count >= n) return indices;
+    
+    // Fisher-Yates partiel: les count premiers indices sont le tirage
+    std::mt19937_64 generator(m_seed ^ (stream << 56) ^ m_computeCount);
+    for (size_t k = 0; k < count; ++k) {
+        std::uniform_int_distribution<size_t> pick(k, n - 1);
+        std::swap(indices[k], indices[pick(generator)]);
+    }
+    indices.resize(count);
+    return indices;
+}
+
+// ============================================================================
+// Clustering
+// ============================================================================
+
+double GraphMetrics::localClustering(const InterferenceGraph& graph, int vehicleId) {
+    return clusteringOf(graph, vehicleId);
+}
+
+template <typename Graph>
+void GraphMetrics::computeClustering(const Graph& graph, const std::vector<int>& samples) {
+    m_summary.clusteringSamples = samples.size();
+    if (samples.empty()) return;
+    
+    // Valeurs rangées par échantillon puis sommées dans l'ordre: même moyenne
+    // en serial et en parallèle
+    std::vector<double> values(samples.size());
+    forEachBlock(m_parallel, samples.size(), 64, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t k = range.begin(); k != range.end(); ++k) {
+            values[k] = clusteringOf(graph, m_vehicleIds[samples[k]]);
+        }
+    });
+    m_summary.averageClustering = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+// ============================================================================
+// Parcours: intermédiarité (Brandes) et diamètre
+// ============================================================================
+
+void GraphMetrics::prepareWorkspace(Workspace& workspace) const {
+    const size_t n = m_vehicleIds.size();
+    workspace.distance.assign(n, -1);
+    workspace.pathCount.assign(n, 0.0);
+    workspace.dependency.assign(n, 0.0);
+    workspace.betweenness.assign(n, 0.0);
+    workspace.order.clear();
+    workspace.pathLengthSum = 0;
+    workspace.reachedPairs = 0;
+    workspace.eccentricity = 0;
+}
+
+void GraphMetrics::resetVisited(Workspace& workspace) {
+    for (int v : workspace.order) {
+        workspace.distance[v] = -1;
+        workspace.pathCount[v] = 0.0;
+        workspace.dependency[v] = 0.0;
+    }
+    workspace.order.clear();
+}
+
+int GraphMetrics::breadthFirst(int source, Workspace& workspace, bool countPaths) const {
+    auto& distance = workspace.distance;
+    auto& pathCount = workspace.pathCount;
+    auto& order = workspace.order;
+    
+    distance[source] = 0;
+    pathCount[source] = 1.0;
+    order.push_back(source);
+    for (size_t head = 0; head < order.size(); ++head) {
+        const int v = order[head];
+        const int next = distance[v] + 1;
+        for (size_t k = m_offsets[v]; k < m_offsets[v + 1]; ++k) {
+            const int w = m_adjacency[k];
+            if (distance[w] < 0) {
+                distance[w] = next;
+                order.push_back(w);
+            }
+            if (countPaths && distance[w] == next) {
+                pathCount[w] += pathCount[v];
+            }
+        }
+    }
+    return order.back();
+}
+
+void GraphMetrics::computeBetweenness(const std::vector<int>& sources) {
+    const size_t n = m_vehicleIds.size();
+    m_summary.betweennessSources = sources.size();
+    m_betweenness.assign(n, 0.0);
+    if (sources.empty()) return;
+    
+    for (Workspace& workspace : m_workspaces) {
+        prepareWorkspace(workspace);
+    }
+    
+    forEachBlock(m_parallel, sources.size(), 1, [&](const tbb::blocked_range<size_t>& range) {
+        Workspace& workspace = m_workspaces.local();
+        if (workspace.distance.size() != n) {
+            prepareWorkspace(workspace);
+        }
+        auto& distance = workspace.distance;
+        auto& pathCount = workspace.pathCount;
+        auto& dependency = workspace.dependency;
+        
+        for (size_t s = range.begin(); s != range.end(); ++s) {
+            const int source = sources[s];
+            const int farthest = breadthFirst(source, workspace, true);
+            workspace.eccentricity = std::max(workspace.eccentricity, distance[farthest]);
+            workspace.reachedPairs += workspace.order.size() - 1;
+            
+            // Dépendances accumulées dans l'ordre inverse de la découverte
+            for (size_t k = workspace.order.size(); k-- > 1;) {
+                const int v = workspace.order[k];
+                workspace.pathLengthSum += distance[v];
+                for (size_t e = m_offsets[v]; e < m_offsets[v + 1]; ++e) {
+                    const int w = m_adjacency[e];
+                    if (distance[w] == distance[v] + 1) {
+                        dependency[v] += pathCount[v] / pathCount[w] * (1.0 + dependency[w]);
+                    }
+                }
+                workspace.betweenness[v] += dependency[v];
+            }
+            resetVisited(workspace);
+        }
+    });
+    
+    uint64_t pathLengthSum = 0;
+    uint64_t reachedPairs = 0;
+    for (const Workspace& workspace : m_workspaces) {
+        for (size_t i = 0; i < n; ++i) {
+            m_betweenness[i] += workspace.betweenness[i];
+        }
+        pathLengthSum += workspace.pathLengthSum;
+        reachedPairs += workspace.reachedPairs;
+        m_summary.diameter = std::max(m_summary.diameter, workspace.eccentricity);
+    }
+    if (reachedPairs > 0) {
+        m_summary.averagePathLength = static_cast<double>(pathLengthSum) / reachedPairs;
+    }
+    
+    // Extrapolation à n sources; chaque paire non orientée est comptée depuis
+    // ses deux extrémités: normalisation par (n - 1)(n - 2)
+    const double scale = n > 2 ? static_cast<double>(n) / sources.size() / ((n - 1.0) * (n - 2.0)) : 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        m_betweenness[i] *= scale;
+        if (m_betweenness[i] > m_summary.maxBetweenness) {
+            m_summary.maxBetweenness = m_betweenness[i];
+            m_summary.maxBetweennessVehicle = m_vehicleIds[i];
+        }
+    }
+}
+
+void GraphMetrics::computeDiameter(const std::vector<int>& starts) {
+    const size_t n = m_vehicleIds.size();
+    if (starts.empty()) return;
+    
+    // Double balayage: l'excentricité du véhicule le plus éloigné du départ
+    std::vector<int> eccentricities(starts.size(), 0);
+    forEachBlock(m_parallel, starts.size(), 1, [&](const tbb::blocked_range<size_t>& range) {
+        Workspace& workspace = m_workspaces.local();
+        if (workspace.distance.size() != n) {
+            prepareWorkspace(workspace);
+        }
+        for (size_t s = range.begin(); s != range.end(); ++s) {
+            const int farthest = breadthFirst(starts[s], workspace, false);
+            resetVisited(workspace);
+            eccentricities[s] = workspace.distance[breadthFirst(farthest, workspace, false)];
+            resetVisited(workspace);
+        }
+    });
+    m_summary.diameter = std::max(m_summary.diameter, *std::max_element(eccentricities.begin(), eccentricities.end()));
+}
+
+// ============================================================================
+// Résultats
+// ============================================================================
+
+double GraphMetrics::getBetweenness(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_indexOfId.size() ||
+        m_betweenness.empty() || m_indexOfId[vehicleId] < 0) {
+        return 0.0;
+    }
+    return m_betweenness[m_indexOfId[vehicleId]];
+}
+
+std::vector<std::pair<int, double>> GraphMetrics::getTopBetweenness(size_t count) const {
+    std::vector<std::pair<int, double>> top;
+    for (size_t i = 0; i < m_betweenness.size(); ++i) {
+        if (m_betweenness[i] > 0.0) {
+            top.emplace_back(m_vehicleIds[i], m_betweenness[i]);
+        }
+    }
+    count = std::min(count, top.size());
+    std::partial_sort(top.begin(), top.begin() + count, top.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    top.resize(count);
+    return top;
+}
+
+void GraphMetrics::logSummary() const {
+    LOG_INFO(QString("Graph metrics: %1 vehicles, %2 links, degree mean %3 max %4, isolated %5%")
+             .arg(m_summary.vehicleCount)
+             .arg(m_summary.linkCount)
+             .arg(m_summary.meanDegree, 0, 'f', 2)
+             .arg(m_summary.maxDegree)
+             .arg(m_summary.isolatedFraction * 100.0, 0, 'f', 1));
+    LOG_INFO(QString("Graph metrics: clustering %1 (%2 samples), diameter >= %3 hops, "
+                     "mean path %4 hops, max betweenness %5 (vehicle %6, %7 sources), %8 ms")
+             .arg(m_summary.averageClustering, 0, 'f', 3)
+             .arg(m_summary.clusteringSamples)
+             .arg(m_summary.diameter)
+             .arg(m_summary.averagePathLength, 0, 'f', 2)
+             .arg(m_summary.maxBetweenness, 0, 'f', 4)
+             .arg(m_summary.maxBetweennessVehicle)
+             .arg(m_summary.betweennessSources)
+             .arg(m_summary.computeMs, 0, 'f', 1));
+}
+
+void GraphMetrics::clear() {
+    m_vehicleIds.clear();
+    m_indexOfId.clear();
+    m_offsets.clear();
+    m_adjacency.clear();
+    m_degreeHistogram.clear();
+    m_betweenness.clear();
+    m_summary = Summary{};
+    m_workspaces.clear();
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,494 @@
+#include "network/GraphSnapshot.hpp"
+#include "data/GeometryUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr double METERS_PER_DEGREE =
+    data::GeometryUtils::EARTH_RADIUS_M * data::GeometryUtils::PI / 180.0;
+
+// Grille des requêtes spatiales: véhicules par cellule en moyenne, côté
+// minimal d'une cellule, nombre maximal de cellules par côté (scènes très étirées)
+constexpr double QUERY_VEHICLES_PER_CELL = 2.0;
+constexpr double QUERY_MIN_CELL_METERS = 10.0;
+constexpr double QUERY_MAX_CELLS_PER_SIDE = 4096.0;
+
+// Rayon de départ minimal des kNN (scènes très denses ou k = 1)
+constexpr double MIN_NEAREST_REACH_METERS = 10.0;
+
+// Centre ou sommet utilisable: une boîte NaN passe bg::intersects et ses
+// indices de cellule seraient indéfinis
+bool isFinite(const Point2D& point) {
+    return std::isfinite(point.get<0>()) && std::isfinite(point.get<1>());
+}
+}
+
+// ============================================================================
+// GraphSnapshot
+// ============================================================================
+
+int GraphSnapshot::indexOf(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_indexOfId.size()) {
+        return -1;
+    }
+    return m_indexOfId[vehicleId];
+}
+
+std::span<const int> GraphSnapshot::getNeighbors(int vehicleId) const {
+    const int index = indexOf(vehicleId);
+    if (index < 0) {
+        return {};
+    }
+    
+    return std::span<const int>(m_neighborIds.data() + m_rowOffsets[index],
+                                m_rowOffsets[index + 1] - m_rowOffsets[index]);
+}
+
+bool GraphSnapshot::getPosition(int vehicleId, Point2D& position) const {
+    const int index = indexOf(vehicleId);
+    if (index < 0) {
+        return false;
+    }
+    position = m_positions[index];
+    return true;
+}
+
+bool GraphSnapshot::areConnected(int vehicleId1, int vehicleId2) const {
+    auto neighbors = getNeighbors(vehicleId1);
+    return std::binary_search(neighbors.begin(), neighbors.end(), vehicleId2);
+}
+
+void GraphSnapshot::buildSpatialIndex(const LinkFrame& frame) {
+    const size_t n = m_positions.size();
+    m_cellOf.resize(n);
+    m_cellOrder.resize(n);
+    if (n == 0) {
+        m_cols = m_rows = 0;
+        m_cellStart.assign(1, 0);
+        m_cellFrame.assignPermuted(frame, {});
+        m_cellPositions.clear();
+        m_cellVehicleIds.clear();
+        m_bounds = Box(Point2D(0.0, 0.0), Point2D(0.0, 0.0));
+        m_areaPerVehicle = 0.0;
+        return;
+    }
+    
+    double minLon = std::numeric_limits<double>::max(), maxLon = -minLon;
+    double minLat = minLon, maxLat = -minLon;
+    for (const Point2D& position : m_positions) {
+        minLon = std::min(minLon, position.get<0>());
+        maxLon = std::max(maxLon, position.get<0>());
+        minLat = std::min(minLat, position.get<1>());
+        maxLat = std::max(maxLat, position.get<1>());
+    }
+    m_bounds = Box(Point2D(minLon, minLat), Point2D(maxLon, maxLat));
+    
+    const double cosMid = std::max(std::cos(data::GeometryUtils::degToRad(0.5 * (minLat + maxLat))), 1e-6);
+    const double width = (maxLon - minLon) * METERS_PER_DEGREE * cosMid;
+    const double height = (maxLat - minLat) * METERS_PER_DEGREE;
+    m_areaPerVehicle = std::max(width * height, 1.0) / n;
+    
+    // Cellules carrées (en mètres) de QUERY_VEHICLES_PER_CELL véhicules en
+    // moyenne: une requête lit quelques lignes de quelques cellules
+    const double cellMeters = std::max(std::sqrt(m_areaPerVehicle * QUERY_VEHICLES_PER_CELL),
+                                       QUERY_MIN_CELL_METERS);
+    m_cellLat = cellMeters / METERS_PER_DEGREE;
+    m_cellLon = m_cellLat / cosMid;
+    m_cols = static_cast<int>(std::min((maxLon - minLon) / m_cellLon, QUERY_MAX_CELLS_PER_SIDE)) + 1;
+    m_rows = static_cast<int>(std::min((maxLat - minLat) / m_cellLat, QUERY_MAX_CELLS_PER_SIDE)) + 1;
+    
+    // Tri par cellule en O(n) (comptage puis placement)
+    m_cellStart.assign(static_cast<size_t>(m_cols) * m_rows + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const int col = std::min(static_cast<int>((m_positions[i].get<0>() - minLon) / m_cellLon), m_cols - 1);
+        const int row = std::min(static_cast<int>((m_positions[i].get<1>() - minLat) / m_cellLat), m_rows - 1);
+        m_cellOf[i] = static_cast<uint32_t>(row) * m_cols + col;
+        ++m_cellStart[m_cellOf[i] + 1];
+    }
+    for (size_t c = 1; c < m_cellStart.size(); ++c) {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        m_cellOrder[m_cellStart[m_cellOf[i]]++] = static_cast<int>(i);
+    }
+    for (size_t c = m_cellStart.size() - 1; c > 0; --c) {
+        m_cellStart[c] = m_cellStart[c - 1];
+    }
+    m_cellStart[0] = 0;
+    
+    m_cellFrame.assignPermuted(frame, m_cellOrder);
+    m_cellPositions.resize(n);
+    m_cellVehicleIds.resize(n);
+    for (size_t p = 0; p < n; ++p) {
+        m_cellPositions[p] = m_positions[m_cellOrder[p]];
+        m_cellVehicleIds[p] = m_vehicleIds[m_cellOrder[p]];
+    }
+}
+
+Box GraphSnapshot::searchBox(const Point2D& center, double meters) const {
+    using data::GeometryUtils;
+    
+    // Un degré de longitude ne fait que cos(lat) degré de latitude: pris au
+    // bord du disque le plus proche du pôle, ou à la latitude de référence
+    // en Planar (où les x sont mis à cette échelle)
+    const double halfLat = meters / METERS_PER_DEGREE;
+    const double edgeLat = std::min(std::abs(center.get<1>()) + halfLat, 90.0);
+    double cosLat = std::cos(GeometryUtils::degToRad(edgeLat));
+    if (m_cellFrame.metric() == LinkMetric::Planar) {
+        cosLat = m_cellFrame.referenceCosLat();
+    }
+    const double halfLon = halfLat / std::max(cosLat, 1e-6);
+    
+    return Box(Point2D(center.get<0>() - halfLon, center.get<1>() - halfLat),
+               Point2D(center.get<0>() + halfLon, center.get<1>() + halfLat));
+}
+
+template <typename Visitor>
+void GraphSnapshot::forEachRun(const Box& box, Visitor&& visitor) const {
+    if (m_cols == 0 || !bg::intersects(box, m_bounds)) {
+        return;
+    }
+    
+    auto cellIndex = [](double value, double origin, double size, int count) {
+        return std::clamp(static_cast<int>(std::floor((value - origin) / size)), 0, count - 1);
+    };
+    const double lon0 = m_bounds.min_corner().get<0>();
+    const double lat0 = m_bounds.min_corner().get<1>();
+    const int x0 = cellIndex(box.min_corner().get<0>(), lon0, m_cellLon, m_cols);
+    const int x1 = cellIndex(box.max_corner().get<0>(), lon0, m_cellLon, m_cols);
+    const int y0 = cellIndex(box.min_corner().get<1>(), lat0, m_cellLat, m_rows);
+    const int y1 = cellIndex(box.max_corner().get<1>(), lat0, m_cellLat, m_rows);
+    
+    // Cellules x0..x1 d'une ligne consécutives dans l'ordre de tri: un bloc par ligne
+    for (int y = y0; y <= y1; ++y) {
+        const size_t rowBase = static_cast<size_t>(y) * m_cols;
+        const uint32_t begin = m_cellStart[rowBase + x0];
+        const uint32_t end = m_cellStart[rowBase + x1 + 1];
+        if (begin < end) {
+            visitor(begin, end);
+        }
+    }
+}
+
+void GraphSnapshot::nearest(const Point2D& center, size_t k, std::vector<NearVehicle>& out,
+                            int excludeId) const {
+    out.clear();
+    if (k == 0 || m_cellVehicleIds.empty() || !isFinite(center)) {
+        return;
+    }
+    
+    double cx, cy, cz;
+    m_cellFrame.project(center.get<1>(), center.get<0>(), cx, cy, cz);
+    
+    // Disque contenant ~2k véhicules à la densité moyenne de la scène, doublé
+    // tant qu'il en contient moins de k. Exact: tout véhicule hors du disque
+    // est plus loin que les k trouvés dedans. Distances gardées au carré, dans
+    // le repère, jusqu'au tri
+    double reach = std::max(std::sqrt(2.0 * k * m_areaPerVehicle / data::GeometryUtils::PI),
+                            MIN_NEAREST_REACH_METERS);
+    for (;;) {
+        out.clear();
+        const Box box = searchBox(center, reach);
+        
+        // Boîte couvrant toute la scène: dernier tour, tous les véhicules comptent
+        const bool lastRound = bg::covered_by(m_bounds, box);
+        const double limit = m_cellFrame.lengthOf(reach);
+        const double limit2 = lastRound ? std::numeric_limits<double>::infinity() : limit * limit;
+        
+        forEachRun(box, [&](uint32_t begin, uint32_t end) {
+            // Écriture inconditionnelle, taille avancée selon le test: pas de
+            // branche imprévisible par candidat
+            size_t size = out.size();
+            out.resize(size + (end - begin));
+            for (uint32_t p = begin; p < end; ++p) {
+                const double dx = m_cellFrame.x[p] - cx;
+                const double dy = m_cellFrame.y[p] - cy;
+                const double dz = m_cellFrame.z[p] - cz;
+                const double d2 = dx * dx + dy * dy + dz * dz;
+                out[size] = {m_cellVehicleIds[p], d2};
+                size += (d2 <= limit2) & (m_cellVehicleIds[p] != excludeId);
+            }
+            out.resize(size);
+        });
+        
+        if (out.size() >= k || lastRound) {
+            break;
+        }
+        reach *= 2.0;
+    }
+    
+    const size_t count = std::min(k, out.size());
+    std::partial_sort(out.begin(), out.begin() + count, out.end(),
+        [](const NearVehicle& a, const NearVehicle& b) {
+            if (a.distance != b.distance) return a.distance < b.distance;
+            return a.vehicleId < b.vehicleId;
+        });
+    out.resize(count);
+    for (NearVehicle& found : out) {
+        found.distance = m_cellFrame.metersOf(std::sqrt(found.distance));
+    }
+}
+
+void GraphSnapshot::withinRing(const Point2D& center, double minMeters, double maxMeters,
+                               std::vector<int>& out) const {
+    out.clear();
+    if (!isFinite(center) || !std::isfinite(maxMeters) || maxMeters < std::max(minMeters, 0.0)) {
+        return;
+    }
+    
+    double cx, cy, cz;
+    m_cellFrame.project(center.get<1>(), center.get<0>(), cx, cy, cz);
+    const double inner = minMeters > 0.0 ? m_cellFrame.lengthOf(minMeters) : 0.0;
+    const double outer = m_cellFrame.lengthOf(maxMeters);
+    const double inner2 = inner * inner;
+    const double outer2 = outer * outer;
+    
+    forEachRun(searchBox(center, maxMeters), [&](uint32_t begin, uint32_t end) {
+        size_t size = out.size();
+        out.resize(size + (end - begin));
+        for (uint32_t p = begin; p < end; ++p) {
+            const double dx = m_cellFrame.x[p] - cx;
+            const double dy = m_cellFrame.y[p] - cy;
+            const double dz = m_cellFrame.z[p] - cz;
+            const double d2 = dx * dx + dy * dy + dz * dz;
+            out[size] = m_cellVehicleIds[p];
+            size += (d2 >= inner2) & (d2 <= outer2);
+        }
+        out.resize(size);
+    });
+    
+    std::sort(out.begin(), out.end());
+}
+
+void GraphSnapshot::withinPolygon(const Polygon2D& polygon, std::vector<int>& out) const {
+    out.clear();
+    if (polygon.outer().empty()) {
+        return;
+    }
+    
+    // Sommet non fini: polygone indéfini (l'enveloppe l'ignorerait), aucun véhicule
+    const auto finiteRing = [](const auto& ring) {
+        return std::all_of(ring.begin(), ring.end(), isFinite);
+    };
+    if (!finiteRing(polygon.outer())
+        || !std::all_of(polygon.inners().begin(), polygon.inners().end(), finiteRing)) {
+        return;
+    }
+    
+    forEachRun(bg::return_envelope<Box>(polygon), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t p = begin; p < end; ++p) {
+            if (bg::covered_by(m_cellPositions[p], polygon)) {
+                out.push_back(m_cellVehicleIds[p]);
+            }
+        }
+    });
+    
+    std::sort(out.begin(), out.end());
+}
+
+void GraphSnapshot::alongRoute(std::span<const Point2D> route, double halfWidthMeters,
+                               std::vector<int>& out) const {
+    out.clear();
+    if (!std::isfinite(halfWidthMeters) || halfWidthMeters < 0.0) {
+        return;
+    }
+    
+    const double width2 = halfWidthMeters * halfWidthMeters;
+    
+    auto visitSegment = [&](const Point2D& a, const Point2D& b) {
+        // Boîtes des extrémités réunies: la latitude la plus proche du pôle
+        // le long du segment est celle d'une extrémité
+        Box box = searchBox(a, halfWidthMeters);
+        bg::expand(box, searchBox(b, halfWidthMeters));
+        
+        // Projection locale (mètres) centrée sur a, échelle de longitude
+        // prise au milieu du segment
+        const double kx = METERS_PER_DEGREE * std::cos(data::GeometryUtils::degToRad(
+            0.5 * (a.get<1>() + b.get<1>())));
+        const double bx = (b.get<0>() - a.get<0>()) * kx;
+        const double by = (b.get<1>() - a.get<1>()) * METERS_PER_DEGREE;
+        const double length2 = bx * bx + by * by;
+        
+        forEachRun(box, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t p = begin; p < end; ++p) {
+                const double px = (m_cellPositions[p].get<0>() - a.get<0>()) * kx;
+                const double py = (m_cellPositions[p].get<1>() - a.get<1>()) * METERS_PER_DEGREE;
+                
+                // Projeté sur le segment, borné à ses extrémités
+                const double t = length2 > 0.0
+                    ? std::clamp((px * bx + py * by) / length2, 0.0, 1.0) : 0.0;
+                const double dx = px - t * bx;
+                const double dy = py - t * by;
+                if (dx * dx + dy * dy <= width2) {
+                    out.push_back(m_cellVehicleIds[p]);
+                }
+            }
+        });
+    };
+    
+    // Points non finis ignorés: la polyligne relie les points finis restants
+    auto nextFinite = [&](size_t from) {
+        while (from < route.size() && !isFinite(route[from])) ++from;
+        return from;
+    };
+    
+    // Un itinéraire d'un seul point est un disque autour de lui
+    const size_t first = nextFinite(0);
+    for (size_t s = first; s < route.size();) {
+        const size_t next = nextFinite(s + 1);
+        if (next < route.size()) {
+            visitSegment(route[s], route[next]);
+        } else if (s == first) {
+            visitSegment(route[s], route[s]);
+        }
+        s = next;
+    }
+    
+    // Segments consécutifs: un véhicule proche d'un sommet est trouvé deux fois
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// ============================================================================
+// SnapshotHandle
+// ============================================================================
+
+SnapshotHandle::SnapshotHandle(SnapshotHandle&& other) noexcept
+    : m_publisher(other.m_publisher)
+    , m_slot(other.m_slot)
+    , m_snapshot(other.m_snapshot)
+{
+    other.m_publisher = nullptr;
+    other.m_snapshot = nullptr;
+}
+
+SnapshotHandle& SnapshotHandle::operator=(SnapshotHandle&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_publisher = other.m_publisher;
+        m_slot = other.m_slot;
+        m_snapshot = other.m_snapshot;
+        other.m_publisher = nullptr;
+        other.m_snapshot = nullptr;
+    }
+    return *this;
+}
+
+void SnapshotHandle::release() {
+    if (m_publisher) {
+        m_publisher->releaseSlot(m_slot);
+        m_publisher = nullptr;
+        m_snapshot = nullptr;
+    }
+}
+
+// ============================================================================
+// SnapshotPublisher
+// ============================================================================
+
+SnapshotPublisher::SnapshotPublisher()
+    : m_current(new GraphSnapshot())
+    , m_epoch(1)
+    , m_version(0)
+    , m_reclaimed(0)
+{
+    // Version 0: graphe vide (un lecteur obtient toujours une version)
+    m_current.load()->m_rowOffsets.assign(1, 0);
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+    // Plus aucun lecteur à ce stade (le graphe est détruit)
+    delete m_current.load();
+    for (auto& [snapshot, epoch] : m_retired) {
+        delete snapshot;
+    }
+    for (GraphSnapshot* snapshot : m_pool) {
+        delete snapshot;
+    }
+}
+
+SnapshotHandle SnapshotPublisher::acquire() const {
+    // Point de départ propre au thread: des lecteurs concurrents visent des
+    // emplacements (et lignes de cache) différents
+    static thread_local const size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+    
+    for (size_t attempt = 0;; ++attempt) {
+        const size_t slot = (hint + attempt) % MAX_READERS;
+        
+        // Époque inscrite avant la lecture du pointeur (ordre séquentiel):
+        // toute version remplacée après cette inscription reste intacte
+        uint64_t expected = 0;
+        const uint64_t epoch = m_epoch.load();
+        if (m_slots[slot].epoch.compare_exchange_strong(expected, epoch)) {
+            return SnapshotHandle(this, slot, m_current.load());
+        }
+        
+        if (attempt % MAX_READERS == MAX_READERS - 1) {
+            std::this_thread::yield(); // Tous les emplacements occupés
+        }
+    }
+}
+
+void SnapshotPublisher::releaseSlot(size_t slot) const {
+    m_slots[slot].epoch.store(0, std::memory_order_release);
+}
+
+GraphSnapshot* SnapshotPublisher::beginWrite() {
+    reclaim();
+    if (m_pool.empty()) {
+        return new GraphSnapshot();
+    }
+    GraphSnapshot* snapshot = m_pool.back();
+    m_pool.pop_back();
+    return snapshot;
+}
+
+void SnapshotPublisher::publish(GraphSnapshot* snapshot) {
+    snapshot->m_version = ++m_version;
+    
+    // Remplie avant l'échange: un lecteur qui obtient le pointeur voit la version complète
+    GraphSnapshot* previous = m_current.exchange(snapshot);
+    const uint64_t retireEpoch = m_epoch.fetch_add(1);
+    m_retired.emplace_back(previous, retireEpoch);
+    
+    reclaim();
+}
+
+void SnapshotPublisher::reclaim() {
+    if (m_retired.empty()) return;
+    
+    // Plus petite époque inscrite: les lecteurs d'époque > e ont lu le
+    // pointeur après le remplacement des versions retirées à l'époque e
+    uint64_t oldestReader = std::numeric_limits<uint64_t>::max();
+    for (const ReaderSlot& slot : m_slots) {
+        const uint64_t epoch = slot.epoch.load();
+        if (epoch != 0) {
+            oldestReader = std::min(oldestReader, epoch);
+        }
+    }
+    
+    auto kept = m_retired.begin();
+    for (auto it = m_retired.begin(); it != m_retired.end(); ++it) {
+        if (it->second >= oldestReader) {
+            *kept++ = *it;
+            continue;
+        }
+        
+        ++m_reclaimed;
+        if (m_pool.size() < MAX_POOLED) {
+            m_pool.push_back(it->first);
+        } else {
+            delete it->first;
+        }
+    }
+    m_retired.erase(kept, m_retired.end());
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,292 @@
+#include "network/InterferenceField.hpp"
+#include "network/PropagationModel.hpp"
+#include "data/GeometryUtils.hpp"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Mètres par degré de latitude (même rayon terrestre que Haversine)
+constexpr double METERS_PER_DEGREE =
+    data::GeometryUtils::EARTH_RADIUS_M * data::GeometryUtils::PI / 180.0;
+
+// Émetteurs visés par cellule fine: compromis entre termes exacts et nœuds visités
+constexpr double TARGET_TRANSMITTERS_PER_CELL = 8.0;
+constexpr double MIN_CELL_METERS = 25.0;
+
+// Borne du nombre de cellules fines (mémoire O(n) même sur de grandes zones)
+constexpr size_t MAX_CELLS_PER_TRANSMITTER = 4;
+constexpr size_t MIN_MAX_CELLS = 4096;
+
+// Cellules fines par tâche TBB (quelques émetteurs chacune)
+constexpr size_t PARALLEL_GRAIN_CELLS = 64;
+
+// Pile de la descente: au plus 3 nœuds en attente par niveau (+ 4 au dernier)
+constexpr int MAX_STACK = 128;
+}
+
+InterferenceField::InterferenceField()
+    : m_model(nullptr)
+    , m_openingAngle(0.5)
+    , m_cellMeters(0.0)
+    , m_evaluations(0)
+{
+}
+
+void InterferenceField::setOpeningAngle(double theta) {
+    m_openingAngle = std::max(theta, 0.0);
+}
+
+void InterferenceField::build(std::span<const Point2D> positions, std::span<const double> txPowerMw,
+                              const PropagationModel& model) {
+    m_model = &model;
+    const size_t n = positions.size();
+    m_x.resize(n);
+    m_y.resize(n);
+    m_power.assign(txPowerMw.begin(), txPowerMw.end());
+    m_levels.clear();
+    if (n == 0) {
+        m_cellOf.clear();
+        m_cellStart.assign(1, 0);
+        m_members.clear();
+        return;
+    }
+    
+    // Plan local: origine au coin sud-ouest, cos(lat) pris au centre de la zone
+    double minLon = positions[0].get<0>(), maxLon = minLon;
+    double minLat = positions[0].get<1>(), maxLat = minLat;
+    for (const auto& position : positions) {
+        minLon = std::min(minLon, position.get<0>());
+        maxLon = std::max(maxLon, position.get<0>());
+        minLat = std::min(minLat, position.get<1>());
+        maxLat = std::max(maxLat, position.get<1>());
+    }
+    const double cosLat = std::cos(data::GeometryUtils::degToRad(0.5 * (minLat + maxLat)));
+    for (size_t i = 0; i < n; ++i) {
+        m_x[i] = (positions[i].get<0>() - minLon) * METERS_PER_DEGREE * cosLat;
+        m_y[i] = (positions[i].get<1>() - minLat) * METERS_PER_DEGREE;
+    }
+    const double width = (maxLon - minLon) * METERS_PER_DEGREE * cosLat;
+    const double height = (maxLat - minLat) * METERS_PER_DEGREE;
+    
+    // Taille des cellules fines: densité moyenne visée, nombre de cellules borné
+    const double area = std::max(width * height, 1.0);
+    const size_t maxCells = std::max(n * MAX_CELLS_PER_TRANSMITTER, MIN_MAX_CELLS);
+    m_cellMeters = std::max({std::sqrt(area * TARGET_TRANSMITTERS_PER_CELL / n),
+                             std::sqrt(area / maxCells),
+                             MIN_CELL_METERS});
+    int cols = static_cast<int>(width / m_cellMeters) + 1;
+    int rows = static_cast<int>(height / m_cellMeters) + 1;
+    // Zone très allongée: l'arrondi peut dépasser la borne, on élargit les cellules
+    while (static_cast<size_t>(cols) * rows > maxCells) {
+        m_cellMeters *= 2.0;
+        cols = static_cast<int>(width / m_cellMeters) + 1;
+        rows = static_cast<int>(height / m_cellMeters) + 1;
+    }
+    
+    // Tri par cellule (comptage), l'ordre des index est conservé dans chaque cellule
+    const size_t cellCount = static_cast<size_t>(cols) * rows;
+    m_cellOf.resize(n);
+    m_cellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const int cx = std::min(static_cast<int>(m_x[i] / m_cellMeters), cols - 1);
+        const int cy = std::min(static_cast<int>(m_y[i] / m_cellMeters), rows - 1);
+        m_cellOf[i] = cy * cols + cx;
+        ++m_cellStart[m_cellOf[i] + 1];
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_members.resize(n);
+    std::vector<size_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        m_members[cursor[m_cellOf[i]]++] = static_cast<int>(i);
+    }
+    m_memberX.resize(n);
+    m_memberY.resize(n);
+    m_memberPower.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        m_memberX[k] = m_x[m_members[k]];
+        m_memberY[k] = m_y[m_members[k]];
+        m_memberPower[k] = m_power[m_members[k]];
+    }
+    
+    // Niveau 0: puissance et barycentre de chaque cellule
+    Level base;
+    base.cols = cols;
+    base.rows = rows;
+    base.cellMeters = m_cellMeters;
+    base.nodes.resize(cellCount);
+    for (size_t i = 0; i < n; ++i) {
+        Node& node = base.nodes[m_cellOf[i]];
+        node.power += m_power[i];
+        node.x += m_power[i] * m_x[i];
+        node.y += m_power[i] * m_y[i];
+    }
+    for (auto& node : base.nodes) {
+        if (node.power > 0.0) {
+            node.x /= node.power;
+            node.y /= node.power;
+        }
+    }
+    m_levels.push_back(std::move(base));
+    
+    // Niveaux supérieurs: fusion 2x2 jusqu'à la racine
+    while (m_levels.back().cols > 1 || m_levels.back().rows > 1) {
+        const Level& child = m_levels.back();
+        Level parent;
+        parent.cols = (child.cols + 1) / 2;
+        parent.rows = (child.rows + 1) / 2;
+        parent.cellMeters = child.cellMeters * 2.0;
+        parent.nodes.resize(static_cast<size_t>(parent.cols) * parent.rows);
+        
+        for (int y = 0; y < child.rows; ++y) {
+            for (int x = 0; x < child.cols; ++x) {
+                const Node& source = child.nodes[y * child.cols + x];
+                if (source.power <= 0.0) continue;
+                Node& target = parent.nodes[(y / 2) * parent.cols + x / 2];
+                target.power += source.power;
+                target.x += source.power * source.x;
+                target.y += source.power * source.y;
+            }
+        }
+        for (auto& node : parent.nodes) {
+            if (node.power > 0.0) {
+                node.x /= node.power;
+                node.y /= node.power;
+            }
+        }
+        m_levels.push_back(std::move(parent));
+    }
+}
+
+void InterferenceField::computeReceivedPower(std::span<double> receivedMw, bool parallel) {
+    m_evaluations = 0;
+    if (m_levels.empty()) {
+        return;
+    }
+    
+    for (auto& list : m_interactionLists) {
+        list.evaluations = 0;
+    }
+    
+    // Une tâche par bloc de cellules fines: la liste d'interactions est
+    // construite une fois par cellule, puis évaluée pour chacun de ses récepteurs
+    const size_t cellCount = m_cellStart.size() - 1;
+    auto body = [&](const tbb::blocked_range<size_t>& range) {
+        auto& list = m_interactionLists.local();
+        for (size_t cell = range.begin(); cell != range.end(); ++cell) {
+            if (m_cellStart[cell] == m_cellStart[cell + 1]) continue;
+            buildInteractionList(cell, list);
+            
+            for (size_t q = m_cellStart[cell]; q < m_cellStart[cell + 1]; ++q) {
+                const double rx = m_memberX[q];
+                const double ry = m_memberY[q];
+                double total = 0.0;
+                
+                for (size_t f = 0; f < list.x.size(); ++f) {
+                    const double dx = list.x[f] - rx;
+                    const double dy = list.y[f] - ry;
+                    total += list.power[f] * m_model->pathGain(std::sqrt(dx * dx + dy * dy));
+                }
+                
+                for (const auto& [begin, end] : list.nearRanges) {
+                    for (size_t k = begin; k < end; ++k) {
+                        if (k == q) continue;
+                        const double dx = m_memberX[k] - rx;
+                        const double dy = m_memberY[k] - ry;
+                        total += m_memberPower[k] * m_model->pathGain(std::sqrt(dx * dx + dy * dy));
+                    }
+                }
+                
+                receivedMw[m_members[q]] = total;
+                list.evaluations += list.x.size() + list.nearCount - 1;
+            }
+        }
+    };
+    
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, cellCount, PARALLEL_GRAIN_CELLS), body);
+    } else {
+        body(tbb::blocked_range<size_t>(0, cellCount));
+    }
+    
+    for (const auto& list : m_interactionLists) {
+        m_evaluations += list.evaluations;
+    }
+}
+
+void InterferenceField::buildInteractionList(size_t cell, InteractionList& list) const {
+    list.x.clear();
+    list.y.clear();
+    list.power.clear();
+    list.nearRanges.clear();
+    list.nearCount = 0;
+    
+    // Critère évalué depuis le centre de la cellule, diminué de sa demi-diagonale:
+    // il vaut pour le récepteur le moins favorable de la cellule
+    const int cols0 = m_levels[0].cols;
+    const int cellCol = static_cast<int>(cell) % cols0;
+    const int cellRow = static_cast<int>(cell) / cols0;
+    const double centerX = (cellCol + 0.5) * m_cellMeters;
+    const double centerY = (cellRow + 0.5) * m_cellMeters;
+    const double halfDiagonal = m_cellMeters * std::sqrt(0.5);
+    
+    struct Entry { int level; int x; int y; };
+    Entry stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = {static_cast<int>(m_levels.size()) - 1, 0, 0};
+    
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        const Level& level = m_levels[entry.level];
+        const Node& node = level.nodes[entry.y * level.cols + entry.x];
+        if (node.power <= 0.0) continue;
+        
+        // Nœud ne contenant pas la cellule et vu sous un angle assez petit:
+        // un seul terme au barycentre
+        const bool containsCell = (cellCol >> entry.level) == entry.x &&
+                                  (cellRow >> entry.level) == entry.y;
+        if (!containsCell) {
+            const double distance = std::hypot(node.x - centerX, node.y - centerY) - halfDiagonal;
+            if (distance > 0.0 && level.cellMeters < m_openingAngle * distance) {
+                list.x.push_back(node.x);
+                list.y.push_back(node.y);
+                list.power.push_back(node.power);
+                continue;
+            }
+        }
+        
+        if (entry.level == 0) {
+            // Cellule proche: somme exacte; cellules voisines d'une même ligne
+            // contiguës dans m_members -> plages fusionnées
+            const size_t nearCell = static_cast<size_t>(entry.y) * level.cols + entry.x;
+            const size_t begin = m_cellStart[nearCell];
+            const size_t end = m_cellStart[nearCell + 1];
+            if (!list.nearRanges.empty() && list.nearRanges.back().second == begin) {
+                list.nearRanges.back().second = end;
+            } else if (!list.nearRanges.empty() && list.nearRanges.back().first == end) {
+                list.nearRanges.back().first = begin;
+            } else {
+                list.nearRanges.emplace_back(begin, end);
+            }
+            list.nearCount += end - begin;
+            continue;
+        }
+        
+        // Ouverture: enfants présents au niveau inférieur (bords de grille impairs)
+        const Level& child = m_levels[entry.level - 1];
+        for (int cy = 2 * entry.y; cy <= std::min(2 * entry.y + 1, child.rows - 1); ++cy) {
+            for (int cx = 2 * entry.x; cx <= std::min(2 * entry.x + 1, child.cols - 1); ++cx) {
+                stack[top++] = {entry.level - 1, cx, cy};
+            }
+        }
+    }
+}
+
+} // namespace network
+} // namespace v2v
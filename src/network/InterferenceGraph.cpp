@@ -1,79 +1,1081 @@
 #include "network/InterferenceGraph.hpp"
+#include "network/PropagationModel.hpp"
+#include "network/InterferenceField.hpp"
+#include "network/BuildingIndex.hpp"
+#include "network/GraphSnapshot.hpp"
 #include "core/Vehicle.hpp"
 #include "data/GeometryUtils.hpp"
 #include "utils/Logger.hpp"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <limits>
 
 namespace v2v {
 namespace network {
 
+namespace {
+// Mètres par degré de latitude, cohérent avec le rayon terrestre de la
+// distance de Haversine (sinon la boîte de recherche rate les voisins en bordure)
+constexpr double METERS_PER_DEGREE =
+    data::GeometryUtils::EARTH_RADIUS_M * data::GeometryUtils::PI / 180.0;
+
+// En dessous de ce nombre de véhicules, le coût de TBB dépasse le gain
+constexpr size_t PARALLEL_MIN_VEHICLES = 1024;
+constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+
+// Mode paresseux: taille d'un bloc de rangement des lignes (IDs)
+constexpr size_t LAZY_CHUNK_SIZE = 1 << 16;
+
+// Borne du nombre de cellules de la grille (mémoire O(n) même sur de grandes zones)
+constexpr size_t GRID_MAX_CELLS_PER_VEHICLE = 4;
+constexpr size_t GRID_MIN_CELLS = 4096;
+
+// Listes de Verlet: la boîte de recherche (rayon en arc) couvre un peu plus
+// que le rayon en corde + skin des listes (arc > corde de ~1e-6 m à 1 km)
+constexpr double VERLET_QUERY_MARGIN_METERS = 1.0;
+
+// Quantification des positions pour le cache de visibilité: au plus ~3.5 m
+// d'écart au centre de la cellule, et une cellule quittée tous les quelques
+// updates à vitesse urbaine
+constexpr double LOS_CELL_METERS = 5.0;
+constexpr double LOS_CELL_DEGREES = LOS_CELL_METERS / METERS_PER_DEGREE;
+
+// Cache de visibilité (16 Mo, alloué avec les bâtiments): groupes de 4
+// entrées, l'entrée la moins récemment utilisée du groupe est remplacée.
+// Entrée = étiquette (48 bits) | update de dernier usage (8 bits) |
+// compte arrêté à la limite demandée (1 bit) | murs + 1 (7 bits, 0 = vide)
+constexpr size_t LOS_CACHE_SLOTS = size_t(1) << 21;
+constexpr size_t LOS_CACHE_WAYS = 4;
+constexpr uint64_t LOS_TAG_MASK = ~uint64_t(0xFFFF);
+constexpr uint64_t LOS_SATURATED = 0x80;
+constexpr uint64_t LOS_COUNT_MASK = 0x7F;
+constexpr int LOS_MAX_COUNTED_WALLS = 126;
+
+// Cellule quantifiée (colonne, ligne) empaquetée sur 64 bits. Les lignes
+// sont des bandes de latitude; dans chaque ligne la largeur en longitude est
+// corrigée par cos(lat) au centre de la ligne (cellules carrées)
+double losRowCos(int32_t row) {
+    return std::cos(data::GeometryUtils::degToRad((row + 0.5) * LOS_CELL_DEGREES));
+}
+
+uint64_t losCell(const Point2D& position) {
+    const auto row = static_cast<int32_t>(std::floor(position.get<1>() / LOS_CELL_DEGREES));
+    const auto column = static_cast<int32_t>(std::floor(position.get<0>() * losRowCos(row) / LOS_CELL_DEGREES));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(column)) << 32) | static_cast<uint32_t>(row);
+}
+
+Point2D losCellCenter(uint64_t cell) {
+    const auto column = static_cast<int32_t>(static_cast<uint32_t>(cell >> 32));
+    const auto row = static_cast<int32_t>(static_cast<uint32_t>(cell));
+    return Point2D((column + 0.5) * LOS_CELL_DEGREES / losRowCos(row), (row + 0.5) * LOS_CELL_DEGREES);
+}
+
+// Finaliseur SplitMix64: chaque bit de sortie dépend de tous les bits d'entrée
+uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Tirage uniforme dans [0, 1) figé par paire de véhicules (SplitMix64 sur les
+// deux IDs ordonnés): même résultat des deux côtés du lien et à chaque update
+double pairDraw(int vehicleId1, int vehicleId2) {
+    const auto [low, high] = std::minmax(vehicleId1, vehicleId2);
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(low)) << 32)
+               | static_cast<uint32_t>(high);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<double>(z >> 11) * 0x1.0p-53;
+}
+
+// Instanciation du noyau de découverte: métrique et rayon (LinkKernel),
+// affinage du masque (ombrage, bâtiments) ou décision du noyau seule
+template <LinkMetric Metric, LinkRadius Radius, bool Refine>
+struct KernelPolicy {
+    static constexpr LinkMetric metric = Metric;
+    static constexpr LinkRadius radius = Radius;
+    static constexpr bool refine = Refine;
+};
+
+template <LinkMetric Metric, LinkRadius Radius, typename Visitor>
+void visitRefine(bool refine, Visitor& visitor) {
+    if (refine) {
+        visitor(KernelPolicy<Metric, Radius, true>{});
+    } else {
+        visitor(KernelPolicy<Metric, Radius, false>{});
+    }
+}
+
+// Exécute body sur [0, n) par blocs, via TBB ou d'un seul tenant
+template <typename Body>
+void forEachBlock(bool parallel, size_t n, const Body& body) {
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n, PARALLEL_GRAIN_SIZE), body);
+    } else if (n > 0) {
+        body(tbb::blocked_range<size_t>(0, n));
+    }
+}
+}
+
 InterferenceGraph::InterferenceGraph()
-    : m_rtree(std::make_unique<RTree>())
+    : m_radiusClasses(false)
+    , m_shadowing(false)
+    , m_losEpoch(0)
+    , m_obstruction(false)
+    , m_wallLossDb(0.0)
+    , m_losQueries(0)
+    , m_losTests(0)
+    , m_interferenceField(std::make_unique<InterferenceField>())
+    , m_sinrMode(false)
+    , m_sinrThresholdDb(5.0)     // 802.11p QPSK 1/2 (6 Mbit/s)
+    , m_noiseFloorDbm(-98.0)     // Bruit thermique sur 10 MHz + facteur de bruit 6 dB
+    , m_transmitterActivity(1.0)
+    , m_interferenceTerms(0)
+    , m_radiusPolicy(LinkRadius::PerVehicle)
+    , m_activeRadiusPolicy(LinkRadius::PerVehicle)
+    , m_snapshots(std::make_unique<SnapshotPublisher>())
+    , m_nextSubscriptionId(0)
+    , m_linkCount(0)
+    , m_lastUpdateTime(0.0)
+    , m_parallelDiscovery(true)
+    , m_enumerationMode(EnumerationMode::FullNeighbour)
+    , m_distanceEvaluations(0)
+    , m_verletSkin(0.0)
+    , m_verletValid(false)
+    , m_verletUpdates(0)
+    , m_verletRebuilds(0)
+    , m_verletRebuilt(false)
+    , m_lazy(false)
+    , m_complete(true)
+    , m_lazyReadyCapacity(0)
+    , m_lazyChunk(0)
+    , m_lazyRowCount(0)
 {
     LOG_INFO("InterferenceGraph created");
 }
 
-void InterferenceGraph::update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles) {
-    // Clear previous state
-    m_connections.clear();
-    m_vehiclePositions.clear();
+InterferenceGraph::~InterferenceGraph() = default;
+
+void InterferenceGraph::update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles,
+                               double simulationTime) {
+    // Le graphe courant devient le graphe précédent (pour le diff), le reste
+    // est vidé (les buffers gardent leur capacité d'un update à l'autre).
+    // Après un update paresseux, le précédent reste le dernier graphe complet.
+    if (m_complete) {
+        swapToPrevious();
+    } else {
+        resetCurrent();
+    }
+    m_positions.clear();
     m_transmissionRadii.clear();
+    m_linkBudgets.clear();
+    m_txPowerMw.clear();
+    m_interferenceMw.clear();
+    m_losCells.clear();
+    m_frame.clear();
+    
+    m_obstruction = m_buildings && !m_buildings->empty();
+    ++m_losEpoch;
+    
+    // Avec ombrage, un lien reste possible au-delà du rayon nominal: la
+    // recherche s'étend jusqu'à la portée où sa probabilité devient négligeable
+    const PropagationModel* model = linkModel();
+    m_shadowing = model && !model->isDeterministic();
     
-    // Update vehicle positions
+    // Assign dense indices to active vehicles
     for (const auto& vehicle : vehicles) {
         if (!vehicle->isActive()) continue;
         
         int id = vehicle->getId();
+        if (id < 0) continue;
+        if (static_cast<size_t>(id) >= m_indexOfId.size()) {
+            m_indexOfId.resize(id + 1, -1);
+        }
+        
         QPointF pos = vehicle->getPosition();
-        Point2D point(pos.x(), pos.y());
+        m_indexOfId[id] = static_cast<int>(m_vehicleIds.size());
+        m_vehicleIds.push_back(id);
+        m_positions.emplace_back(pos.x(), pos.y());
+        if (m_obstruction) {
+            m_losCells.push_back(losCell(m_positions.back()));
+        }
         
-        m_vehiclePositions[id] = point;
-        m_transmissionRadii[id] = vehicle->getTransmissionRadius();
+        double searchRadius = vehicle->getTransmissionRadius();
+        if (model) {
+            const double budget = model->pathLossDb(vehicle->getTransmissionRadius());
+            m_linkBudgets.push_back(budget);
+            if (m_sinrMode) {
+                const double txPowerDbm = model->getParameters().sensitivityDbm + budget;
+                m_txPowerMw.push_back(std::pow(10.0, txPowerDbm / 10.0));
+            }
+            if (m_shadowing) {
+                searchRadius = model->maxRange(budget);
+            }
+        }
+        m_transmissionRadii.push_back(searchRadius);
+        m_frame.push(pos.y(), pos.x(), searchRadius);
     }
     
-    // Rebuild R-tree
-    rebuildRTree();
+    // Seuil constant seulement si tous les rayons de recherche sont égaux
+    m_activeRadiusPolicy = m_radiusPolicy == LinkRadius::Uniform && m_frame.hasUniformRadius()
+                         ? LinkRadius::Uniform : LinkRadius::PerVehicle;
+    
+    for (auto& buffers : m_threadBuffers) {
+        buffers.evaluations = 0;
+        buffers.losQueries = 0;
+        buffers.losTests = 0;
+    }
+    
+    // Mode paresseux sans abonné: index spatial seul, lignes à la demande
+    // (le filtre SINR dépend de tous les émetteurs: toujours complet)
+    m_complete = !m_lazy || m_sinrMode || !m_listeners.empty();
+    if (m_vehicleIds.size() > m_lazyReadyCapacity) {
+        m_lazyReadyCapacity = std::max(m_vehicleIds.size(), 2 * m_lazyReadyCapacity);
+        m_lazyReady = std::make_unique<std::atomic<uint8_t>[]>(m_lazyReadyCapacity);
+    }
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        m_lazyReady[i].store(0, std::memory_order_relaxed);
+    }
+    m_lazyRows.resize(m_vehicleIds.size());
+    m_lazyChunk = 0;
+    m_lazyRowCount = 0;
+    for (auto& chunk : m_lazyChunks) {
+        chunk.clear();
+    }
+    if (!m_complete) {
+        rebuildRTree();
+        m_rowOffsets.assign(m_vehicleIds.size() + 1, 0);
+        m_linkEvents.clear();
+        m_lastUpdateTime = simulationTime;
+        publishSnapshot();
+        return;
+    }
     
     // Find connections
-    // Two vehicles connect if one vehicle's position is inside the other's transmission radius
-    // This means: distance <= min(radius1, radius2) OR we check both directions
-    // For V2V: both vehicles must be able to reach each other, so distance <= min(radius1, radius2)
-    for (const auto& vehicle : vehicles) {
-        if (!vehicle->isActive()) continue;
-        
-        int id = vehicle->getId();
-        double radius1 = vehicle->getTransmissionRadius(); // in meters
-        
-        // Query neighbors with search radius (in degrees, approximate)
-        // Convert meters to degrees for search: 1 degree ≈ 111320 meters
-        const double metersPerDegree = 111320.0;
-        double searchRadiusDegrees = radius1 / metersPerDegree;
-        
-        auto candidates = queryNeighbors(id, searchRadiusDegrees);
+    const bool parallel = m_parallelDiscovery && m_vehicleIds.size() >= PARALLEL_MIN_VEHICLES;
+    if (m_verletSkin > 0.0) {
+        buildAdjacencyVerlet(parallel);
+    } else if (m_enumerationMode == EnumerationMode::HalfPair) {
+        rebuildGrid();
+        buildAdjacencyHalfPair(parallel);
+    } else {
+        rebuildRTree();
+        buildAdjacencyFull(parallel);
+    }
+    
+    m_interferenceTerms = 0;
+    if (m_sinrMode) {
+        applySinrFilter(parallel);
+    }
+    
+    m_distanceEvaluations = 0;
+    m_losQueries = 0;
+    m_losTests = 0;
+    for (const auto& buffers : m_threadBuffers) {
+        m_distanceEvaluations += buffers.evaluations;
+        m_losQueries += buffers.losQueries;
+        m_losTests += buffers.losTests;
+    }
+    
+    publishLinkEvents(simulationTime);
+    publishSnapshot();
+}
+
+template <typename Visitor>
+void InterferenceGraph::dispatchKernel(Visitor&& visitor) const {
+    const bool refine = m_shadowing || m_obstruction;
+    const bool uniform = m_activeRadiusPolicy == LinkRadius::Uniform;
+    
+    if (m_frame.metric() == LinkMetric::Planar) {
+        if (uniform) {
+            visitRefine<LinkMetric::Planar, LinkRadius::Uniform>(refine, visitor);
+        } else {
+            visitRefine<LinkMetric::Planar, LinkRadius::PerVehicle>(refine, visitor);
+        }
+    } else {
+        if (uniform) {
+            visitRefine<LinkMetric::Chord, LinkRadius::Uniform>(refine, visitor);
+        } else {
+            visitRefine<LinkMetric::Chord, LinkRadius::PerVehicle>(refine, visitor);
+        }
+    }
+}
+
+void InterferenceGraph::swapToPrevious() {
+    m_previousVehicleIds.swap(m_vehicleIds);
+    m_previousIndexOfId.swap(m_indexOfId);
+    m_previousRowOffsets.swap(m_rowOffsets);
+    m_previousNeighborIds.swap(m_neighborIds);
+    resetCurrent();
+}
+
+void InterferenceGraph::resetCurrent() {
+    m_vehicleIds.clear();
+    m_rowOffsets.assign(1, 0);
+    m_neighborIds.clear();
+    m_indexOfId.assign(std::max(m_indexOfId.size(), m_previousIndexOfId.size()), -1);
+}
+
+void InterferenceGraph::publishLinkEvents(double timestamp) {
+    m_linkEvents.clear();
+    m_lastUpdateTime = timestamp;
+    
+    size_t linksUp = 0;
+    size_t linksDown = 0;
+    auto emitEvent = [&](LinkEvent::Type type, int id1, int id2) {
+        m_linkEvents.push_back({type, id1, id2, timestamp});
+        ++(type == LinkEvent::Type::Up ? linksUp : linksDown);
+    };
+    
+    // Voisins d'ID supérieur à id dans une ligne triée: chaque lien n'est vu
+    // qu'une fois, depuis son extrémité d'ID le plus petit
+    auto upperRow = [](const std::vector<int>& neighborIds, const std::vector<size_t>& rowOffsets,
+                       size_t index, int id) {
+        auto begin = neighborIds.begin() + rowOffsets[index];
+        auto end = neighborIds.begin() + rowOffsets[index + 1];
+        return std::span<const int>(std::upper_bound(begin, end, id), end);
+    };
+    
+    // 1) Véhicules déjà présents: fusion de l'ancienne et de la nouvelle ligne
+    //    (vide si le véhicule a été retiré)
+    for (size_t p = 0; p < m_previousVehicleIds.size(); ++p) {
+        const int id = m_previousVehicleIds[p];
+        const auto before = upperRow(m_previousNeighborIds, m_previousRowOffsets, p, id);
+        const int index = indexOf(id);
+        const auto after = index >= 0 ? upperRow(m_neighborIds, m_rowOffsets, index, id)
+                                      : std::span<const int>();
         
-        std::unordered_set<int> connectedNeighbors;
-        for (int candidateId : candidates) {
-            // Find the candidate vehicle to get its radius
-            auto candidateIt = std::find_if(vehicles.begin(), vehicles.end(),
-                [candidateId](const auto& v) { return v->getId() == candidateId && v->isActive(); });
-            
-            if (candidateIt == vehicles.end()) continue;
+        auto a = before.begin();
+        auto b = after.begin();
+        while (a != before.end() && b != after.end()) {
+            if (*a < *b) {
+                emitEvent(LinkEvent::Type::Down, id, *a++);
+            } else if (*b < *a) {
+                emitEvent(LinkEvent::Type::Up, id, *b++);
+            } else {
+                ++a;
+                ++b;
+            }
+        }
+        for (; a != before.end(); ++a) emitEvent(LinkEvent::Type::Down, id, *a);
+        for (; b != after.end(); ++b) emitEvent(LinkEvent::Type::Up, id, *b);
+    }
+    
+    // 2) Véhicules apparus depuis l'update précédent: tous leurs liens sont nouveaux
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        const int id = m_vehicleIds[i];
+        if (static_cast<size_t>(id) < m_previousIndexOfId.size() && m_previousIndexOfId[id] >= 0) {
+            continue;
+        }
+        for (int neighborId : upperRow(m_neighborIds, m_rowOffsets, i, id)) {
+            emitEvent(LinkEvent::Type::Up, id, neighborId);
+        }
+    }
+    
+    m_linkCount = m_linkCount + linksUp - linksDown;
+    
+    if (m_linkEvents.empty()) {
+        return;
+    }
+    
+    // Sur une copie: un listener peut (se) désabonner ou abonner pendant
+    // l'appel; un abonné retiré entre-temps ne reçoit plus ce delta, un
+    // nouvel abonné ne le reçoit pas
+    const auto listeners = m_listeners;
+    for (const auto& [subscriptionId, listener] : listeners) {
+        const bool subscribed = std::any_of(m_listeners.begin(), m_listeners.end(),
+                                            [id = subscriptionId](const auto& entry) { return entry.first == id; });
+        if (subscribed) {
+            listener(m_linkEvents);
+        }
+    }
+}
+
+void InterferenceGraph::publishSnapshot() {
+    // Tampon recyclé: assign réutilise sa capacité, pas d'allocation en régime établi
+    GraphSnapshot* snapshot = m_snapshots->beginWrite();
+    snapshot->m_vehicleIds.assign(m_vehicleIds.begin(), m_vehicleIds.end());
+    snapshot->m_indexOfId.assign(m_indexOfId.begin(), m_indexOfId.end());
+    snapshot->m_rowOffsets.assign(m_rowOffsets.begin(), m_rowOffsets.end());
+    snapshot->m_neighborIds.assign(m_neighborIds.begin(), m_neighborIds.end());
+    snapshot->m_positions.assign(m_positions.begin(), m_positions.end());
+    snapshot->m_linkCount = m_complete ? m_linkCount : 0;
+    snapshot->m_complete = m_complete;
+    snapshot->m_updateTime = m_lastUpdateTime;
+    snapshot->buildSpatialIndex(m_frame);
+    m_snapshots->publish(snapshot);
+}
+
+SnapshotHandle InterferenceGraph::acquireSnapshot() const {
+    return m_snapshots->acquire();
+}
+
+uint64_t InterferenceGraph::getSnapshotVersion() const {
+    return m_snapshots->getVersion();
+}
+
+int InterferenceGraph::subscribe(LinkEventListener listener) {
+    const int subscriptionId = m_nextSubscriptionId++;
+    m_listeners.emplace_back(subscriptionId, std::move(listener));
+    return subscriptionId;
+}
+
+void InterferenceGraph::unsubscribe(int subscriptionId) {
+    std::erase_if(m_listeners, [subscriptionId](const auto& entry) {
+        return entry.first == subscriptionId;
+    });
+}
+
+void InterferenceGraph::buildAdjacencyFull(bool parallel) {
+    const size_t n = m_vehicleIds.size();
+    
+    // 1) Découverte par blocs de véhicules: chaque thread écrit ses lignes à la
+    //    suite dans son propre buffer et note où chacune commence
+    for (auto& buffers : m_threadBuffers) {
+        buffers.neighbors.clear();
+    }
+    
+    std::vector<const std::vector<int>*> rowSource(n);
+    std::vector<size_t> rowBegin(n);
+    std::vector<size_t> degree(n);
+    
+    dispatchKernel([&](auto policy) {
+        using Policy = decltype(policy);
+        forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+            auto& local = m_threadBuffers.local();
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                const size_t begin = local.neighbors.size();
+                collectNeighbors<Policy>(static_cast<int>(i), local, local.neighbors);
+                rowSource[i] = &local.neighbors;
+                rowBegin[i] = begin;
+                degree[i] = local.neighbors.size() - begin;
+            }
+        });
+    });
+    
+    // 2) Offsets CSR par scan (somme préfixe) des degrés
+    const size_t total = computeRowOffsets(degree, parallel);
+    
+    // 3) Copie des lignes à leur place définitive
+    m_neighborIds.resize(total);
+    forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const int* src = rowSource[i]->data() + rowBegin[i];
+            std::copy(src, src + degree[i], m_neighborIds.begin() + m_rowOffsets[i]);
+        }
+    });
+}
+
+void InterferenceGraph::buildAdjacencyHalfPair(bool parallel) {
+    const size_t n = m_vehicleIds.size();
+    
+    // 1) Chaque paire i < j testée une fois: arêtes dans des buffers par thread
+    for (auto& buffers : m_threadBuffers) {
+        buffers.edges.clear();
+    }
+    
+    dispatchKernel([&](auto policy) {
+        using Policy = decltype(policy);
+        forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+            auto& local = m_threadBuffers.local();
+            // Parcours dans l'ordre de la grille pour la localité mémoire
+            for (size_t p = range.begin(); p != range.end(); ++p) {
+                collectHalfPairs<Policy>(p, local);
+            }
+        });
+    });
+    
+    // 2) Degrés (chaque arête compte pour ses deux extrémités) puis offsets
+    std::vector<size_t> degree(n, 0);
+    for (auto& buffers : m_threadBuffers) {
+        const auto& edges = buffers.edges;
+        forEachBlock(parallel, edges.size(), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t e = range.begin(); e != range.end(); ++e) {
+                std::atomic_ref<size_t>(degree[edges[e].first]).fetch_add(1, std::memory_order_relaxed);
+                std::atomic_ref<size_t>(degree[edges[e].second]).fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    
+    const size_t total = computeRowOffsets(degree, parallel);
+    
+    // 3) Écriture des deux lignes de chaque arête, puis tri de chaque ligne
+    //    (même contenu et même ordre qu'en mode FullNeighbour)
+    m_neighborIds.resize(total);
+    std::vector<size_t> cursor(m_rowOffsets.begin(), m_rowOffsets.end() - 1);
+    for (auto& buffers : m_threadBuffers) {
+        const auto& edges = buffers.edges;
+        forEachBlock(parallel, edges.size(), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t e = range.begin(); e != range.end(); ++e) {
+                const auto [a, b] = edges[e];
+                m_neighborIds[std::atomic_ref<size_t>(cursor[a]).fetch_add(1, std::memory_order_relaxed)] = m_vehicleIds[b];
+                m_neighborIds[std::atomic_ref<size_t>(cursor[b]).fetch_add(1, std::memory_order_relaxed)] = m_vehicleIds[a];
+            }
+        });
+    }
+    
+    forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            std::sort(m_neighborIds.begin() + m_rowOffsets[i], m_neighborIds.begin() + m_rowOffsets[i + 1]);
+        }
+    });
+}
+
+void InterferenceGraph::buildAdjacencyVerlet(bool parallel) {
+    ++m_verletUpdates;
+    m_verletRebuilt = !verletListsValid();
+    if (m_verletRebuilt) {
+        rebuildVerletLists(parallel);
+        ++m_verletRebuilds;
+    }
+    
+    // Seul le test exact est refait: lignes construites comme en mode
+    // FullNeighbour, candidats lus dans les listes (collectNeighbors)
+    buildAdjacencyFull(parallel);
+}
+
+bool InterferenceGraph::verletListsValid() {
+    if (!m_verletValid) {
+        return false;
+    }
+    if (m_verletIds != m_vehicleIds && !remapVerletLists()) {
+        return false;
+    }
+    
+    // Un lien actuel (corde <= min(r1, r2)) était à moins de min(r1, r2) + skin
+    // à la construction si aucune extrémité n'a bougé de plus de skin / 2
+    // (inégalité triangulaire sur les cordes) et si les rayons n'ont pas
+    // augmenté. Déplacements mesurés en corde, d'un repère à l'autre par
+    // différence des origines
+    const double dox = m_frame.originX() - m_verletFrame.originX();
+    const double doy = m_frame.originY() - m_verletFrame.originY();
+    const double doz = m_frame.originZ() - m_verletFrame.originZ();
+    const double limit = 0.25 * m_verletSkin * m_verletSkin;
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        if (m_frame.chordRadius[i] + m_verletSkin > m_verletFrame.chordRadius[i]) {
+            return false;
+        }
+        const double dx = m_frame.x[i] + dox - m_verletFrame.x[i];
+        const double dy = m_frame.y[i] + doy - m_verletFrame.y[i];
+        const double dz = m_frame.z[i] + doz - m_verletFrame.z[i];
+        if (dx * dx + dy * dy + dz * dz > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InterferenceGraph::remapVerletLists() {
+    const size_t n = m_vehicleIds.size();
+    
+    // Ancien index -> index courant (-1: véhicule retiré); un véhicule apparu
+    // n'est dans aucune liste, il faut reconstruire
+    std::vector<int> newIndex(m_verletIds.size());
+    std::vector<int> oldIndex(n, -1);
+    size_t kept = 0;
+    for (size_t o = 0; o < m_verletIds.size(); ++o) {
+        newIndex[o] = indexOf(m_verletIds[o]);
+        if (newIndex[o] >= 0) {
+            oldIndex[newIndex[o]] = static_cast<int>(o);
+            ++kept;
+        }
+    }
+    if (kept != n) {
+        return false;
+    }
+    
+    // Lignes et repère figé réordonnés selon les index courants
+    std::vector<size_t> offsets(n + 1, 0);
+    std::vector<int> candidates;
+    candidates.reserve(m_verletCandidates.size());
+    LinkFrame frame;
+    frame.assignPermuted(m_verletFrame, oldIndex);
+    for (size_t i = 0; i < n; ++i) {
+        const int o = oldIndex[i];
+        for (size_t k = m_verletOffsets[o]; k < m_verletOffsets[o + 1]; ++k) {
+            const int j = newIndex[m_verletCandidates[k]];
+            if (j >= 0) {
+                candidates.push_back(j);
+            }
+        }
+        offsets[i + 1] = candidates.size();
+    }
+    
+    m_verletOffsets.swap(offsets);
+    m_verletCandidates.swap(candidates);
+    m_verletFrame = std::move(frame);
+    m_verletIds = m_vehicleIds;
+    return true;
+}
+
+void InterferenceGraph::rebuildVerletLists(bool parallel) {
+    const size_t n = m_vehicleIds.size();
+    rebuildRTree();
+    
+    // Repère figé: positions de la construction, rayons (corde) + skin
+    m_verletFrame = m_frame;
+    for (double& radius : m_verletFrame.chordRadius) {
+        radius += m_verletSkin;
+    }
+    
+    for (auto& buffers : m_threadBuffers) {
+        buffers.neighbors.clear();
+    }
+    
+    std::vector<const std::vector<int>*> rowSource(n);
+    std::vector<size_t> rowBegin(n);
+    std::vector<size_t> degree(n);
+    
+    forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+        auto& local = m_threadBuffers.local();
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const int index = static_cast<int>(i);
             
-            const auto& candidateVehicle = *candidateIt;
-            double radius2 = candidateVehicle->getTransmissionRadius(); // in meters
+            // d <= min(r1, r2) + skin: rayon propre et classes de rayon bornent la recherche
+            queryCandidates(index, m_transmissionRadii[i], m_verletSkin + VERLET_QUERY_MARGIN_METERS,
+                            local.candidates);
+            local.candidateIndices.clear();
+            for (const auto& [point, candidate] : local.candidates) {
+                if (candidate != index) {
+                    local.candidateIndices.push_back(candidate);
+                }
+            }
+            local.evaluations += local.candidateIndices.size();
             
-            // Calculate actual distance in meters using Haversine
-            double distMeters = distanceInMeters(id, candidateId);
+            const size_t begin = local.neighbors.size();
+            for (size_t blockBegin = 0; blockBegin < local.candidateIndices.size(); blockBegin += LinkKernel::BLOCK_SIZE) {
+                const size_t blockSize = std::min(LinkKernel::BLOCK_SIZE, local.candidateIndices.size() - blockBegin);
+                const int* block = local.candidateIndices.data() + blockBegin;
+                // Noyau Chord valable pour les deux métriques (z nul en Planar)
+                for (uint64_t mask = m_activeRadiusPolicy == LinkRadius::Uniform
+                         ? LinkKernel::qualifyBlockWith<LinkMetric::Chord, LinkRadius::Uniform>(m_verletFrame, index, block, blockSize)
+                         : LinkKernel::qualifyBlock(m_verletFrame, index, block, blockSize);
+                     mask != 0; mask &= mask - 1) {
+                    local.neighbors.push_back(block[std::countr_zero(mask)]);
+                }
+            }
             
-            // Connect if the distance is within BOTH vehicles' radii
-            // This means both vehicles can reach each other (bidirectional communication)
-            // Vehicle B is inside Vehicle A's radius AND Vehicle A is inside Vehicle B's radius
-            if (distMeters <= radius1 && distMeters <= radius2) {
-                connectedNeighbors.insert(candidateId);
+            // Indices croissants: accès mémoire plus réguliers à chaque update
+            std::sort(local.neighbors.begin() + begin, local.neighbors.end());
+            rowSource[i] = &local.neighbors;
+            rowBegin[i] = begin;
+            degree[i] = local.neighbors.size() - begin;
+        }
+    });
+    
+    const size_t total = prefixSum(degree, m_verletOffsets, parallel);
+    m_verletCandidates.resize(total);
+    forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const int* src = rowSource[i]->data() + rowBegin[i];
+            std::copy(src, src + degree[i], m_verletCandidates.begin() + m_verletOffsets[i]);
+        }
+    });
+    
+    m_verletIds = m_vehicleIds;
+    m_verletValid = true;
+}
+
+void InterferenceGraph::setLinkMetric(LinkMetric metric) {
+    if (metric == m_frame.metric()) return;
+    
+    // Repères successifs comparés par les listes de Verlet: même métrique requise
+    m_frame.setMetric(metric);
+    m_verletValid = false;
+    LOG_INFO(QString("InterferenceGraph: %1 link metric")
+             .arg(metric == LinkMetric::Planar ? "planar" : "chord"));
+}
+
+void InterferenceGraph::setVerletSkin(double skinMeters) {
+    m_verletSkin = std::max(skinMeters, 0.0);
+    m_verletValid = false;
+    m_verletUpdates = 0;
+    m_verletRebuilds = 0;
+    m_verletRebuilt = false;
+    if (m_verletSkin == 0.0) {
+        m_verletIds.clear();
+        m_verletOffsets.clear();
+        m_verletCandidates.clear();
+        m_verletFrame.clear();
+    } else {
+        LOG_INFO(QString("InterferenceGraph: Verlet lists with %1 m skin").arg(m_verletSkin));
+    }
+}
+
+size_t InterferenceGraph::computeRowOffsets(const std::vector<size_t>& degree, bool parallel) {
+    return prefixSum(degree, m_rowOffsets, parallel);
+}
+
+size_t InterferenceGraph::prefixSum(const std::vector<size_t>& degree, std::vector<size_t>& offsets, bool parallel) {
+    const size_t n = degree.size();
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    
+    if (!parallel) {
+        for (size_t i = 0; i < n; ++i) {
+            offsets[i + 1] = offsets[i] + degree[i];
+        }
+        return offsets[n];
+    }
+    
+    return tbb::parallel_scan(
+        tbb::blocked_range<size_t>(0, n, PARALLEL_GRAIN_SIZE),
+        size_t(0),
+        [&](const tbb::blocked_range<size_t>& range, size_t sum, bool isFinalScan) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                sum += degree[i];
+                if (isFinalScan) {
+                    offsets[i + 1] = sum;
+                }
+            }
+            return sum;
+        },
+        std::plus<size_t>());
+}
+
+template <typename Policy>
+void InterferenceGraph::collectNeighbors(int index, DiscoveryBuffers& scratch, std::vector<int>& out) const {
+    std::span<const int> candidates;
+    if (m_verletSkin > 0.0 && m_complete) {
+        // Listes de Verlet: candidats conservés depuis la construction
+        candidates = std::span<const int>(m_verletCandidates.data() + m_verletOffsets[index],
+                                          m_verletOffsets[index + 1] - m_verletOffsets[index]);
+    } else {
+        // For V2V: both vehicles must be able to reach each other, so distance <= min(radius1, radius2)
+        const double radius1 = m_transmissionRadii[index]; // in meters
+        
+        queryCandidates(index, radius1, 0.0, scratch.candidates);
+        
+        auto& candidateIndices = scratch.candidateIndices;
+        candidateIndices.clear();
+        for (const auto& [point, candidate] : scratch.candidates) {
+            if (candidate != index) {
+                candidateIndices.push_back(candidate);
             }
         }
+        candidates = candidateIndices;
+    }
+    
+    // Distance exacte (équivalente à Haversine) testée par blocs vectorisés
+    scratch.evaluations += candidates.size();
+    const size_t rowBegin = out.size();
+    for (size_t blockBegin = 0; blockBegin < candidates.size(); blockBegin += LinkKernel::BLOCK_SIZE) {
+        const size_t blockSize = std::min(LinkKernel::BLOCK_SIZE, candidates.size() - blockBegin);
+        const int* block = candidates.data() + blockBegin;
         
-        m_connections[id] = connectedNeighbors;
+        uint64_t mask = LinkKernel::qualifyBlockWith<Policy::metric, Policy::radius>(m_frame, index, block, blockSize);
+        if constexpr (Policy::refine) {
+            mask = refineBlock(index, block, mask, scratch);
+        }
+        while (mask != 0) {
+            const int bit = std::countr_zero(mask);
+            out.push_back(m_vehicleIds[block[bit]]);
+            mask &= mask - 1;
+        }
+    }
+    
+    // Lignes triées: areConnected par recherche dichotomique, sorties déterministes
+    std::sort(out.begin() + rowBegin, out.end());
+}
+
+template <typename Policy>
+void InterferenceGraph::collectHalfPairs(size_t position, DiscoveryBuffers& scratch) const {
+    const CellGrid& grid = m_grid;
+    const int index = grid.vehicles[position];
+    const int cell = grid.cellOf[index];
+    const int cx = cell % grid.cols;
+    const int cy = cell / grid.cols;
+    
+    // Un lien exige d <= min(r1, r2) <= r1: le rayon propre borne la recherche
+    const int reach = static_cast<int>(std::ceil(m_transmissionRadii[index] / grid.cellMeters));
+    const int x0 = std::max(cx - reach, 0);
+    const int x1 = std::min(cx + reach, grid.cols - 1);
+    const int yEnd = std::min(cy + reach, grid.rows - 1);
+    
+    // Demi-coquille avant: fin de la cellule courante (indices supérieurs),
+    // reste de la ligne à droite, puis lignes suivantes. Des cellules
+    // consécutives d'une même ligne sont contiguës dans grid.vehicles.
+    qualifyGridSlice<Policy>(position, position + 1, grid.cellStart[cell + 1], scratch);
+    
+    if (cx < x1) {
+        qualifyGridSlice<Policy>(position, grid.cellStart[cell + 1], grid.cellStart[cy * grid.cols + x1 + 1], scratch);
+    }
+    
+    for (int y = cy + 1; y <= yEnd; ++y) {
+        qualifyGridSlice<Policy>(position, grid.cellStart[y * grid.cols + x0], grid.cellStart[y * grid.cols + x1 + 1], scratch);
+    }
+}
+
+template <typename Policy>
+void InterferenceGraph::qualifyGridSlice(size_t position, size_t begin, size_t end, DiscoveryBuffers& scratch) const {
+    const int index = m_grid.vehicles[position];
+    scratch.evaluations += end - begin;
+    
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += LinkKernel::BLOCK_SIZE) {
+        const size_t blockSize = std::min(LinkKernel::BLOCK_SIZE, end - blockBegin);
+        const int* block = m_grid.vehicles.data() + blockBegin;
+        
+        // Candidats contigus dans le repère trié par cellule: pas de gather
+        uint64_t mask = LinkKernel::qualifyRun<Policy::metric, Policy::radius>(m_grid.frame, position, blockBegin, blockSize);
+        if constexpr (Policy::refine) {
+            mask = refineBlock(index, block, mask, scratch);
+        }
+        while (mask != 0) {
+            const int bit = std::countr_zero(mask);
+            scratch.edges.emplace_back(index, block[bit]);
+            mask &= mask - 1;
+        }
+    }
+}
+
+uint64_t InterferenceGraph::refineBlock(int index, const int* block, uint64_t mask, DiscoveryBuffers& scratch) const {
+    // Le noyau a gardé les candidats sous la portée maximale; la distance
+    // (corde, égale à Haversine au millimètre près à ces échelles) fixe la
+    // marge moyenne du lien, limitée par le plus faible des deux budgets et
+    // diminuée de l'atténuation des murs traversés
+    const PropagationModel* model = linkModel();
+    const bool attenuate = model && m_wallLossDb > 0.0;
+    const int id = m_vehicleIds[index];
+    
+    if (m_obstruction) {
+        // Groupes du cache de visibilité chargés d'avance: les latences
+        // mémoire des liens du bloc se recouvrent
+        for (uint64_t pending = mask; pending != 0; pending &= pending - 1) {
+            __builtin_prefetch(losBucket(m_losCells[index], m_losCells[block[std::countr_zero(pending)]]));
+        }
+    }
+    
+    uint64_t kept = 0;
+    while (mask != 0) {
+        const int bit = std::countr_zero(mask);
+        const int j = block[bit];
+        mask &= mask - 1;
+        
+        // Sans ombrage ni atténuation: décision du noyau, sauf obstacle
+        if (!m_shadowing && !attenuate) {
+            if (wallCrossings(index, j, 1, scratch) == 0) {
+                kept |= uint64_t(1) << bit;
+            }
+            continue;
+        }
+        
+        // Tirage figé et probabilité décroissante avec les murs: le lien est
+        // perdu à partir de wallLimit murs, inutile de compter au-delà (et de
+        // tester la visibilité d'un lien déjà perdu en espace dégagé)
+        const double margin = std::min(m_linkBudgets[index], m_linkBudgets[j])
+                            - model->pathLossDb(frameDistance(index, j));
+        const double draw = pairDraw(id, m_vehicleIds[j]);
+        int wallLimit = draw < model->linkProbability(margin) ? 1 : 0;
+        if (attenuate && m_obstruction) {
+            while (wallLimit > 0 && wallLimit < LOS_MAX_COUNTED_WALLS &&
+                   draw < model->linkProbability(margin - wallLimit * m_wallLossDb)) {
+                ++wallLimit;
+            }
+        }
+        
+        if (wallLimit > 0 && (!m_obstruction || wallCrossings(index, j, wallLimit, scratch) < wallLimit)) {
+            kept |= uint64_t(1) << bit;
+        }
+    }
+    return kept;
+}
+
+int InterferenceGraph::wallCrossings(int index1, int index2, int wallLimit, DiscoveryBuffers& scratch) const {
+    const uint64_t cell1 = m_losCells[index1];
+    const uint64_t cell2 = m_losCells[index2];
+    if (cell1 == cell2) {
+        return 0; // Même cellule: à vue
+    }
+    
+    // Paire ordonnée: même entrée depuis les deux extrémités du lien. Deux
+    // hachages indépendants: l'un choisit le groupe, l'autre forme l'étiquette
+    const auto [low, high] = std::minmax(cell1, cell2);
+    const uint64_t tag = mix64(high * 0xC2B2AE3D27D4EB4FULL ^ low) & LOS_TAG_MASK;
+    std::atomic<uint64_t>* bucket = losBucket(cell1, cell2);
+    const uint64_t epoch = static_cast<uint64_t>(m_losEpoch) << 8;
+    
+    ++scratch.losQueries;
+    size_t victim = 0;
+    uint8_t victimAge = 0;
+    for (size_t way = 0; way < LOS_CACHE_WAYS; ++way) {
+        const uint64_t entry = bucket[way].load(std::memory_order_relaxed);
+        if ((entry & LOS_COUNT_MASK) == 0) {
+            victim = way;
+            victimAge = 0xFF; // Entrée vide: remplacée en priorité
+            continue;
+        }
+        if ((entry & LOS_TAG_MASK) == tag) {
+            // Compte exact, ou compte arrêté à une limite suffisante
+            const int walls = static_cast<int>(entry & LOS_COUNT_MASK) - 1;
+            if (!(entry & LOS_SATURATED) || walls >= wallLimit) {
+                if ((entry & 0xFF00) != epoch) {
+                    bucket[way].store((entry & ~uint64_t(0xFF00)) | epoch, std::memory_order_relaxed);
+                }
+                return std::min(walls, wallLimit);
+            }
+            victim = way; // Compte insuffisant: à reprendre avec la nouvelle limite
+            break;
+        }
+        const uint8_t age = static_cast<uint8_t>(m_losEpoch - static_cast<uint8_t>(entry >> 8));
+        if (age > victimAge) {
+            victim = way;
+            victimAge = age;
+        }
+    }
+    
+    // Test sur les centres des cellules: la valeur ne dépend que de la paire
+    // (et de la limite), deux threads qui la calculent écrivent la même entrée
+    ++scratch.losTests;
+    const int walls = m_buildings->countWallCrossings(losCellCenter(low), losCellCenter(high), wallLimit);
+    const uint64_t saturated = walls >= wallLimit ? LOS_SATURATED : 0;
+    bucket[victim].store(tag | epoch | saturated | static_cast<uint64_t>(walls + 1), std::memory_order_relaxed);
+    return walls;
+}
+
+std::atomic<uint64_t>* InterferenceGraph::losBucket(uint64_t cell1, uint64_t cell2) const {
+    const auto [low, high] = std::minmax(cell1, cell2);
+    const uint64_t hash = mix64(low * 0x9E3779B97F4A7C15ULL ^ high);
+    return &m_losCache[hash & (LOS_CACHE_SLOTS - LOS_CACHE_WAYS)];
+}
+
+void InterferenceGraph::clearLosCache() {
+    if (!m_losCache) return;
+    for (size_t i = 0; i < LOS_CACHE_SLOTS; ++i) {
+        m_losCache[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void InterferenceGraph::setBuildingIndex(std::shared_ptr<const BuildingIndex> buildings) {
+    m_buildings = std::move(buildings);
+    if (m_buildings && !m_losCache) {
+        m_losCache = std::make_unique<std::atomic<uint64_t>[]>(LOS_CACHE_SLOTS);
+    }
+    clearLosCache();
+    if (m_buildings) {
+        LOG_INFO(QString("InterferenceGraph: %1 buildings obstruct links")
+                 .arg(m_buildings->getBuildingCount()));
+    }
+}
+
+void InterferenceGraph::setWallLossDb(double lossDb) {
+    m_wallLossDb = lossDb;
+}
+
+const PropagationModel* InterferenceGraph::linkModel() const {
+    if (m_propagation) {
+        return m_propagation.get();
+    }
+    if (m_sinrMode) {
+        static const PropagationModel twoRayGround(PropagationModel::Type::TwoRayGround);
+        return &twoRayGround;
+    }
+    return nullptr;
+}
+
+double InterferenceGraph::frameDistance(int index1, int index2) const {
+    // Corde: égale à Haversine au millimètre près aux distances radio
+    const double dx = m_frame.x[index2] - m_frame.x[index1];
+    const double dy = m_frame.y[index2] - m_frame.y[index1];
+    const double dz = m_frame.z[index2] - m_frame.z[index1];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void InterferenceGraph::applySinrFilter(bool parallel) {
+    const size_t n = m_vehicleIds.size();
+    const PropagationModel& model = *linkModel();
+    
+    // 1) Interférence totale reçue par chaque véhicule (agrégation lointaine)
+    m_interferenceField->build(m_positions, m_txPowerMw, model);
+    m_interferenceMw.resize(n);
+    m_interferenceField->computeReceivedPower(m_interferenceMw, parallel);
+    m_interferenceTerms = m_interferenceField->getEvaluations();
+    for (double& interference : m_interferenceMw) {
+        interference *= m_transmitterActivity;
+    }
+    
+    // 2) Chaque ligne garde les voisins décodables dans les deux sens (décision
+    //    symétrique), compactés au début de leur segment. Le gain de trajet,
+    //    symétrique, sert aux deux sens; SINR >= seuil testé sans division
+    const double noiseMw = std::pow(10.0, m_noiseFloorDbm / 10.0);
+    const double threshold = std::pow(10.0, m_sinrThresholdDb / 10.0);
+    auto decodable = [&](double signal, int receiver) {
+        const double interference = std::max(m_interferenceMw[receiver] - m_transmitterActivity * signal, 0.0);
+        return signal >= threshold * (noiseMw + interference);
+    };
+    std::vector<size_t> rowBegin(m_rowOffsets.begin(), m_rowOffsets.end() - 1);
+    std::vector<size_t> degree(n);
+    forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const int receiver = static_cast<int>(i);
+            size_t kept = m_rowOffsets[i];
+            for (size_t k = m_rowOffsets[i]; k < m_rowOffsets[i + 1]; ++k) {
+                const int neighbor = indexOf(m_neighborIds[k]);
+                const double gain = model.pathGain(frameDistance(receiver, neighbor));
+                if (decodable(m_txPowerMw[neighbor] * gain, receiver) &&
+                    decodable(m_txPowerMw[receiver] * gain, neighbor)) {
+                    m_neighborIds[kept++] = m_neighborIds[k];
+                }
+            }
+            degree[i] = kept - m_rowOffsets[i];
+        }
+    });
+    
+    // 3) Nouveaux offsets, lignes ramenées vers la gauche (ordre conservé)
+    const size_t total = computeRowOffsets(degree, parallel);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(m_neighborIds.begin() + rowBegin[i], m_neighborIds.begin() + rowBegin[i] + degree[i],
+                  m_neighborIds.begin() + m_rowOffsets[i]);
+    }
+    m_neighborIds.resize(total);
+}
+
+double InterferenceGraph::linkSinr(int transmitter, int receiver, double noiseMw) const {
+    // L'interférence totale contient le signal utile (pondéré par l'activité):
+    // il est retiré, borné à zéro (terme lointain agrégé, donc approché)
+    const double signal = m_txPowerMw[transmitter] * linkModel()->pathGain(frameDistance(transmitter, receiver));
+    const double interference = std::max(m_interferenceMw[receiver] - m_transmitterActivity * signal, 0.0);
+    return signal / (noiseMw + interference);
+}
+
+void InterferenceGraph::setTransmitterActivity(double fraction) {
+    m_transmitterActivity = std::clamp(fraction, 0.0, 1.0);
+}
+
+void InterferenceGraph::setFarFieldOpeningAngle(double theta) {
+    m_interferenceField->setOpeningAngle(theta);
+}
+
+double InterferenceGraph::getInterferenceDbm(int vehicleId) const {
+    const int index = indexOf(vehicleId);
+    if (index < 0 || static_cast<size_t>(index) >= m_interferenceMw.size()) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(m_interferenceMw[index]);
+}
+
+double InterferenceGraph::getSinrDb(int transmitterId, int receiverId) const {
+    const int transmitter = indexOf(transmitterId);
+    const int receiver = indexOf(receiverId);
+    if (transmitter < 0 || receiver < 0 || transmitter == receiver ||
+        static_cast<size_t>(std::max(transmitter, receiver)) >= m_interferenceMw.size()) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(linkSinr(transmitter, receiver, std::pow(10.0, m_noiseFloorDbm / 10.0)));
+}
+
+void InterferenceGraph::setPropagationModel(std::shared_ptr<const PropagationModel> model) {
+    m_propagation = std::move(model);
+    if (m_propagation) {
+        LOG_INFO(QString("InterferenceGraph: propagation model %1")
+                 .arg(PropagationModel::typeName(m_propagation->getType())));
     }
 }
 
@@ -83,29 +1085,142 @@ void InterferenceGraph::incrementalUpdate(const std::vector<std::shared_ptr<core
     update(movedVehicles);
 }
 
-std::vector<int> InterferenceGraph::getNeighbors(int vehicleId) const {
-    auto it = m_connections.find(vehicleId);
-    if (it != m_connections.end()) {
-        return std::vector<int>(it->second.begin(), it->second.end());
+std::span<const int> InterferenceGraph::getNeighbors(int vehicleId) const {
+    int index = indexOf(vehicleId);
+    if (index < 0) {
+        return {};
     }
-    return std::vector<int>();
+    if (!m_complete) {
+        return lazyRow(index);
+    }
+    
+    return std::span<const int>(m_neighborIds.data() + m_rowOffsets[index],
+                                m_rowOffsets[index + 1] - m_rowOffsets[index]);
 }
 
-bool InterferenceGraph::areConnected(int vehicleId1, int vehicleId2) const {
-    auto it = m_connections.find(vehicleId1);
-    if (it != m_connections.end()) {
-        return it->second.count(vehicleId2) > 0;
+std::span<const int> InterferenceGraph::lazyRow(int index) const {
+    // Ligne déjà rangée: lecture sans verrou (rangée avant la publication du drapeau)
+    if (m_lazyReady[index].load(std::memory_order_acquire)) {
+        return m_lazyRows[index];
+    }
+    
+    // Calcul hors verrou dans les tampons paresseux du thread (jamais ceux
+    // d'un materializeRegion en cours); deux threads peuvent calculer la même
+    // ligne, le premier rangé gagne
+    auto& scratch = m_lazyBuffers.local();
+    scratch.neighbors.clear();
+    dispatchKernel([&](auto policy) {
+        collectNeighbors<decltype(policy)>(index, scratch, scratch.neighbors);
+    });
+    
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    if (!m_lazyReady[index].load(std::memory_order_relaxed)) {
+        storeLazyRow(index, scratch.neighbors);
+    }
+    return m_lazyRows[index];
+}
+
+void InterferenceGraph::storeLazyRow(int index, std::span<const int> row) const {
+    // Bloc courant plein: bloc suivant (agrandi d'avance pour une ligne plus
+    // longue qu'un bloc); un bloc ne dépasse jamais sa capacité
+    while (m_lazyChunk < m_lazyChunks.size()
+           && m_lazyChunks[m_lazyChunk].capacity() - m_lazyChunks[m_lazyChunk].size() < row.size()) {
+        if (m_lazyChunks[m_lazyChunk].empty()) {
+            m_lazyChunks[m_lazyChunk].reserve(row.size());
+            break;
+        }
+        ++m_lazyChunk;
+    }
+    if (m_lazyChunk == m_lazyChunks.size()) {
+        m_lazyChunks.emplace_back().reserve(std::max(LAZY_CHUNK_SIZE, row.size()));
+    }
+    
+    auto& chunk = m_lazyChunks[m_lazyChunk];
+    const size_t begin = chunk.size();
+    chunk.insert(chunk.end(), row.begin(), row.end());
+    m_lazyRows[index] = std::span<const int>(chunk.data() + begin, row.size());
+    m_lazyReady[index].store(1, std::memory_order_release);
+    ++m_lazyRowCount;
+}
+
+size_t InterferenceGraph::materializeRegion(const Box& region) const {
+    if (m_complete || m_radiusSuffixTrees.empty()) {
+        return 0;
+    }
+    
+    std::vector<RTreeValue> hits;
+    m_radiusSuffixTrees[0].query(bgi::intersects(region), std::back_inserter(hits));
+    std::vector<int> pending;
+    for (const auto& [point, index] : hits) {
+        if (!m_lazyReady[index].load(std::memory_order_acquire)) {
+            pending.push_back(index);
+        }
+    }
+    
+    // Lignes calculées comme dans buildAdjacencyFull, sans verrou: un thread
+    // qui vole une tâche pendant le calcul peut entrer dans lazyRow. Lignes
+    // accumulées dans des tampons propres à cet appel (ceux de lazyRow sont
+    // réutilisés à chaque ligne), rangées ensuite sous le verrou.
+    const size_t n = pending.size();
+    tbb::enumerable_thread_specific<std::vector<int>> rows;
+    std::vector<const std::vector<int>*> rowSource(n);
+    std::vector<size_t> rowBegin(n);
+    std::vector<size_t> degree(n);
+    const bool parallel = m_parallelDiscovery && n >= PARALLEL_MIN_VEHICLES;
+    dispatchKernel([&](auto policy) {
+        using Policy = decltype(policy);
+        forEachBlock(parallel, n, [&](const tbb::blocked_range<size_t>& range) {
+            auto& scratch = m_lazyBuffers.local();
+            auto& local = rows.local();
+            for (size_t k = range.begin(); k != range.end(); ++k) {
+                const size_t begin = local.size();
+                collectNeighbors<Policy>(pending[k], scratch, local);
+                rowSource[k] = &local;
+                rowBegin[k] = begin;
+                degree[k] = local.size() - begin;
+            }
+        });
+    });
+    
+    size_t stored = 0;
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    for (size_t k = 0; k < n; ++k) {
+        if (!m_lazyReady[pending[k]].load(std::memory_order_relaxed)) {
+            storeLazyRow(pending[k], std::span<const int>(rowSource[k]->data() + rowBegin[k], degree[k]));
+            ++stored;
+        }
+    }
+    return stored;
+}
+
+size_t InterferenceGraph::getLazyRowCount() const {
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    return m_lazyRowCount;
+}
+
+bool InterferenceGraph::getPosition(int vehicleId, Point2D& position) const {
+    const int index = indexOf(vehicleId);
+    if (index < 0) {
+        return false;
     }
-    return false;
+    position = m_positions[index];
+    return true;
+}
+
+bool InterferenceGraph::areConnected(int vehicleId1, int vehicleId2) const {
+    auto neighbors = getNeighbors(vehicleId1);
+    return std::binary_search(neighbors.begin(), neighbors.end(), vehicleId2);
 }
 
 std::vector<std::pair<int, int>> InterferenceGraph::getAllConnections() const {
     std::vector<std::pair<int, int>> result;
+    result.reserve(getConnectionCount());
     
-    for (const auto& [id, neighbors] : m_connections) {
-        for (int neighbor : neighbors) {
-            if (id < neighbor) { // Avoid duplicates
-                result.emplace_back(id, neighbor);
+    // Update paresseux: toutes les lignes sont calculées
+    for (int id : m_vehicleIds) {
+        for (int neighborId : getNeighbors(id)) {
+            if (id < neighborId) { // Avoid duplicates
+                result.emplace_back(id, neighborId);
             }
         }
     }
@@ -114,83 +1229,211 @@ std::vector<std::pair<int, int>> InterferenceGraph::getAllConnections() const {
 }
 
 double InterferenceGraph::getAverageConnections() const {
-    if (m_connections.empty()) return 0.0;
-    
-    size_t total = 0;
-    for (const auto& [id, neighbors] : m_connections) {
-        total += neighbors.size();
-    }
+    // Même update que m_linkCount: après un update paresseux, le dernier
+    // complet (conservé comme graphe précédent)
+    const size_t vehicleCount = m_complete ? m_vehicleIds.size() : m_previousVehicleIds.size();
+    if (vehicleCount == 0) return 0.0;
     
-    return static_cast<double>(total) / m_connections.size();
+    return 2.0 * static_cast<double>(m_linkCount) / vehicleCount;
 }
 
 void InterferenceGraph::clear() {
-    m_connections.clear();
-    m_vehiclePositions.clear();
+    // Diff contre un graphe vide: les abonnés voient la rupture de tous les
+    // liens (ceux du dernier graphe complet après un update paresseux)
+    if (m_complete) {
+        swapToPrevious();
+    } else {
+        resetCurrent();
+    }
+    m_complete = true;
+    publishLinkEvents(m_lastUpdateTime);
+    
+    m_vehicleIds.clear();
+    m_indexOfId.clear();
+    m_positions.clear();
     m_transmissionRadii.clear();
-    m_rtree = std::make_unique<RTree>();
+    m_linkBudgets.clear();
+    m_txPowerMw.clear();
+    m_interferenceMw.clear();
+    m_losCells.clear();
+    m_rowOffsets.clear();
+    m_neighborIds.clear();
+    m_previousVehicleIds.clear();
+    m_previousIndexOfId.clear();
+    m_previousRowOffsets.clear();
+    m_previousNeighborIds.clear();
+    m_grid = CellGrid();
+    m_distanceEvaluations = 0;
+    m_verletValid = false;
+    m_verletIds.clear();
+    m_verletOffsets.clear();
+    m_verletCandidates.clear();
+    m_verletFrame.clear();
+    m_verletUpdates = 0;
+    m_verletRebuilds = 0;
+    m_verletRebuilt = false;
+    m_radiusSuffixTrees.clear();
+    m_radiusClassTrees.clear();
+    m_radiusClassMax.clear();
+    m_radiusClassOf.clear();
+    m_lazyRows.clear();
+    m_lazyReady.reset();
+    m_lazyReadyCapacity = 0;
+    m_lazyChunks.clear();
+    m_lazyChunk = 0;
+    m_lazyRowCount = 0;
+    
+    publishSnapshot();
+}
+
+int InterferenceGraph::indexOf(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_indexOfId.size()) {
+        return -1;
+    }
+    return m_indexOfId[vehicleId];
 }
 
 void InterferenceGraph::rebuildRTree() {
-    m_rtree = std::make_unique<RTree>();
+    const size_t n = m_positions.size();
+    
+    // Classes de rayon: une par rayon distinct (profils de véhicules). Rayons
+    // continus: une seule classe, des tranches coûtant plus en parcours
+    // d'arbres qu'elles n'épargnent en candidats
+    m_radiusClassOf.assign(n, 0);
+    m_radiusClassMax.assign(1, std::numeric_limits<double>::infinity());
+    if (m_radiusClasses && n > 0) {
+        std::vector<double> radii(m_transmissionRadii);
+        std::sort(radii.begin(), radii.end());
+        radii.erase(std::unique(radii.begin(), radii.end()), radii.end());
+        
+        if (radii.size() > 1 && radii.size() <= MAX_RADIUS_CLASSES) {
+            m_radiusClassMax = radii;
+            for (size_t i = 0; i < n; ++i) {
+                m_radiusClassOf[i] = static_cast<uint8_t>(
+                    std::lower_bound(radii.begin(), radii.end(), m_transmissionRadii[i]) - radii.begin());
+            }
+        }
+    }
+    
+    const size_t classCount = m_radiusClassMax.size();
+    std::vector<std::vector<RTreeValue>> values(classCount);
+    for (size_t i = 0; i < n; ++i) {
+        values[m_radiusClassOf[i]].emplace_back(m_positions[i], static_cast<int>(i));
+    }
     
-    for (const auto& [id, pos] : m_vehiclePositions) {
-        m_rtree->insert(std::make_pair(pos, id));
+    // Construction en bloc (packing STR): plus rapide et arbre mieux équilibré
+    // que des insertions successives. Arbres des suffixes de classes construits
+    // de la plus haute à la plus basse (la dernière classe n'a pas d'arbre seul:
+    // c'est son suffixe)
+    m_radiusSuffixTrees.resize(classCount);
+    m_radiusClassTrees.resize(classCount - 1);
+    std::vector<RTreeValue> suffix;
+    suffix.reserve(n);
+    for (size_t c = classCount; c-- > 0;) {
+        suffix.insert(suffix.end(), values[c].begin(), values[c].end());
+        m_radiusSuffixTrees[c] = RTree(suffix.begin(), suffix.end());
+        if (c + 1 < classCount) {
+            m_radiusClassTrees[c] = RTree(values[c].begin(), values[c].end());
+        }
     }
 }
 
-std::vector<int> InterferenceGraph::queryNeighbors(int vehicleId, double radius) const {
-    auto posIt = m_vehiclePositions.find(vehicleId);
-    if (posIt == m_vehiclePositions.end()) {
-        return std::vector<int>();
+void InterferenceGraph::rebuildGrid() {
+    CellGrid& grid = m_grid;
+    const size_t n = m_vehicleIds.size();
+    
+    grid.cellOf.resize(n);
+    grid.vehicles.resize(n);
+    if (n == 0) {
+        grid.cols = grid.rows = 0;
+        grid.cellStart.assign(1, 0);
+        grid.frame.clear();
+        return;
     }
     
-    const Point2D& center = posIt->second;
-    Box queryBox(
-        Point2D(center.get<0>() - radius, center.get<1>() - radius),
-        Point2D(center.get<0>() + radius, center.get<1>() + radius)
-    );
+    double minLat = std::numeric_limits<double>::max(), maxLat = -minLat;
+    double minLon = minLat, maxLon = -minLat;
+    double minRadius = std::numeric_limits<double>::max(), maxRadius = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        minLon = std::min(minLon, m_positions[i].get<0>());
+        maxLon = std::max(maxLon, m_positions[i].get<0>());
+        minLat = std::min(minLat, m_positions[i].get<1>());
+        maxLat = std::max(maxLat, m_positions[i].get<1>());
+        minRadius = std::min(minRadius, m_transmissionRadii[i]);
+        maxRadius = std::max(maxRadius, m_transmissionRadii[i]);
+    }
     
-    std::vector<RTreeValue> results;
-    m_rtree->query(bgi::intersects(queryBox), std::back_inserter(results));
+    // Cellules d'un quart de rayon (du plus petit, ou d'un huitième du plus
+    // grand si les classes sont très écartées): pour un rayon r, la demi-coquille
+    // parcourue fait 4,5 lignes de 9 cellules, soit ~2,5r² au lieu des 4r² de
+    // la boîte R-tree. Cellules de longitude dimensionnées à la latitude la
+    // plus élevée, pour faire au moins cellMeters partout.
+    const double maxAbsLat = std::max(std::abs(minLat), std::abs(maxLat));
+    const double cosRef = std::max(std::cos(data::GeometryUtils::degToRad(maxAbsLat)), 1e-6);
+    const size_t maxCells = std::max(GRID_MIN_CELLS, GRID_MAX_CELLS_PER_VEHICLE * n);
     
-    std::vector<int> neighbors;
-    for (const auto& [point, id] : results) {
-        if (id != vehicleId && distance(vehicleId, id) <= radius) {
-            neighbors.push_back(id);
-        }
+    grid.cellMeters = std::max({minRadius, maxRadius / 2.0, 4.0}) / 4.0;
+    for (;;) {
+        grid.cellLat = grid.cellMeters / METERS_PER_DEGREE;
+        grid.cellLon = grid.cellMeters / (METERS_PER_DEGREE * cosRef);
+        grid.cols = static_cast<int>((maxLon - minLon) / grid.cellLon) + 1;
+        grid.rows = static_cast<int>((maxLat - minLat) / grid.cellLat) + 1;
+        if (static_cast<size_t>(grid.cols) * grid.rows <= maxCells) break;
+        grid.cellMeters *= 2.0;
     }
+    grid.minLat = minLat;
+    grid.minLon = minLon;
     
-    return neighbors;
-}
-
-double InterferenceGraph::distance(int vehicleId1, int vehicleId2) const {
-    auto pos1 = m_vehiclePositions.find(vehicleId1);
-    auto pos2 = m_vehiclePositions.find(vehicleId2);
+    // Tri par comptage: stable, donc indices croissants à l'intérieur d'une cellule
+    const size_t cellCount = static_cast<size_t>(grid.cols) * grid.rows;
+    grid.cellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const int cx = std::min(static_cast<int>((m_positions[i].get<0>() - minLon) / grid.cellLon), grid.cols - 1);
+        const int cy = std::min(static_cast<int>((m_positions[i].get<1>() - minLat) / grid.cellLat), grid.rows - 1);
+        grid.cellOf[i] = cy * grid.cols + cx;
+        grid.cellStart[grid.cellOf[i] + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; ++c) {
+        grid.cellStart[c + 1] += grid.cellStart[c];
+    }
     
-    if (pos1 == m_vehiclePositions.end() || pos2 == m_vehiclePositions.end()) {
-        return std::numeric_limits<double>::max();
+    std::vector<size_t> cursor(grid.cellStart.begin(), grid.cellStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        grid.vehicles[cursor[grid.cellOf[i]]++] = static_cast<int>(i);
     }
     
-    return bg::distance(pos1->second, pos2->second);
+    grid.frame.assignPermuted(m_frame, grid.vehicles);
 }
 
-double InterferenceGraph::distanceInMeters(int vehicleId1, int vehicleId2) const {
-    auto pos1 = m_vehiclePositions.find(vehicleId1);
-    auto pos2 = m_vehiclePositions.find(vehicleId2);
-    
-    if (pos1 == m_vehiclePositions.end() || pos2 == m_vehiclePositions.end()) {
-        return std::numeric_limits<double>::max();
-    }
+void InterferenceGraph::queryCandidates(int index, double radiusMeters, double slackMeters,
+                                        std::vector<RTreeValue>& results) const {
+    results.clear();
     
-    // Convert Point2D (x=lon, y=lat) to lat/lon for Haversine
-    double lat1 = pos1->second.get<1>();
-    double lon1 = pos1->second.get<0>();
-    double lat2 = pos2->second.get<1>();
-    double lon2 = pos2->second.get<0>();
+    // Boîte englobante du cercle de rayon radiusMeters: en longitude, un degré
+    // ne fait que 111320 * cos(lat) mètres
+    const Point2D& center = m_positions[index];
+    const double cosLat = std::max(std::cos(data::GeometryUtils::degToRad(center.get<1>())), 1e-6);
+    auto query = [&](const RTree& tree, double reach) {
+        const double halfLat = reach / METERS_PER_DEGREE;
+        const double halfLon = reach / (METERS_PER_DEGREE * cosLat);
+        
+        Box queryBox(
+            Point2D(center.get<0>() - halfLon, center.get<1>() - halfLat),
+            Point2D(center.get<0>() + halfLon, center.get<1>() + halfLat)
+        );
+        
+        tree.query(bgi::intersects(queryBox), std::back_inserter(results));
+    };
     
-    // Use Haversine distance for accurate meters calculation
-    return data::GeometryUtils::haversineDistance(lat1, lon1, lat2, lon2);
+    // Classes >= la sienne: rayon propre; classes inférieures: un lien exige
+    // d <= min(r1, r2), inutile de chercher au-delà du rayon max de la classe
+    const int ownClass = m_radiusClassOf[index];
+    query(m_radiusSuffixTrees[ownClass], radiusMeters + slackMeters);
+    for (int c = 0; c < ownClass; ++c) {
+        if (!m_radiusClassTrees[c].empty()) {
+            query(m_radiusClassTrees[c], std::min(radiusMeters, m_radiusClassMax[c]) + slackMeters);
+        }
+    }
 }
 
 } // namespace network
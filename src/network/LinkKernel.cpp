@@ -0,0 +1,399 @@
+#include "network/LinkKernel.hpp"
+#include "data/GeometryUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define V2V_LINK_KERNEL_X86 1
+#endif
+
+namespace v2v {
+namespace network {
+
+namespace {
+
+LinkKernel::Backend detectBackend() {
+#ifdef V2V_LINK_KERNEL_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return LinkKernel::Backend::AVX2;
+    }
+#endif
+    return LinkKernel::Backend::Scalar;
+}
+
+std::atomic<LinkKernel::Backend> g_backend{detectBackend()};
+
+// Candidat k: candidates[k] (bloc d'indices) ou begin + k (suite contiguë)
+template <bool Contiguous>
+inline size_t candidateAt(const int* candidates, size_t begin, size_t k) {
+    if constexpr (Contiguous) {
+        return begin + k;
+    } else {
+        return static_cast<size_t>(candidates[k]);
+    }
+}
+
+// Mêmes opérations, dans le même ordre, que qualifyBlockScalar: une
+// coordonnée z nulle (Planar) ou un rayon commun (Uniform) y donnent
+// exactement les mêmes masques
+template <LinkMetric Metric, LinkRadius Radius, bool Contiguous>
+uint64_t qualifyScalarWith(const LinkFrame& frame, size_t index,
+                           const int* candidates, size_t begin, size_t count) {
+    const double xi = frame.x[index];
+    const double yi = frame.y[index];
+    const double zi = frame.z[index];
+    const double ci = frame.chordRadius[index];
+    
+    uint64_t mask = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const size_t j = candidateAt<Contiguous>(candidates, begin, k);
+        const double dx = frame.x[j] - xi;
+        const double dy = frame.y[j] - yi;
+        double d2 = dx * dx + dy * dy;
+        if constexpr (Metric == LinkMetric::Chord) {
+            const double dz = frame.z[j] - zi;
+            d2 += dz * dz;
+        }
+        
+        double r = ci;
+        if constexpr (Radius == LinkRadius::PerVehicle) {
+            r = std::min(ci, frame.chordRadius[j]);
+        }
+        
+        // Sans branchement: comparaison convertie en bit
+        mask |= static_cast<uint64_t>(d2 <= r * r) << k;
+    }
+    return mask;
+}
+
+#ifdef V2V_LINK_KERNEL_X86
+
+template <bool Contiguous>
+__attribute__((target("avx2")))
+inline __m256d loadCandidates(const double* base, const int* candidates, size_t begin, size_t k) {
+    if constexpr (Contiguous) {
+        return _mm256_loadu_pd(base + begin + k);
+    } else {
+        const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidates + k));
+        return _mm256_i32gather_pd(base, idx, 8);
+    }
+}
+
+template <LinkMetric Metric, LinkRadius Radius, bool Contiguous>
+__attribute__((target("avx2")))
+uint64_t qualifyAvx2With(const LinkFrame& frame, size_t index,
+                         const int* candidates, size_t begin, size_t count) {
+    const __m256d xi = _mm256_set1_pd(frame.x[index]);
+    const __m256d yi = _mm256_set1_pd(frame.y[index]);
+    const __m256d zi = _mm256_set1_pd(frame.z[index]);
+    const __m256d ci = _mm256_set1_pd(frame.chordRadius[index]);
+    const __m256d ci2 = _mm256_mul_pd(ci, ci);
+    
+    uint64_t mask = 0;
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m256d dx = _mm256_sub_pd(loadCandidates<Contiguous>(frame.x.data(), candidates, begin, k), xi);
+        const __m256d dy = _mm256_sub_pd(loadCandidates<Contiguous>(frame.y.data(), candidates, begin, k), yi);
+        __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        if constexpr (Metric == LinkMetric::Chord) {
+            const __m256d dz = _mm256_sub_pd(loadCandidates<Contiguous>(frame.z.data(), candidates, begin, k), zi);
+            d2 = _mm256_add_pd(d2, _mm256_mul_pd(dz, dz));
+        }
+        
+        __m256d r2 = ci2;
+        if constexpr (Radius == LinkRadius::PerVehicle) {
+            const __m256d r = _mm256_min_pd(loadCandidates<Contiguous>(frame.chordRadius.data(), candidates, begin, k), ci);
+            r2 = _mm256_mul_pd(r, r);
+        }
+        
+        mask |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(d2, r2, _CMP_LE_OQ))) << k;
+    }
+    
+    _mm256_zeroupper(); // Avant la queue scalaire (voir qualifyBlockAvx2)
+    
+    if (k < count) {
+        mask |= qualifyScalarWith<Metric, Radius, Contiguous>(frame, index, Contiguous ? nullptr : candidates + k,
+                                                              begin + k, count - k) << k;
+    }
+    return mask;
+}
+
+#endif
+
+} // namespace
+
+void LinkFrame::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    chordRadius.clear();
+    m_hasOrigin = false;
+    m_uniformRadius = true;
+}
+
+void LinkFrame::setMetric(LinkMetric metric) {
+    clear();
+    m_metric = metric;
+    m_hasReference = false;
+}
+
+void LinkFrame::assignPermuted(const LinkFrame& source, std::span<const int> order) {
+    const size_t n = order.size();
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    chordRadius.resize(n);
+    for (size_t p = 0; p < n; ++p) {
+        const int i = order[p];
+        x[p] = source.x[i];
+        y[p] = source.y[i];
+        z[p] = source.z[i];
+        chordRadius[p] = source.chordRadius[i];
+    }
+    
+    m_metric = source.m_metric;
+    m_hasOrigin = source.m_hasOrigin;
+    m_hasReference = source.m_hasReference;
+    m_uniformRadius = source.m_uniformRadius;
+    m_originX = source.m_originX;
+    m_originY = source.m_originY;
+    m_originZ = source.m_originZ;
+    m_referenceCosLat = source.m_referenceCosLat;
+}
+
+void LinkFrame::reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    chordRadius.reserve(count);
+}
+
+void LinkFrame::push(double lat, double lon, double radiusMeters) {
+    if (m_metric == LinkMetric::Planar && !m_hasReference) {
+        m_referenceCosLat = std::cos(data::GeometryUtils::degToRad(lat));
+        m_hasReference = true;
+    }
+    
+    double px, py, pz;
+    toAbsolute(lat, lon, px, py, pz);
+    const double radius = lengthOf(radiusMeters);
+    
+    // Origine locale = premier véhicule: garde des coordonnées de l'ordre de
+    // l'étendue de la scène plutôt que du rayon terrestre
+    if (!m_hasOrigin) {
+        m_originX = px;
+        m_originY = py;
+        m_originZ = pz;
+        m_hasOrigin = true;
+    }
+    
+    if (!chordRadius.empty() && radius != chordRadius.front()) {
+        m_uniformRadius = false;
+    }
+    
+    x.push_back(px - m_originX);
+    y.push_back(py - m_originY);
+    z.push_back(pz - m_originZ);
+    chordRadius.push_back(radius);
+}
+
+void LinkFrame::project(double lat, double lon, double& px, double& py, double& pz) const {
+    toAbsolute(lat, lon, px, py, pz);
+    px -= m_originX;
+    py -= m_originY;
+    pz -= m_originZ;
+}
+
+double LinkFrame::lengthOf(double meters) const {
+    return m_metric == LinkMetric::Planar ? meters : LinkKernel::chordLength(meters);
+}
+
+double LinkFrame::metersOf(double length) const {
+    if (m_metric == LinkMetric::Planar) {
+        return length;
+    }
+    const double R = data::GeometryUtils::EARTH_RADIUS_M;
+    return 2.0 * R * std::asin(std::min(length / (2.0 * R), 1.0));
+}
+
+void LinkFrame::toAbsolute(double lat, double lon, double& px, double& py, double& pz) const {
+    using data::GeometryUtils;
+    
+    const double latRad = GeometryUtils::degToRad(lat);
+    const double lonRad = GeometryUtils::degToRad(lon);
+    
+    if (m_metric == LinkMetric::Planar) {
+        px = GeometryUtils::EARTH_RADIUS_M * m_referenceCosLat * lonRad;
+        py = GeometryUtils::EARTH_RADIUS_M * latRad;
+        pz = 0.0;
+    } else {
+        const double cosLat = std::cos(latRad);
+        px = GeometryUtils::EARTH_RADIUS_M * cosLat * std::cos(lonRad);
+        py = GeometryUtils::EARTH_RADIUS_M * cosLat * std::sin(lonRad);
+        pz = GeometryUtils::EARTH_RADIUS_M * std::sin(latRad);
+    }
+}
+
+LinkKernel::Backend LinkKernel::activeBackend() {
+    return g_backend.load(std::memory_order_relaxed);
+}
+
+bool LinkKernel::isSupported(Backend backend) {
+    return backend == Backend::Scalar || detectBackend() == Backend::AVX2;
+}
+
+const char* LinkKernel::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return "scalar";
+        case Backend::AVX2: return "AVX2";
+        default: return "?";
+    }
+}
+
+void LinkKernel::setBackend(Backend backend) {
+    if (isSupported(backend)) {
+        g_backend.store(backend, std::memory_order_relaxed);
+    }
+}
+
+double LinkKernel::chordLength(double meters) {
+    const double R = data::GeometryUtils::EARTH_RADIUS_M;
+    return 2.0 * R * std::sin(meters / (2.0 * R));
+}
+
+uint64_t LinkKernel::qualifyBlock(const LinkFrame& frame, int index,
+                                  const int* candidates, size_t count) {
+    if (activeBackend() == Backend::AVX2) {
+        return qualifyBlockAvx2(frame, index, candidates, count);
+    }
+    return qualifyBlockScalar(frame, index, candidates, count);
+}
+
+uint64_t LinkKernel::qualifyBlockScalar(const LinkFrame& frame, int index,
+                                        const int* candidates, size_t count) {
+    const double xi = frame.x[index];
+    const double yi = frame.y[index];
+    const double zi = frame.z[index];
+    const double ci = frame.chordRadius[index];
+    
+    uint64_t mask = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const int j = candidates[k];
+        const double dx = frame.x[j] - xi;
+        const double dy = frame.y[j] - yi;
+        const double dz = frame.z[j] - zi;
+        const double r = std::min(ci, frame.chordRadius[j]);
+        
+        // Connect if within BOTH vehicles' radii
+        if (dx * dx + dy * dy + dz * dz <= r * r) {
+            mask |= uint64_t(1) << k;
+        }
+    }
+    return mask;
+}
+
+#ifdef V2V_LINK_KERNEL_X86
+
+__attribute__((target("avx2")))
+uint64_t LinkKernel::qualifyBlockAvx2(const LinkFrame& frame, int index,
+                                      const int* candidates, size_t count) {
+    const __m256d xi = _mm256_set1_pd(frame.x[index]);
+    const __m256d yi = _mm256_set1_pd(frame.y[index]);
+    const __m256d zi = _mm256_set1_pd(frame.z[index]);
+    const __m256d ci = _mm256_set1_pd(frame.chordRadius[index]);
+    
+    uint64_t mask = 0;
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidates + k));
+        
+        const __m256d dx = _mm256_sub_pd(_mm256_i32gather_pd(frame.x.data(), idx, 8), xi);
+        const __m256d dy = _mm256_sub_pd(_mm256_i32gather_pd(frame.y.data(), idx, 8), yi);
+        const __m256d dz = _mm256_sub_pd(_mm256_i32gather_pd(frame.z.data(), idx, 8), zi);
+        const __m256d r = _mm256_min_pd(_mm256_i32gather_pd(frame.chordRadius.data(), idx, 8), ci);
+        
+        // Pas de FMA (TU compilée en -ffp-contract=off): mêmes arrondis que la version scalaire
+        const __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                         _mm256_mul_pd(dz, dz));
+        const __m256d inRange = _mm256_cmp_pd(d2, _mm256_mul_pd(r, r), _CMP_LE_OQ);
+        
+        mask |= static_cast<uint64_t>(_mm256_movemask_pd(inRange)) << k;
+    }
+    
+    // GCC omet vzeroupper sur le chemin de la queue: sans lui, tout le code
+    // SSE qui suit sur ce thread (libm, tris) paie la transition AVX/SSE
+    _mm256_zeroupper();
+    
+    if (k < count) {
+        mask |= qualifyBlockScalar(frame, index, candidates + k, count - k) << k;
+    }
+    return mask;
+}
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyBlockWithAvx2(const LinkFrame& frame, int index,
+                                          const int* candidates, size_t count) {
+    return qualifyAvx2With<Metric, Radius, false>(frame, index, candidates, 0, count);
+}
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyRunAvx2(const LinkFrame& frame, size_t index,
+                                    size_t begin, size_t count) {
+    return qualifyAvx2With<Metric, Radius, true>(frame, index, nullptr, begin, count);
+}
+
+#else
+
+uint64_t LinkKernel::qualifyBlockAvx2(const LinkFrame& frame, int index,
+                                      const int* candidates, size_t count) {
+    return qualifyBlockScalar(frame, index, candidates, count);
+}
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyBlockWithAvx2(const LinkFrame& frame, int index,
+                                          const int* candidates, size_t count) {
+    return qualifyScalarWith<Metric, Radius, false>(frame, index, candidates, 0, count);
+}
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyRunAvx2(const LinkFrame& frame, size_t index,
+                                    size_t begin, size_t count) {
+    return qualifyScalarWith<Metric, Radius, true>(frame, index, nullptr, begin, count);
+}
+
+#endif
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyBlockWith(const LinkFrame& frame, int index,
+                                      const int* candidates, size_t count) {
+    if (activeBackend() == Backend::AVX2) {
+        return qualifyBlockWithAvx2<Metric, Radius>(frame, index, candidates, count);
+    }
+    return qualifyScalarWith<Metric, Radius, false>(frame, index, candidates, 0, count);
+}
+
+template <LinkMetric Metric, LinkRadius Radius>
+uint64_t LinkKernel::qualifyRun(const LinkFrame& frame, size_t index,
+                                size_t begin, size_t count) {
+    if (activeBackend() == Backend::AVX2) {
+        return qualifyRunAvx2<Metric, Radius>(frame, index, begin, count);
+    }
+    return qualifyScalarWith<Metric, Radius, true>(frame, index, nullptr, begin, count);
+}
+
+// Les quatre combinaisons de politiques
+#define V2V_LINK_KERNEL_INSTANTIATE(METRIC, RADIUS) \
+    template uint64_t LinkKernel::qualifyBlockWith<METRIC, RADIUS>(const LinkFrame&, int, const int*, size_t); \
+    template uint64_t LinkKernel::qualifyRun<METRIC, RADIUS>(const LinkFrame&, size_t, size_t, size_t);
+
+V2V_LINK_KERNEL_INSTANTIATE(LinkMetric::Chord, LinkRadius::PerVehicle)
+V2V_LINK_KERNEL_INSTANTIATE(LinkMetric::Chord, LinkRadius::Uniform)
+V2V_LINK_KERNEL_INSTANTIATE(LinkMetric::Planar, LinkRadius::PerVehicle)
+V2V_LINK_KERNEL_INSTANTIATE(LinkMetric::Planar, LinkRadius::Uniform)
+
+#undef V2V_LINK_KERNEL_INSTANTIATE
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,394 @@
+#include "network/LinkStatistics.hpp"
+#include "network/InterferenceGraph.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Durées en secondes: de la milliseconde à ~11 jours, 40 classes par décade
+constexpr double MIN_DURATION = 1e-3;
+constexpr double MAX_DURATION = 1e6;
+constexpr int DURATION_BINS_PER_DECADE = 40;
+
+// Contacts par véhicule: de 1 à 10^7
+constexpr double MAX_CONTACTS = 1e7;
+constexpr int CONTACT_BINS_PER_DECADE = 20;
+
+// Table des liens ouverts: agrandie au-delà d'un taux de remplissage de 1/2
+constexpr size_t MIN_OPEN_CAPACITY = 1024;
+
+// Séparations mémorisées par défaut (16 octets chacune: 16 Mo)
+constexpr size_t DEFAULT_SEPARATION_CAPACITY = size_t(1) << 20;
+constexpr size_t SEPARATION_WAYS = 4;
+
+uint64_t pairKey(int vehicleId1, int vehicleId2) {
+    const auto [low, high] = std::minmax(vehicleId1, vehicleId2);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(low)) << 32) | static_cast<uint32_t>(high);
+}
+
+// Finaliseur SplitMix64: les IDs consécutifs se répartissent dans toute la table
+uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
+// ============================================================================
+// LogHistogram
+// ============================================================================
+
+LogHistogram::LogHistogram(double minValue, double maxValue, int binsPerDecade)
+    : m_minValue(minValue)
+    , m_logMin(std::log10(minValue))
+    , m_binsPerDecade(binsPerDecade)
+    , m_count(0)
+    , m_sum(0.0)
+    , m_min(0.0)
+    , m_max(0.0)
+{
+    const auto decadeBins = static_cast<size_t>(std::ceil((std::log10(maxValue) - m_logMin) * binsPerDecade));
+    m_bins.assign(decadeBins + 2, 0);
+}
+
+void LogHistogram::add(double value, uint64_t count) {
+    if (count == 0) return;
+    
+    size_t bin = 0;
+    if (value >= m_minValue) {
+        const double position = (std::log10(value) - m_logMin) * m_binsPerDecade;
+        bin = std::min(static_cast<size_t>(position) + 1, m_bins.size() - 1);
+    }
+    m_bins[bin] += count;
+    
+    m_min = m_count > 0 ? std::min(m_min, value) : value;
+    m_max = m_count > 0 ? std::max(m_max, value) : value;
+    m_count += count;
+    m_sum += value * count;
+}
+
+void LogHistogram::merge(const LogHistogram& other) {
+    if (other.m_count == 0 || other.m_bins.size() != m_bins.size()) return;
+    
+    for (size_t bin = 0; bin < m_bins.size(); ++bin) {
+        m_bins[bin] += other.m_bins[bin];
+    }
+    m_min = m_count > 0 ? std::min(m_min, other.m_min) : other.m_min;
+    m_max = m_count > 0 ? std::max(m_max, other.m_max) : other.m_max;
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+void LogHistogram::clear() {
+    std::fill(m_bins.begin(), m_bins.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = 0.0;
+    m_max = 0.0;
+}
+
+double LogHistogram::binLower(size_t bin) const {
+    if (bin == 0) return 0.0;
+    return std::pow(10.0, m_logMin + (bin - 1) / m_binsPerDecade);
+}
+
+double LogHistogram::binUpper(size_t bin) const {
+    if (bin + 1 >= m_bins.size()) return std::numeric_limits<double>::infinity();
+    return std::pow(10.0, m_logMin + bin / m_binsPerDecade);
+}
+
+double LogHistogram::quantile(double q) const {
+    if (m_count == 0) return 0.0;
+    
+    // Rang visé, puis position dans la classe qui le contient: interpolation
+    // géométrique (classes logarithmiques), bornée par le min et le max exacts
+    const double rank = std::clamp(q, 0.0, 1.0) * m_count;
+    uint64_t below = 0;
+    for (size_t bin = 0; bin < m_bins.size(); ++bin) {
+        if (m_bins[bin] == 0 || below + m_bins[bin] < rank) {
+            below += m_bins[bin];
+            continue;
+        }
+        
+        const double fraction = (rank - below) / m_bins[bin];
+        const double lower = std::max(binLower(bin), m_min);
+        const double upper = std::min(binUpper(bin), m_max);
+        if (lower <= 0.0 || upper <= lower) {
+            return lower + fraction * (upper - lower);
+        }
+        return lower * std::pow(upper / lower, fraction);
+    }
+    return m_max;
+}
+
+// ============================================================================
+// LinkStatistics
+// ============================================================================
+
+LinkStatistics::LinkStatistics()
+    : m_openCount(0)
+    , m_forgottenSeparations(0)
+    , m_linkDurations(MIN_DURATION, MAX_DURATION, DURATION_BINS_PER_DECADE)
+    , m_interContactTimes(MIN_DURATION, MAX_DURATION, DURATION_BINS_PER_DECADE)
+    , m_openLinkAges(MIN_DURATION, MAX_DURATION, DURATION_BINS_PER_DECADE)
+    , m_linkUps(0)
+    , m_linkDowns(0)
+{
+    m_openKeys.assign(MIN_OPEN_CAPACITY, 0);
+    m_openStart.assign(MIN_OPEN_CAPACITY, 0.0);
+    setSeparationCapacity(DEFAULT_SEPARATION_CAPACITY);
+}
+
+void LinkStatistics::update(const InterferenceGraph& graph) {
+    for (int id : graph.getVehicleIds()) {
+        if (static_cast<size_t>(id) >= m_seen.size()) {
+            m_seen.resize(id + 1, 0);
+            m_contacts.resize(id + 1, 0);
+        }
+        m_seen[id] = 1;
+    }
+    
+    for (const LinkEvent& event : graph.getLinkEvents()) {
+        const uint64_t key = pairKey(event.vehicleId1, event.vehicleId2);
+        
+        if (event.type == LinkEvent::Type::Up) {
+            ++m_linkUps;
+            countContact(event.vehicleId1);
+            countContact(event.vehicleId2);
+            
+            double end;
+            if (takeSeparation(key, end)) {
+                m_interContactTimes.add(event.timestamp - end);
+            }
+            insertOpen(key, event.timestamp);
+        } else {
+            ++m_linkDowns;
+            
+            // Lien ouvert avant le premier update: durée inconnue, ignoré
+            double start;
+            if (takeOpen(key, start)) {
+                m_linkDurations.add(event.timestamp - start);
+                insertSeparation(key, event.timestamp);
+            }
+        }
+    }
+}
+
+void LinkStatistics::finish(double simulationTime) {
+    m_openLinkAges.clear();
+    for (size_t slot = 0; slot < m_openKeys.size(); ++slot) {
+        if (m_openKeys[slot] != 0) {
+            m_openLinkAges.add(simulationTime - m_openStart[slot]);
+        }
+    }
+}
+
+void LinkStatistics::resync() {
+    std::fill(m_openKeys.begin(), m_openKeys.end(), 0);
+    std::fill(m_separationKeys.begin(), m_separationKeys.end(), 0);
+    m_openCount = 0;
+}
+
+void LinkStatistics::countContact(int vehicleId) {
+    if (static_cast<size_t>(vehicleId) >= m_contacts.size()) {
+        m_seen.resize(vehicleId + 1, 0);
+        m_contacts.resize(vehicleId + 1, 0);
+    }
+    ++m_contacts[vehicleId];
+}
+
+LogHistogram LinkStatistics::getContactsPerVehicle() const {
+    LogHistogram histogram(1.0, MAX_CONTACTS, CONTACT_BINS_PER_DECADE);
+    for (size_t id = 0; id < m_seen.size(); ++id) {
+        if (m_seen[id]) {
+            histogram.add(m_contacts[id]);
+        }
+    }
+    return histogram;
+}
+
+uint32_t LinkStatistics::getContactCount(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_contacts.size()) {
+        return 0;
+    }
+    return m_contacts[vehicleId];
+}
+
+void LinkStatistics::insertOpen(uint64_t key, double start) {
+    if (2 * (m_openCount + 1) > m_openKeys.size()) {
+        growOpen();
+    }
+    
+    const size_t mask = m_openKeys.size() - 1;
+    size_t slot = mix64(key) & mask;
+    while (m_openKeys[slot] != 0 && m_openKeys[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    if (m_openKeys[slot] == 0) {
+        ++m_openCount;
+    }
+    m_openKeys[slot] = key;
+    m_openStart[slot] = start;
+}
+
+bool LinkStatistics::takeOpen(uint64_t key, double& start) {
+    const size_t mask = m_openKeys.size() - 1;
+    size_t slot = mix64(key) & mask;
+    while (m_openKeys[slot] != key) {
+        if (m_openKeys[slot] == 0) return false;
+        slot = (slot + 1) & mask;
+    }
+    start = m_openStart[slot];
+    --m_openCount;
+    
+    // Suppression par décalage arrière: chaque entrée suivante de la grappe
+    // remonte dans le trou si sa position idéale ne se trouve pas entre le
+    // trou et elle (pas de marqueur de suppression, sondages toujours courts)
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; m_openKeys[next] != 0; next = (next + 1) & mask) {
+        const size_t ideal = mix64(m_openKeys[next]) & mask;
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            m_openKeys[hole] = m_openKeys[next];
+            m_openStart[hole] = m_openStart[next];
+            hole = next;
+        }
+    }
+    m_openKeys[hole] = 0;
+    return true;
+}
+
+void LinkStatistics::growOpen() {
+    std::vector<uint64_t> keys(m_openKeys.size() * 2, 0);
+    std::vector<double> starts(keys.size(), 0.0);
+    keys.swap(m_openKeys);
+    starts.swap(m_openStart);
+    m_openCount = 0;
+    for (size_t slot = 0; slot < keys.size(); ++slot) {
+        if (keys[slot] != 0) {
+            insertOpen(keys[slot], starts[slot]);
+        }
+    }
+}
+
+void LinkStatistics::setSeparationCapacity(size_t pairs) {
+    const size_t capacity = std::bit_ceil(std::max(pairs, SEPARATION_WAYS));
+    m_separationKeys = std::vector<uint64_t>(capacity, 0);
+    m_separationEnd = std::vector<double>(capacity, 0.0);
+}
+
+void LinkStatistics::insertSeparation(uint64_t key, double end) {
+    const size_t group = mix64(key) & (m_separationKeys.size() - SEPARATION_WAYS);
+    
+    // Entrée libre du groupe, sinon la séparation la plus ancienne est oubliée
+    size_t victim = group;
+    for (size_t slot = group; slot < group + SEPARATION_WAYS; ++slot) {
+        if (m_separationKeys[slot] == 0) {
+            victim = slot;
+            break;
+        }
+        if (m_separationEnd[slot] < m_separationEnd[victim]) {
+            victim = slot;
+        }
+    }
+    if (m_separationKeys[victim] != 0) {
+        ++m_forgottenSeparations;
+    }
+    m_separationKeys[victim] = key;
+    m_separationEnd[victim] = end;
+}
+
+bool LinkStatistics::takeSeparation(uint64_t key, double& end) {
+    const size_t group = mix64(key) & (m_separationKeys.size() - SEPARATION_WAYS);
+    for (size_t slot = group; slot < group + SEPARATION_WAYS; ++slot) {
+        if (m_separationKeys[slot] == key) {
+            end = m_separationEnd[slot];
+            m_separationKeys[slot] = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t LinkStatistics::getMemoryBytes() const {
+    return m_openKeys.capacity() * sizeof(uint64_t) + m_openStart.capacity() * sizeof(double)
+         + m_separationKeys.capacity() * sizeof(uint64_t) + m_separationEnd.capacity() * sizeof(double)
+         + m_contacts.capacity() * sizeof(uint32_t) + m_seen.capacity()
+         + 3 * m_linkDurations.binCount() * sizeof(uint64_t);
+}
+
+void LinkStatistics::logSummary() const {
+    auto describe = [](const char* name, const LogHistogram& histogram) {
+        LOG_INFO(QString("  %1: n=%2 mean %3 p50 %4 p90 %5 p99 %6 max %7")
+                 .arg(name)
+                 .arg(histogram.count())
+                 .arg(histogram.mean(), 0, 'g', 4)
+                 .arg(histogram.quantile(0.5), 0, 'g', 4)
+                 .arg(histogram.quantile(0.9), 0, 'g', 4)
+                 .arg(histogram.quantile(0.99), 0, 'g', 4)
+                 .arg(histogram.max(), 0, 'g', 4));
+    };
+    
+    LOG_INFO(QString("Link statistics: %1 links formed, %2 broken, %3 open, %4 separations forgotten")
+             .arg(m_linkUps).arg(m_linkDowns).arg(m_openCount).arg(m_forgottenSeparations));
+    describe("link duration (s)", m_linkDurations);
+    describe("inter-contact time (s)", m_interContactTimes);
+    describe("open link age (s)", m_openLinkAges);
+    describe("contacts per vehicle", getContactsPerVehicle());
+}
+
+bool LinkStatistics::writeReport(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out) {
+        LOG_ERROR(QString("Cannot write link statistics: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    const LogHistogram contacts = getContactsPerVehicle();
+    const std::pair<const char*, const LogHistogram*> metrics[] = {
+        {"link_duration_s", &m_linkDurations},
+        {"inter_contact_time_s", &m_interContactTimes},
+        {"open_link_age_s", &m_openLinkAges},
+        {"contacts_per_vehicle", &contacts},
+    };
+    
+    out << "metric,count,mean,min,p50,p90,p99,max\n";
+    for (const auto& [name, histogram] : metrics) {
+        out << name << ',' << histogram->count() << ',' << histogram->mean() << ','
+            << histogram->min() << ',' << histogram->quantile(0.5) << ','
+            << histogram->quantile(0.9) << ',' << histogram->quantile(0.99) << ','
+            << histogram->max() << '\n';
+    }
+    
+    out << "\nmetric,bin_lower,bin_upper,count\n";
+    for (const auto& [name, histogram] : metrics) {
+        for (size_t bin = 0; bin < histogram->binCount(); ++bin) {
+            if (histogram->binValue(bin) == 0) continue;
+            out << name << ',' << histogram->binLower(bin) << ',' << histogram->binUpper(bin) << ','
+                << histogram->binValue(bin) << '\n';
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+void LinkStatistics::clear() {
+    std::fill(m_openKeys.begin(), m_openKeys.end(), 0);
+    std::fill(m_separationKeys.begin(), m_separationKeys.end(), 0);
+    m_openCount = 0;
+    m_forgottenSeparations = 0;
+    m_contacts.clear();
+    m_seen.clear();
+    m_linkDurations.clear();
+    m_interContactTimes.clear();
+    m_openLinkAges.clear();
+    m_linkUps = 0;
+    m_linkDowns = 0;
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,311 @@
+#include "network/MacLayer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace v2v {
+namespace network {
+
+namespace {
+// Tirage uniforme dans [0, 1) déterministe par (véhicule, compteur) (SplitMix64)
+double uniformDraw(int vehicleId, uint64_t counter) {
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(vehicleId)) << 32) ^ counter;
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<double>(z >> 11) * 0x1.0p-53;
+}
+}
+
+MacLayer::MacLayer()
+    : m_aifs(0.0)
+    , m_enabled(false)
+    , m_now(0.0)
+    , m_processedEvents(0)
+{
+    setParameters(Parameters());
+}
+
+void MacLayer::setParameters(const Parameters& parameters) {
+    m_parameters = parameters;
+    m_parameters.beaconInterval = std::max(parameters.beaconInterval, 1e-3);
+    m_parameters.frameDuration = std::max(parameters.frameDuration, 1e-6);
+    m_parameters.contentionWindow = std::max(parameters.contentionWindow, 0);
+    m_aifs = m_parameters.sifs + m_parameters.aifsn * m_parameters.slotTime;
+}
+
+void MacLayer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+double MacLayer::draw(VehicleState& state, int vehicleId) {
+    return uniformDraw(vehicleId, state.draws++);
+}
+
+void MacLayer::advance(const InterferenceGraph& graph, double simulationTime) {
+    if (!m_enabled) return;
+    
+    // Aucun événement: aucun véhicule suivi, l'horloge rejoint la simulation
+    // (pas de rattrapage des beacons depuis l'activation)
+    if (m_events.empty()) {
+        m_now = simulationTime;
+    }
+    
+    // Véhicules apparus: premier beacon à une phase propre dans l'intervalle
+    for (int id : graph.getVehicleIds()) {
+        if (static_cast<size_t>(id) >= m_states.size()) {
+            m_states.resize(id + 1);
+        }
+        VehicleState& state = m_states[id];
+        if (state.present) continue;
+        
+        state.present = true;
+        state.observedSince = m_now;
+        if (state.activeTransmissions > 0) {
+            state.busySince = m_now;
+        } else {
+            state.idleSince = m_now;
+        }
+        m_events.push({m_now + draw(state, id) * m_parameters.beaconInterval, id, EventKind::Beacon, 0});
+    }
+    
+    while (!m_events.empty() && m_events.top().time <= simulationTime) {
+        const Event event = m_events.top();
+        m_events.pop();
+        m_now = event.time;
+        ++m_processedEvents;
+        
+        switch (event.kind) {
+            case EventKind::Beacon:
+                onBeacon(graph, event.vehicleId, event.time);
+                break;
+            case EventKind::Attempt:
+                onAttempt(graph, event.vehicleId, event.time, event.stamp);
+                break;
+            case EventKind::TxEnd:
+                onTxEnd(event.vehicleId, event.time);
+                break;
+        }
+    }
+    
+    m_now = std::max(m_now, simulationTime);
+}
+
+void MacLayer::onBeacon(const InterferenceGraph& graph, int vehicleId, double time) {
+    VehicleState& state = m_states[vehicleId];
+    
+    Point2D position;
+    if (!graph.getPosition(vehicleId, position)) {
+        // Véhicule retiré: plus de beacons, l'observation du canal s'arrête
+        state.present = false;
+        state.pending = false;
+        state.backoff = -1;
+        ++state.attemptStamp;
+        state.stats.observedTime += time - state.observedSince;
+        if (state.activeTransmissions > 0) {
+            state.stats.busyTime += time - state.busySince;
+        }
+        return;
+    }
+    
+    ++state.stats.generated;
+    m_events.push({time + m_parameters.beaconInterval, vehicleId, EventKind::Beacon, 0});
+    
+    if (state.pending) {
+        // Le beacon précédent n'a pas eu accès au canal: remplacé (contention conservée)
+        ++state.stats.dropped;
+        return;
+    }
+    state.pending = true;
+    
+    if (state.transmitting) {
+        return; // Contention à la fin de l'émission en cours
+    }
+    
+    if (state.activeTransmissions == 0 && time - state.idleSince >= m_aifs) {
+        startTransmission(graph, vehicleId, time);
+        return;
+    }
+    
+    state.backoff = static_cast<int>(draw(state, vehicleId) * (m_parameters.contentionWindow + 1));
+    if (state.activeTransmissions == 0) {
+        scheduleAttempt(state, vehicleId, time);
+    }
+}
+
+void MacLayer::scheduleAttempt(VehicleState& state, int vehicleId, double time) {
+    // Canal libre depuis idleSince: AIFS puis décompte des slots restants
+    const double countdownStart = std::max(state.idleSince + m_aifs, time);
+    ++state.attemptStamp;
+    m_events.push({countdownStart + state.backoff * m_parameters.slotTime, vehicleId,
+                   EventKind::Attempt, state.attemptStamp});
+}
+
+void MacLayer::onAttempt(const InterferenceGraph& graph, int vehicleId, double time, uint32_t stamp) {
+    VehicleState& state = m_states[vehicleId];
+    if (stamp != state.attemptStamp || !state.pending || state.activeTransmissions > 0) {
+        return; // Tentative annulée (canal occupé entre-temps)
+    }
+    startTransmission(graph, vehicleId, time);
+}
+
+void MacLayer::startTransmission(const InterferenceGraph& graph, int vehicleId, double time) {
+    VehicleState& state = m_states[vehicleId];
+    state.pending = false;
+    state.backoff = -1;
+    state.transmitting = true;
+    ++state.attemptStamp;
+    ++state.stats.transmitted;
+    
+    // Semi-duplex: une réception en cours est perdue
+    state.rxFrom = -1;
+    channelBusy(vehicleId, time);
+    
+    // Destinataires figés: la fin d'émission doit défaire exactement ce
+    // qui est fait ici, même si le graphe change entre-temps
+    const auto neighbors = graph.getNeighbors(vehicleId);
+    state.receivers.assign(neighbors.begin(), neighbors.end());
+    
+    // (m_states couvre tous les IDs du graphe depuis le début d'advance)
+    for (int receiverId : state.receivers) {
+        VehicleState& receiver = m_states[receiverId];
+        if (!receiver.transmitting) {
+            if (receiver.activeTransmissions == 0) {
+                receiver.rxFrom = vehicleId;
+                receiver.rxOk = true;
+            } else if (receiver.rxFrom >= 0) {
+                // Chevauchement: la trame en cours de réception est perdue
+                receiver.rxOk = false;
+            }
+        }
+        channelBusy(receiverId, time);
+    }
+    
+    m_events.push({time + m_parameters.frameDuration, vehicleId, EventKind::TxEnd, 0});
+}
+
+void MacLayer::onTxEnd(int vehicleId, double time) {
+    VehicleState& state = m_states[vehicleId];
+    
+    for (int receiverId : state.receivers) {
+        VehicleState& receiver = m_states[receiverId];
+        if (receiver.rxFrom == vehicleId) {
+            if (receiver.rxOk) {
+                ++state.stats.deliveredReceptions;
+                ++receiver.stats.received;
+            }
+            receiver.rxFrom = -1;
+        }
+        channelReleased(receiverId, time);
+    }
+    
+    state.stats.intendedReceptions += state.receivers.size();
+    state.receivers.clear();
+    state.transmitting = false;
+    channelReleased(vehicleId, time);
+}
+
+void MacLayer::channelBusy(int vehicleId, double time) {
+    VehicleState& state = m_states[vehicleId];
+    if (state.activeTransmissions++ > 0) return;
+    
+    state.busySince = time;
+    if (state.pending && state.backoff >= 0 && !state.transmitting) {
+        // Backoff gelé: seuls les slots entiers écoulés après AIFS sont décomptés
+        const double elapsed = time - (state.idleSince + m_aifs);
+        if (elapsed > 0.0) {
+            const int slots = static_cast<int>(elapsed / m_parameters.slotTime);
+            state.backoff = std::max(state.backoff - slots, 0);
+        }
+        ++state.attemptStamp;
+    }
+}
+
+void MacLayer::channelReleased(int vehicleId, double time) {
+    VehicleState& state = m_states[vehicleId];
+    if (--state.activeTransmissions > 0) return;
+    
+    if (state.present) {
+        state.stats.busyTime += time - state.busySince;
+    }
+    state.idleSince = time;
+    if (state.pending && !state.transmitting) {
+        if (state.backoff < 0) {
+            // Beacon produit pendant sa propre émission: contention normale
+            state.backoff = static_cast<int>(draw(state, vehicleId) * (m_parameters.contentionWindow + 1));
+        }
+        scheduleAttempt(state, vehicleId, time);
+    }
+}
+
+bool MacLayer::getVehicleStats(int vehicleId, VehicleStats& stats) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return false;
+    }
+    const VehicleState& state = m_states[vehicleId];
+    stats = state.stats;
+    if (state.present) {
+        stats.observedTime += m_now - state.observedSince;
+        if (state.activeTransmissions > 0) {
+            stats.busyTime += m_now - state.busySince;
+        }
+    }
+    return true;
+}
+
+double MacLayer::getPacketDeliveryRatio(int vehicleId) const {
+    VehicleStats stats;
+    return getVehicleStats(vehicleId, stats) ? stats.packetDeliveryRatio() : 0.0;
+}
+
+double MacLayer::getChannelBusyRatio(int vehicleId) const {
+    VehicleStats stats;
+    return getVehicleStats(vehicleId, stats) ? stats.channelBusyRatio() : 0.0;
+}
+
+MacLayer::Summary MacLayer::getSummary() const {
+    Summary summary;
+    
+    uint64_t intended = 0;
+    uint64_t delivered = 0;
+    VehicleStats stats;
+    for (size_t id = 0; id < m_states.size(); ++id) {
+        if (!m_states[id].present || !getVehicleStats(static_cast<int>(id), stats)) continue;
+        
+        ++summary.vehicles;
+        intended += stats.intendedReceptions;
+        delivered += stats.deliveredReceptions;
+        summary.transmissions += stats.transmitted;
+        summary.dropped += stats.dropped;
+        summary.channelBusyRatio += stats.channelBusyRatio();
+        summary.maxChannelBusyRatio = std::max(summary.maxChannelBusyRatio, stats.channelBusyRatio());
+    }
+    
+    if (summary.vehicles > 0) {
+        summary.channelBusyRatio /= summary.vehicles;
+    }
+    summary.packetDeliveryRatio = intended > 0 ? static_cast<double>(delivered) / intended : 0.0;
+    summary.lostReceptions = intended - delivered;
+    return summary;
+}
+
+void MacLayer::resetStatistics() {
+    for (auto& state : m_states) {
+        state.stats = VehicleStats();
+        state.observedSince = m_now;
+        state.busySince = m_now;
+    }
+}
+
+void MacLayer::clear() {
+    m_states.clear();
+    m_events = decltype(m_events)();
+    m_now = 0.0;
+    m_processedEvents = 0;
+}
+
+} // namespace network
+} // namespace v2v
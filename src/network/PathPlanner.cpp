@@ -1,76 +1,57 @@
 #include "network/PathPlanner.hpp"
+#include "data/GeometryUtils.hpp"
 #include "utils/Logger.hpp"
-#include <boost/graph/astar_search.hpp>
-#include <boost/graph/random.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <algorithm>
 #include <random>
-#include <queue>
+#include <functional>
 #include <limits>
 #include <cmath>
 
 namespace v2v {
 namespace network {
 
-// Heuristique pour A* (distance de Haversine)
-class AStarHeuristic : public boost::astar_heuristic<RoadGraphType, double> {
-public:
-    AStarHeuristic(const RoadGraphType& graph, VertexDescriptor goal)
-        : m_graph(graph), m_goal(goal) {}
+namespace {
+// Entrée du tas de A*: coût estimé (parcouru + heuristique), coût parcouru
+// au moment de l'insertion (entrée périmée si le nœud a été amélioré depuis)
+struct SearchEntry {
+    double estimate;
+    double distance;
+    RoadNetwork::NodeId node;
     
-    double operator()(VertexDescriptor v) {
-        const auto& nodeV = m_graph[v];
-        const auto& nodeGoal = m_graph[m_goal];
-        
-        // Distance de Haversine
-        const double R = 6371000.0; // Rayon de la Terre en mètres
-        const double lat1 = nodeV.latitude * M_PI / 180.0;
-        const double lat2 = nodeGoal.latitude * M_PI / 180.0;
-        const double dLat = (nodeGoal.latitude - nodeV.latitude) * M_PI / 180.0;
-        const double dLon = (nodeGoal.longitude - nodeV.longitude) * M_PI / 180.0;
-        
-        const double a = std::sin(dLat/2) * std::sin(dLat/2) +
-                        std::cos(lat1) * std::cos(lat2) *
-                        std::sin(dLon/2) * std::sin(dLon/2);
-        const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1-a));
-        
-        return R * c;
-    }
-    
-private:
-    const RoadGraphType& m_graph;
-    VertexDescriptor m_goal;
-};
-
-// Visiteur pour détecter la fin de A*
-struct FoundGoal {
-    bool timedOut;
-    FoundGoal(bool timeout = false) : timedOut(timeout) {}
+    bool operator>(const SearchEntry& other) const { return estimate > other.estimate; }
 };
 
-class AStarGoalVisitor : public boost::default_astar_visitor {
-public:
-    AStarGoalVisitor(VertexDescriptor goal, int maxIterations = 5000) 
-        : m_goal(goal), m_maxIterations(maxIterations), m_iterations(0) {}
+// Tableaux de travail de A* par thread, réutilisés d'une recherche à l'autre:
+// un nœud n'est valide que si son tampon vaut la génération courante (pas de
+// remise à zéro en O(V) par recherche)
+struct SearchState {
+    std::vector<double> distance;
+    std::vector<RoadNetwork::NodeId> predecessor;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+    std::vector<SearchEntry> heap;
     
-    void examine_vertex(VertexDescriptor v, const RoadGraphType&) {
-        // Vérifier d'abord si on a atteint le but
-        if (v == m_goal) {
-            throw FoundGoal(false);  // Succès !
+    void begin(size_t nodeCount) {
+        if (stamp.size() < nodeCount) {
+            distance.resize(nodeCount);
+            predecessor.resize(nodeCount);
+            stamp.resize(nodeCount, 0);
         }
-        
-        // Limiter le nombre d'itérations pour éviter les freezes
-        m_iterations++;
-        if (m_iterations > m_maxIterations) {
-            throw FoundGoal(true);  // Timeout - abandonner
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
         }
+        heap.clear();
     }
     
-private:
-    VertexDescriptor m_goal;
-    int m_maxIterations;
-    mutable int m_iterations;
+    double distanceOf(RoadNetwork::NodeId node) const {
+        return stamp[node] == generation ? distance[node] : std::numeric_limits<double>::max();
+    }
 };
 
+thread_local SearchState searchState;
+}
+
 PathPlanner::PathPlanner(RoadGraph* roadGraph)
     : m_roadGraph(roadGraph)
 {
@@ -82,7 +63,11 @@ std::vector<QPointF> PathPlanner::findPath(const QPointF& start, const QPointF&
         return {};
     }
     
-    const auto& graph = m_roadGraph->getGraph();
+    const RoadNetwork& network = m_roadGraph->getNetwork();
+    if (network.empty()) {
+        utils::Logger::instance().warning("[PathPlanner] Graphe routier vide");
+        return {};
+    }
     
     // Log désactivé pour performances (génère trop de logs avec beaucoup de véhicules)
     // utils::Logger::instance().info(QString("[PathPlanner] Finding path from (%1, %2) to (%3, %4)")
@@ -93,6 +78,10 @@ std::vector<QPointF> PathPlanner::findPath(const QPointF& start, const QPointF&
     // Note: QPointF a x=longitude, y=latitude, mais getNearestNode attend (lat, lon)
     auto startVertex = m_roadGraph->getNearestNode(start.y(), start.x());
     auto endVertex = m_roadGraph->getNearestNode(end.y(), end.x());
+    if (startVertex == RoadGraph::nullVertex() || endVertex == RoadGraph::nullVertex()) {
+        utils::Logger::instance().warning("[PathPlanner] No road node near start or end (invalid position)");
+        return {};
+    }
     
     // Log désactivé pour performances
     // utils::Logger::instance().info(QString("[PathPlanner] Start vertex: %1, End vertex: %2")
@@ -103,55 +92,84 @@ std::vector<QPointF> PathPlanner::findPath(const QPointF& start, const QPointF&
         return {start, end};
     }
     
-    // Préparation pour A*
-    std::vector<VertexDescriptor> predecessors(boost::num_vertices(graph));
-    std::vector<double> distances(boost::num_vertices(graph), std::numeric_limits<double>::max());
+    // A* sur le graphe figé (CSR): tas binaire, entrées périmées ignorées; un
+    // nœud amélioré après sa sortie du tas y est remis (heuristique non
+    // strictement cohérente avec les longueurs en float)
+    SearchState& state = searchState;
+    state.begin(network.getNodeCount());
+    
+    const auto goal = static_cast<RoadNetwork::NodeId>(endVertex);
+    const double goalLat = network.getLatitude(goal);
+    const double goalLon = network.getLongitude(goal);
+    auto estimate = [&](RoadNetwork::NodeId node) {
+        return data::GeometryUtils::haversineDistance(network.getLatitude(node), network.getLongitude(node),
+                                                      goalLat, goalLon);
+    };
+    auto push = [&](RoadNetwork::NodeId node, double distance, RoadNetwork::NodeId predecessor) {
+        state.distance[node] = distance;
+        state.predecessor[node] = predecessor;
+        state.stamp[node] = state.generation;
+        state.heap.push_back({distance + estimate(node), distance, node});
+        std::push_heap(state.heap.begin(), state.heap.end(), std::greater<SearchEntry>());
+    };
     
     // Timeout adaptatif : limiter les itérations pour éviter les freezes
     // Pour Mulhouse (~2300 nœuds) : 10000 itérations = suffisant pour la plupart des chemins
-    int maxIterations = std::min(10000, static_cast<int>(boost::num_vertices(graph) * 5));
+    const int maxIterations = std::min(10000, static_cast<int>(network.getNodeCount() * 5));
+    int iterations = 0;
+    bool found = false;
     
-    try {
-        // Exécution de A* avec timeout
-        AStarHeuristic heuristic(graph, endVertex);
-        AStarGoalVisitor visitor(endVertex, maxIterations);
+    const auto source = static_cast<RoadNetwork::NodeId>(startVertex);
+    push(source, 0.0, source);
+    while (!state.heap.empty()) {
+        std::pop_heap(state.heap.begin(), state.heap.end(), std::greater<SearchEntry>());
+        const SearchEntry entry = state.heap.back();
+        state.heap.pop_back();
+        if (entry.distance > state.distance[entry.node]) {
+            continue;
+        }
         
-        boost::astar_search(
-            graph,
-            startVertex,
-            heuristic,
-            boost::predecessor_map(&predecessors[0])
-                .distance_map(&distances[0])
-                .visitor(visitor)
-                .weight_map(boost::get(&RoadEdge::length, graph))
-        );
+        // Vérifier d'abord si on a atteint le but
+        if (entry.node == goal) {
+            found = true;
+            break;
+        }
         
-    } catch (const FoundGoal& fg) {
-        // Vérifier si on a atteint le but ou si c'est un timeout
-        if (fg.timedOut) {
+        // Limiter le nombre d'itérations pour éviter les freezes
+        if (++iterations > maxIterations) {
             utils::Logger::instance().warning("[PathPlanner] A* timeout - chemin abandonné");
             return {};  // Retourner un chemin vide en cas de timeout
         }
         
+        for (auto e = network.outBegin(entry.node); e != network.outEnd(entry.node); ++e) {
+            const RoadNetwork::NodeId target = network.getTarget(e);
+            const double distance = entry.distance + network.getLength(e);
+            if (distance < state.distanceOf(target)) {
+                push(target, distance, entry.node);
+            }
+        }
+    }
+    
+    if (found) {
         // Chemin trouvé ! Reconstruire le chemin
-        std::vector<VertexDescriptor> path;
-        VertexDescriptor current = endVertex;
+        std::vector<RoadNetwork::NodeId> path;
+        RoadNetwork::NodeId current = goal;
         
-        while (current != startVertex) {
+        while (current != source) {
             path.push_back(current);
-            current = predecessors[current];
+            current = state.predecessor[current];
         }
-        path.push_back(startVertex);
+        path.push_back(source);
         
         std::reverse(path.begin(), path.end());
         
         // Convertir en QPointF
         std::vector<QPointF> result;
+        result.reserve(path.size() + 2);
         result.push_back(start); // Point de départ exact
         
-        for (const auto& vertex : path) {
-            const auto& node = graph[vertex];
-            result.push_back(QPointF(node.longitude, node.latitude));
+        for (RoadNetwork::NodeId node : path) {
+            result.push_back(network.getPosition(node));
         }
         
         result.push_back(end); // Point d'arrivée exact
@@ -171,10 +189,10 @@ std::vector<QPointF> PathPlanner::generateRandomPath(const QPointF& start, doubl
         return {start};
     }
     
-    const auto& graph = m_roadGraph->getGraph();
+    const RoadNetwork& network = m_roadGraph->getNetwork();
     
-    if (boost::num_vertices(graph) < 2) {
-        utils::Logger::instance().warning(QString("[PathPlanner] Not enough vertices: %1").arg(boost::num_vertices(graph)));
+    if (network.getNodeCount() < 2) {
+        utils::Logger::instance().warning(QString("[PathPlanner] Not enough vertices: %1").arg(network.getNodeCount()));
         return {start};
     }
     
@@ -187,26 +205,29 @@ std::vector<QPointF> PathPlanner::generateRandomPath(const QPointF& start, doubl
     // Trouver le nœud de départ le plus proche
     // Note: QPointF a x=longitude, y=latitude, mais getNearestNode attend (lat, lon)
     auto startVertex = m_roadGraph->getNearestNode(start.y(), start.x());
+    if (startVertex == RoadGraph::nullVertex()) {
+        utils::Logger::instance().warning("[PathPlanner] No road node near start (invalid position)");
+        return {};
+    }
     
     // Log désactivé pour performances
     // utils::Logger::instance().info(QString("[PathPlanner] Start vertex: %1").arg(startVertex));
     
-    // Générateur aléatoire
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Générateur aléatoire, un par thread (appels concurrents sans course)
+    thread_local std::mt19937 gen(std::random_device{}());
     
     // Sélectionner un nœud de destination aléatoire suffisamment loin
-    std::uniform_int_distribution<> dis(0, boost::num_vertices(graph) - 1);
-    VertexDescriptor endVertex;
+    std::uniform_int_distribution<> dis(0, static_cast<int>(network.getNodeCount()) - 1);
+    VertexDescriptor endVertex = startVertex;
     
     int attempts = 0;
     const int maxAttempts = 100;  // Augmenté de 50 à 100 pour plus de chances
     double bestDist = 0.0;
-    VertexDescriptor bestVertex = boost::vertex(dis(gen), graph);
+    VertexDescriptor bestVertex = dis(gen);
     
     // Chercher un nœud distant, garder le meilleur trouvé
     while (attempts < maxAttempts) {
-        VertexDescriptor candidate = boost::vertex(dis(gen), graph);
+        VertexDescriptor candidate = dis(gen);
         double dist = heuristic(startVertex, candidate);
         
         // Si distance parfaite trouvée, utiliser immédiatement
@@ -235,10 +256,7 @@ std::vector<QPointF> PathPlanner::generateRandomPath(const QPointF& start, doubl
     }
     
     // Calculer le chemin vers ce nœud
-    const auto& endNode = graph[endVertex];
-    QPointF endPoint(endNode.longitude, endNode.latitude);
-    
-    return findPath(start, endPoint);
+    return findPath(start, network.getPosition(static_cast<RoadNetwork::NodeId>(endVertex)));
 }
 
 double PathPlanner::heuristic(VertexDescriptor a, VertexDescriptor b) const {
@@ -246,23 +264,12 @@ double PathPlanner::heuristic(VertexDescriptor a, VertexDescriptor b) const {
         return 0.0;
     }
     
-    const auto& graph = m_roadGraph->getGraph();
-    const auto& nodeA = graph[a];
-    const auto& nodeB = graph[b];
-    
     // Distance de Haversine
-    const double R = 6371000.0; // Rayon de la Terre en mètres
-    const double lat1 = nodeA.latitude * M_PI / 180.0;
-    const double lat2 = nodeB.latitude * M_PI / 180.0;
-    const double dLat = (nodeB.latitude - nodeA.latitude) * M_PI / 180.0;
-    const double dLon = (nodeB.longitude - nodeA.longitude) * M_PI / 180.0;
-    
-    const double a_val = std::sin(dLat/2) * std::sin(dLat/2) +
-                    std::cos(lat1) * std::cos(lat2) *
-                    std::sin(dLon/2) * std::sin(dLon/2);
-    const double c = 2 * std::atan2(std::sqrt(a_val), std::sqrt(1-a_val));
-    
-    return R * c;
+    const RoadNetwork& network = m_roadGraph->getNetwork();
+    const auto nodeA = static_cast<RoadNetwork::NodeId>(a);
+    const auto nodeB = static_cast<RoadNetwork::NodeId>(b);
+    return data::GeometryUtils::haversineDistance(network.getLatitude(nodeA), network.getLongitude(nodeA),
+                                                  network.getLatitude(nodeB), network.getLongitude(nodeB));
 }
 
 } // namespace network
@@ -0,0 +1,147 @@
+#include "network/PropagationModel.hpp"
+#include "data/GeometryUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr double SPEED_OF_LIGHT = 299792458.0;
+
+// Table des pertes: 0.5 m de résolution jusqu'à 5 km (au-delà: formule)
+constexpr double TABLE_RESOLUTION = 0.5;
+constexpr double TABLE_MAX_DISTANCE = 5000.0;
+
+// Champ lointain (interférence): 25 m de résolution jusqu'à 100 km, l'erreur
+// d'interpolation relative y reste sous 1e-4
+constexpr double FAR_TABLE_RESOLUTION = 25.0;
+constexpr double FAR_TABLE_MAX_DISTANCE = 100000.0;
+
+// En dessous d'un mètre les formules divergent (champ proche): perte figée
+constexpr double MIN_DISTANCE = 1.0;
+
+// Table de probabilité: marges de -6 à +6 sigma, pas de sigma / 100
+constexpr double PROBABILITY_TABLE_SIGMAS = 6.0;
+constexpr int PROBABILITY_STEPS_PER_SIGMA = 100;
+
+// Quantile de LINK_PROBABILITY_EPSILON (1 %) de la loi normale
+constexpr double EPSILON_QUANTILE = 2.326;
+
+double normalCdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+}
+
+PropagationModel::PropagationModel(Type type)
+    : PropagationModel(type, Parameters())
+{
+}
+
+PropagationModel::PropagationModel(Type type, const Parameters& parameters)
+    : m_type(type)
+    , m_parameters(parameters)
+    , m_sigmaDb(type == Type::LogDistanceShadowing ? std::max(parameters.shadowingSigmaDb, 0.0) : 0.0)
+    , m_wavelength(SPEED_OF_LIGHT / parameters.frequencyHz)
+    , m_inverseResolution(1.0 / TABLE_RESOLUTION)
+    , m_lastIndex(0.0)
+    , m_nearMaxDistance(TABLE_MAX_DISTANCE)
+    , m_inverseFarResolution(1.0 / FAR_TABLE_RESOLUTION)
+    , m_tableMaxDistance(FAR_TABLE_MAX_DISTANCE)
+    , m_minMarginDb(0.0)
+    , m_inverseMarginStep(0.0)
+{
+    const size_t bins = static_cast<size_t>(TABLE_MAX_DISTANCE / TABLE_RESOLUTION) + 1;
+    m_pathLossTable.resize(bins);
+    m_pathGainTable.resize(bins);
+    for (size_t i = 0; i < bins; ++i) {
+        const double loss = pathLossDbExact(i * TABLE_RESOLUTION);
+        m_pathLossTable[i] = static_cast<float>(loss);
+        m_pathGainTable[i] = static_cast<float>(std::pow(10.0, -loss / 10.0));
+    }
+    m_lastIndex = static_cast<double>(bins - 1);
+    
+    const size_t farBins = static_cast<size_t>((FAR_TABLE_MAX_DISTANCE - TABLE_MAX_DISTANCE) / FAR_TABLE_RESOLUTION) + 1;
+    m_farPathLossTable.resize(farBins);
+    m_farPathGainTable.resize(farBins);
+    for (size_t i = 0; i < farBins; ++i) {
+        const double loss = pathLossDbExact(TABLE_MAX_DISTANCE + i * FAR_TABLE_RESOLUTION);
+        m_farPathLossTable[i] = static_cast<float>(loss);
+        m_farPathGainTable[i] = static_cast<float>(std::pow(10.0, -loss / 10.0));
+    }
+    
+    if (m_sigmaDb > 0.0) {
+        const int steps = static_cast<int>(2 * PROBABILITY_TABLE_SIGMAS * PROBABILITY_STEPS_PER_SIGMA);
+        const double marginStep = m_sigmaDb / PROBABILITY_STEPS_PER_SIGMA;
+        m_minMarginDb = -PROBABILITY_TABLE_SIGMAS * m_sigmaDb;
+        m_inverseMarginStep = 1.0 / marginStep;
+        m_probabilityTable.resize(steps + 1);
+        for (int i = 0; i <= steps; ++i) {
+            m_probabilityTable[i] = static_cast<float>(normalCdf((m_minMarginDb + i * marginStep) / m_sigmaDb));
+        }
+    }
+}
+
+const char* PropagationModel::typeName(Type type) {
+    switch (type) {
+        case Type::FreeSpace: return "free-space";
+        case Type::TwoRayGround: return "two-ray ground";
+        case Type::LogDistanceShadowing: return "log-distance + shadowing";
+        default: return "?";
+    }
+}
+
+double PropagationModel::pathLossDbExact(double distanceMeters) const {
+    const double d = std::max(distanceMeters, MIN_DISTANCE);
+    const double freeSpace = 20.0 * std::log10(4.0 * data::GeometryUtils::PI * d / m_wavelength);
+    
+    switch (m_type) {
+        case Type::FreeSpace:
+            return freeSpace;
+        
+        case Type::TwoRayGround: {
+            // Au-delà de la distance de croisement, la réflexion au sol domine (d^4)
+            const double ht = m_parameters.txAntennaHeight;
+            const double hr = m_parameters.rxAntennaHeight;
+            const double crossover = 4.0 * data::GeometryUtils::PI * ht * hr / m_wavelength;
+            if (d <= crossover) {
+                return freeSpace;
+            }
+            return 40.0 * std::log10(d) - 20.0 * std::log10(ht * hr);
+        }
+        
+        case Type::LogDistanceShadowing: {
+            const double d0 = std::max(m_parameters.referenceDistance, MIN_DISTANCE);
+            if (d <= d0) {
+                return freeSpace;
+            }
+            const double reference = 20.0 * std::log10(4.0 * data::GeometryUtils::PI * d0 / m_wavelength);
+            return reference + 10.0 * m_parameters.pathLossExponent * std::log10(d / d0);
+        }
+    }
+    return freeSpace;
+}
+
+double PropagationModel::txPowerForRange(double nominalRangeMeters) const {
+    return m_parameters.sensitivityDbm + pathLossDb(nominalRangeMeters);
+}
+
+double PropagationModel::maxRange(double pathLossBudgetDb) const {
+    // Pertes croissantes avec la distance: recherche dichotomique dans la table
+    const double limitDb = pathLossBudgetDb + EPSILON_QUANTILE * m_sigmaDb;
+    const auto it = std::upper_bound(m_pathLossTable.begin(), m_pathLossTable.end(), limitDb);
+    if (it == m_pathLossTable.end()) {
+        return TABLE_MAX_DISTANCE;
+    }
+    if (it == m_pathLossTable.begin()) {
+        return 0.0;
+    }
+    
+    // Interpolation entre les deux échantillons qui encadrent la limite
+    const size_t bin = static_cast<size_t>(it - m_pathLossTable.begin()) - 1;
+    const double t = (limitDb - m_pathLossTable[bin]) / (m_pathLossTable[bin + 1] - m_pathLossTable[bin]);
+    return (bin + t) * TABLE_RESOLUTION;
+}
+
+} // namespace network
+} // namespace v2v
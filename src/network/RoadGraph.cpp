@@ -1,17 +1,47 @@
 #include "network/RoadGraph.hpp"
+#include "data/GeometryUtils.hpp"
 #include "utils/Logger.hpp"
-#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <iterator>
 #include <cmath>
 
 namespace v2v {
 namespace network {
 
+namespace {
+size_t stringHeapBytes(const std::string& value) {
+    return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
+// Graphe Boost (vecS, vecS, bidirectionalS): par nœud, la propriété et deux
+// vecteurs d'arêtes; par arête, un nœud de la liste d'arêtes (deux pointeurs,
+// extrémités, propriété), une entrée sortante et une entrée entrante (cible,
+// itérateur de liste), plus les chaînes hors tampon interne
+size_t adjacencyListBytes(const RoadGraphType& graph) {
+    using EdgeEntry = std::pair<VertexDescriptor, void*>;
+    size_t bytes = boost::num_vertices(graph) * (sizeof(RoadNode) + 2 * sizeof(std::vector<EdgeEntry>));
+    bytes += boost::num_edges(graph)
+           * (2 * sizeof(void*) + 2 * sizeof(VertexDescriptor) + sizeof(RoadEdge) + 2 * sizeof(EdgeEntry));
+    
+    auto [ei, eiEnd] = boost::edges(graph);
+    for (auto it = ei; it != eiEnd; ++it) {
+        const RoadEdge& edge = graph[*it];
+        bytes += stringHeapBytes(edge.roadType) + stringHeapBytes(edge.name);
+    }
+    return bytes;
+}
+}
+
 RoadGraph::RoadGraph() {
     LOG_INFO("RoadGraph created");
 }
 
 void RoadGraph::clear() {
     m_graph.clear();
+    m_network.clear();
+    m_memoryReport = MemoryReport();
     m_spatialIndex.clear();
 }
 
@@ -20,95 +50,175 @@ VertexDescriptor RoadGraph::addNode(double lat, double lon) {
     node.id = boost::num_vertices(m_graph);
     node.latitude = lat;
     node.longitude = lon;
-    node.position = QPointF(lon, lat);
     
     return boost::add_vertex(node, m_graph);
 }
 
 void RoadGraph::addEdge(VertexDescriptor from, VertexDescriptor to,
-                        double length, double speedLimit, const std::string& roadType) {
+                        double length, double speedLimit, const std::string& roadType,
+                        const std::string& name) {
     RoadEdge edge;
     edge.length = length;
     edge.speedLimit = speedLimit;
     edge.roadType = roadType;
+    edge.name = name;
     
     boost::add_edge(from, to, edge, m_graph);
 }
 
+void RoadGraph::finalize() {
+    const size_t nodeCount = boost::num_vertices(m_graph);
+    const size_t edgeCount = boost::num_edges(m_graph);
+    
+    RoadNetwork network;
+    network.m_latitudes.reserve(nodeCount);
+    network.m_longitudes.reserve(nodeCount);
+    network.m_outOffsets.reserve(nodeCount + 1);
+    network.m_targets.reserve(edgeCount);
+    network.m_lengths.reserve(edgeCount);
+    network.m_speedLimits.reserve(edgeCount);
+    network.m_roadClasses.reserve(edgeCount);
+    network.m_nameIds.reserve(edgeCount);
+    
+    // CSR direct: arêtes sortantes de chaque nœud dans l'ordre d'ajout,
+    // noms internés à la première occurrence
+    std::unordered_map<std::string, uint32_t> nameIds;
+    nameIds.emplace(std::string(), 0);
+    for (VertexDescriptor v = 0; v < nodeCount; ++v) {
+        const RoadNode& node = m_graph[v];
+        network.m_latitudes.push_back(node.latitude);
+        network.m_longitudes.push_back(node.longitude);
+        
+        auto [oi, oiEnd] = boost::out_edges(v, m_graph);
+        for (auto it = oi; it != oiEnd; ++it) {
+            const RoadEdge& edge = m_graph[*it];
+            network.m_targets.push_back(static_cast<uint32_t>(boost::target(*it, m_graph)));
+            network.m_lengths.push_back(static_cast<float>(edge.length));
+            network.m_speedLimits.push_back(static_cast<float>(edge.speedLimit));
+            network.m_roadClasses.push_back(roadClassFromTag(edge.roadType));
+            
+            auto [name, inserted] = nameIds.emplace(edge.name, static_cast<uint32_t>(network.m_names.size()));
+            if (inserted) {
+                network.m_names.push_back(edge.name);
+            }
+            network.m_nameIds.push_back(name->second);
+        }
+        network.m_outOffsets.push_back(static_cast<uint32_t>(network.m_targets.size()));
+    }
+    
+    // CSR inverse: comptage par cible puis placement (sources croissantes)
+    network.m_inOffsets.assign(nodeCount + 1, 0);
+    for (uint32_t target : network.m_targets) {
+        ++network.m_inOffsets[target + 1];
+    }
+    for (size_t v = 0; v < nodeCount; ++v) {
+        network.m_inOffsets[v + 1] += network.m_inOffsets[v];
+    }
+    std::vector<uint32_t> cursor(network.m_inOffsets.begin(), network.m_inOffsets.end() - 1);
+    network.m_inSources.resize(edgeCount);
+    network.m_inEdges.resize(edgeCount);
+    for (uint32_t v = 0; v < nodeCount; ++v) {
+        for (uint32_t e = network.m_outOffsets[v]; e < network.m_outOffsets[v + 1]; ++e) {
+            const uint32_t entry = cursor[network.m_targets[e]]++;
+            network.m_inSources[entry] = v;
+            network.m_inEdges[entry] = e;
+        }
+    }
+    network.m_names.shrink_to_fit();
+    
+    m_memoryReport.nodes = nodeCount;
+    m_memoryReport.edges = edgeCount;
+    m_memoryReport.names = network.getNameCount();
+    m_memoryReport.adjacencyListBytes = adjacencyListBytes(m_graph);
+    m_memoryReport.compactBytes = network.getMemoryBytes();
+    
+    // Le graphe Boost n'est plus lu: libéré
+    m_network = std::move(network);
+    m_graph = RoadGraphType();
+    
+    buildSpatialIndex();
+    
+    LOG_INFO(QString("Road network: %1 nodes, %2 edges, %3 names, CSR %4 MB vs adjacency list %5 MB (%6x smaller)")
+             .arg(m_memoryReport.nodes)
+             .arg(m_memoryReport.edges)
+             .arg(m_memoryReport.names)
+             .arg(m_memoryReport.compactBytes / (1024.0 * 1024.0), 0, 'f', 2)
+             .arg(m_memoryReport.adjacencyListBytes / (1024.0 * 1024.0), 0, 'f', 2)
+             .arg(m_memoryReport.compactBytes > 0
+                  ? static_cast<double>(m_memoryReport.adjacencyListBytes) / m_memoryReport.compactBytes : 0.0, 0, 'f', 1));
+}
+
 VertexDescriptor RoadGraph::getNearestNode(double lat, double lon) const {
     if (m_spatialIndex.empty()) {
         LOG_WARNING("Spatial index is empty");
-        return VertexDescriptor();
+        return nullVertex();
+    }
+    if (!std::isfinite(lat) || !std::isfinite(lon)) {
+        return nullVertex();
     }
     
-    // Recherche du nœud le plus proche avec early exit
-    double minDist = std::numeric_limits<double>::max();
-    VertexDescriptor nearest;
+    NodeRTreeValue nearest;
+    m_spatialIndex.query(bgi::nearest(toPoint(lat, lon), 1), &nearest);
+    return nearest.second;
+}
+
+void RoadGraph::getNearestNodes(double lat, double lon, size_t k,
+                                std::vector<VertexDescriptor>& out) const {
+    out.clear();
+    if (k == 0 || m_spatialIndex.empty() || !std::isfinite(lat) || !std::isfinite(lon)) {
+        return;
+    }
     
-    // Limite de recherche : si on trouve un nœud à moins de 50m, on arrête
-    const double earlyExitThreshold = 0.0005; // ~50m en degrés
+    const NodePoint center = toPoint(lat, lon);
+    std::vector<NodeRTreeValue> results;
+    results.reserve(std::min(k, m_spatialIndex.size()));
+    m_spatialIndex.query(bgi::nearest(center, static_cast<unsigned>(std::min(k, m_spatialIndex.size()))),
+                         std::back_inserter(results));
     
-    for (const auto& spatialNode : m_spatialIndex) {
-        // Calcul rapide de distance Manhattan avant Haversine complète
-        double dLat = std::abs(lat - spatialNode.lat);
-        double dLon = std::abs(lon - spatialNode.lon);
-        
-        // Skip si clairement trop loin (> 1° = ~111km)
-        if (dLat > 1.0 || dLon > 1.0) continue;
-        
-        double dist = calculateDistance(lat, lon, spatialNode.lat, spatialNode.lon);
-        if (dist < minDist) {
-            minDist = dist;
-            nearest = spatialNode.vertex;
-            
-            // Early exit si très proche
-            if (minDist < earlyExitThreshold) {
-                break;
-            }
-        }
+    // Ordre de sortie de bgi::nearest non garanti: tri par corde (ex aequo: nœud croissant)
+    std::vector<std::pair<double, RoadNetwork::NodeId>> ranked;
+    ranked.reserve(results.size());
+    for (const auto& [point, node] : results) {
+        ranked.emplace_back(bg::comparable_distance(center, point), node);
     }
+    std::sort(ranked.begin(), ranked.end());
     
-    return nearest;
+    out.reserve(ranked.size());
+    for (const auto& entry : ranked) {
+        out.push_back(entry.second);
+    }
 }
 
 size_t RoadGraph::getNodeCount() const {
-    return boost::num_vertices(m_graph);
+    return m_network.empty() ? boost::num_vertices(m_graph) : m_network.getNodeCount();
 }
 
 size_t RoadGraph::getEdgeCount() const {
-    return boost::num_edges(m_graph);
+    return m_network.empty() ? boost::num_edges(m_graph) : m_network.getEdgeCount();
 }
 
 void RoadGraph::buildSpatialIndex() {
     LOG_INFO("Building spatial index...");
-    m_spatialIndex.clear();
     
-    // Parcourir tous les vertices
-    auto vertices = boost::vertices(m_graph);
-    for (auto it = vertices.first; it != vertices.second; ++it) {
-        const RoadNode& node = m_graph[*it];
-        
-        SpatialNode spatialNode;
-        spatialNode.vertex = *it;
-        spatialNode.lat = node.latitude;
-        spatialNode.lon = node.longitude;
-        
-        m_spatialIndex.push_back(spatialNode);
+    std::vector<NodeRTreeValue> values;
+    values.reserve(m_network.getNodeCount());
+    for (RoadNetwork::NodeId node = 0; node < m_network.getNodeCount(); ++node) {
+        values.emplace_back(toPoint(m_network.getLatitude(node), m_network.getLongitude(node)), node);
     }
     
+    // Construction en bloc (packing STR): plus rapide et arbre mieux équilibré
+    m_spatialIndex = NodeRTree(values.begin(), values.end());
+    
     LOG_INFO(QString("Spatial index built with %1 nodes").arg(m_spatialIndex.size()));
 }
 
-double RoadGraph::calculateDistance(double lat1, double lon1, double lat2, double lon2) const {
-    // Formule de Haversine
-    const double R = 6371000.0; // Rayon Terre en mètres
-    double dLat = (lat2 - lat1) * M_PI / 180.0;
-    double dLon = (lon2 - lon1) * M_PI / 180.0;
-    double a = std::sin(dLat/2) * std::sin(dLat/2) +
-               std::cos(lat1 * M_PI / 180.0) * std::cos(lat2 * M_PI / 180.0) *
-               std::sin(dLon/2) * std::sin(dLon/2);
-    double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1-a));
-    return R * c;
+RoadGraph::NodePoint RoadGraph::toPoint(double lat, double lon) {
+    const double phi = data::GeometryUtils::degToRad(lat);
+    const double lambda = data::GeometryUtils::degToRad(lon);
+    const double r = data::GeometryUtils::EARTH_RADIUS_M;
+    return NodePoint(r * std::cos(phi) * std::cos(lambda),
+                     r * std::cos(phi) * std::sin(lambda),
+                     r * std::sin(phi));
 }
 
 } // namespace network
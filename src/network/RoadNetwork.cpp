@@ -0,0 +1,94 @@
+#include "network/RoadNetwork.hpp"
+
+namespace v2v {
+namespace network {
+
+namespace {
+struct RoadClassTag {
+    std::string_view tag;
+    RoadClass roadClass;
+};
+
+constexpr RoadClassTag ROAD_CLASS_TAGS[] = {
+    {"motorway", RoadClass::Motorway},
+    {"trunk", RoadClass::Trunk},
+    {"primary", RoadClass::Primary},
+    {"secondary", RoadClass::Secondary},
+    {"tertiary", RoadClass::Tertiary},
+    {"unclassified", RoadClass::Unclassified},
+    {"residential", RoadClass::Residential},
+    {"service", RoadClass::Service}
+};
+
+template <typename T>
+size_t capacityBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+}
+
+RoadClass roadClassFromTag(std::string_view tag) {
+    if (tag.ends_with("_link")) {
+        return RoadClass::Link;
+    }
+    for (const auto& entry : ROAD_CLASS_TAGS) {
+        if (entry.tag == tag) {
+            return entry.roadClass;
+        }
+    }
+    return RoadClass::Other;
+}
+
+const char* roadClassName(RoadClass roadClass) {
+    switch (roadClass) {
+        case RoadClass::Motorway: return "motorway";
+        case RoadClass::Trunk: return "trunk";
+        case RoadClass::Primary: return "primary";
+        case RoadClass::Secondary: return "secondary";
+        case RoadClass::Tertiary: return "tertiary";
+        case RoadClass::Unclassified: return "unclassified";
+        case RoadClass::Residential: return "residential";
+        case RoadClass::Service: return "service";
+        case RoadClass::Link: return "link";
+        case RoadClass::Other: break;
+    }
+    return "other";
+}
+
+RoadNetwork::RoadNetwork() {
+    clear();
+}
+
+size_t RoadNetwork::getMemoryBytes() const {
+    size_t bytes = capacityBytes(m_latitudes) + capacityBytes(m_longitudes)
+                 + capacityBytes(m_outOffsets) + capacityBytes(m_targets)
+                 + capacityBytes(m_lengths) + capacityBytes(m_speedLimits)
+                 + capacityBytes(m_roadClasses) + capacityBytes(m_nameIds)
+                 + capacityBytes(m_inOffsets) + capacityBytes(m_inSources)
+                 + capacityBytes(m_inEdges) + capacityBytes(m_names);
+    
+    // Noms hors du tampon interne de std::string
+    for (const auto& name : m_names) {
+        if (name.capacity() > std::string().capacity()) {
+            bytes += name.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+void RoadNetwork::clear() {
+    m_latitudes.clear();
+    m_longitudes.clear();
+    m_outOffsets.assign(1, 0);
+    m_targets.clear();
+    m_lengths.clear();
+    m_speedLimits.clear();
+    m_roadClasses.clear();
+    m_nameIds.clear();
+    m_inOffsets.assign(1, 0);
+    m_inSources.clear();
+    m_inEdges.clear();
+    m_names.assign(1, std::string());
+}
+
+} // namespace network
+} // namespace v2v
@@ -0,0 +1,696 @@
+#include "network/RoadsideUnits.hpp"
+#include "network/ComponentTracker.hpp"
+#include "core/Vehicle.hpp"
+#include "data/GeometryUtils.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr double METERS_PER_DEGREE =
+    data::GeometryUtils::EARTH_RADIUS_M * data::GeometryUtils::PI / 180.0;
+
+// Nombre maximal de cellules de la grille de couverture (au-delà: cellules agrandies)
+constexpr double MAX_COVERAGE_CELLS = 16.0 * 1024 * 1024;
+
+// Marges du classement des cellules: exclusion (mètres, plus une part du
+// rayon pour l'écart de la projection locale) et cellule pleine (corde,
+// mètres: bombement des parallèles entre deux coins, ~1e-5 m à 25 m)
+constexpr double EXCLUSION_MARGIN = 1.0;
+constexpr double EXCLUSION_MARGIN_RATIO = 1e-3;
+constexpr double FULL_CELL_MARGIN = 1e-3;
+
+// Durées de service (secondes), comme les durées de liens de LinkStatistics
+constexpr double MIN_SERVICE_TIME = 0.1;
+constexpr double MAX_SERVICE_TIME = 1e4;
+constexpr int SERVICE_BINS_PER_DECADE = 20;
+
+// Distance approchée (projection locale à la latitude de la RSU, cosLat, en
+// mètres) du centre de la RSU au point le plus proche de la cellule
+// [lat0, lat1] x [lon0, lon1]
+double minimumDistance(const RoadsideUnits::Unit& unit, double cosLat,
+                       double lat0, double lat1, double lon0, double lon1) {
+    const double dx = (std::clamp(unit.longitude, lon0, lon1) - unit.longitude) * METERS_PER_DEGREE * cosLat;
+    const double dy = (std::clamp(unit.latitude, lat0, lat1) - unit.latitude) * METERS_PER_DEGREE;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+double exclusionMargin(const RoadsideUnits::Unit& unit) {
+    return EXCLUSION_MARGIN + EXCLUSION_MARGIN_RATIO * unit.radius;
+}
+
+bool parseNumber(const std::string& field, double& value) {
+    const char* begin = field.c_str();
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    while (end && (*end == ' ' || *end == '\t' || *end == '\r')) ++end;
+    return end != begin && end && *end == '\0' && std::isfinite(value);
+}
+
+bool parseFlag(const std::string& field, bool& value) {
+    std::string flag;
+    for (char c : field) {
+        if (c != ' ' && c != '\t' && c != '\r') {
+            flag += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    if (flag.empty() || flag == "0" || flag == "false" || flag == "no") {
+        value = false;
+        return true;
+    }
+    if (flag == "1" || flag == "true" || flag == "yes") {
+        value = true;
+        return true;
+    }
+    return false;
+}
+}
+
+RoadsideUnits::RoadsideUnits()
+    : m_minLon(0.0)
+    , m_minLat(0.0)
+    , m_cellLon(1.0)
+    , m_cellLat(1.0)
+    , m_cols(0)
+    , m_rows(0)
+    , m_coveredCells(0)
+    , m_fullCells(0)
+    , m_decidedCells(0)
+    , m_epoch(0)
+    , m_lastTime(0.0)
+    , m_hasTime(false)
+    , m_covered(0)
+    , m_backhaulCovered(0)
+    , m_relayReachable(0)
+    , m_vehicleTime(0.0)
+    , m_coveredTime(0.0)
+    , m_backhaulTime(0.0)
+    , m_attachments(0)
+    , m_detachments(0)
+    , m_handovers(0)
+    , m_pingPongs(0)
+    , m_serviceTimes(MIN_SERVICE_TIME, MAX_SERVICE_TIME, SERVICE_BINS_PER_DECADE)
+{
+}
+
+RoadsideUnits::~RoadsideUnits() = default;
+
+bool RoadsideUnits::loadFile(const std::string& filename, double defaultRadius) {
+    std::ifstream in(filename);
+    if (!in) {
+        LOG_ERROR(QString("Cannot read roadside units: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    std::vector<Unit> units;
+    std::string line;
+    int lineNumber = 0;
+    int rejected = 0;
+    bool header = true;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        
+        std::vector<std::string> fields;
+        std::istringstream stream(line);
+        for (std::string field; std::getline(stream, field, ',');) {
+            fields.push_back(field);
+        }
+        
+        Unit unit;
+        unit.radius = defaultRadius;
+        double id = 0.0;
+        bool valid = fields.size() >= 3 && fields.size() <= 5
+            && parseNumber(fields[0], id) && id >= 0.0 && id == std::floor(id)
+            && id <= std::numeric_limits<int>::max()
+            && parseNumber(fields[1], unit.latitude) && parseNumber(fields[2], unit.longitude)
+            && (fields.size() < 4 || parseNumber(fields[3], unit.radius))
+            && (fields.size() < 5 || parseFlag(fields[4], unit.backhaul));
+        unit.defaultRadius = fields.size() < 4;
+        valid = valid && std::abs(unit.latitude) <= 90.0 && std::abs(unit.longitude) <= 180.0
+            && unit.radius > 0.0;
+        
+        // Première ligne non numérique: en-tête
+        if (!valid && header) {
+            header = false;
+            continue;
+        }
+        header = false;
+        
+        if (!valid) {
+            LOG_WARNING(QString("Roadside units: line %1 ignored").arg(lineNumber));
+            ++rejected;
+            continue;
+        }
+        unit.id = static_cast<int>(id);
+        units.push_back(unit);
+    }
+    
+    if (units.empty()) {
+        LOG_ERROR(QString("No roadside unit in %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    m_units.clear();
+    for (const Unit& unit : units) {
+        addUnit(unit);
+    }
+    build();
+    
+    LOG_INFO(QString("Roadside units loaded from %1: %2 units, %3 lines ignored")
+             .arg(QString::fromStdString(filename))
+             .arg(m_units.size())
+             .arg(rejected));
+    return true;
+}
+
+size_t RoadsideUnits::setDefaultRadius(double radius) {
+    size_t count = 0;
+    bool changed = false;
+    for (Unit& unit : m_units) {
+        if (!unit.defaultRadius) continue;
+        ++count;
+        changed = changed || unit.radius != radius;
+        unit.radius = radius;
+    }
+    if (changed) {
+        build();
+    }
+    return count;
+}
+
+void RoadsideUnits::addUnit(const Unit& unit) {
+    auto it = std::find_if(m_units.begin(), m_units.end(),
+                           [&](const Unit& existing) { return existing.id == unit.id; });
+    if (it != m_units.end()) {
+        *it = unit;
+    } else {
+        m_units.push_back(unit);
+    }
+}
+
+void RoadsideUnits::setParameters(const Parameters& parameters) {
+    const bool rebuild = parameters.cellSize != m_parameters.cellSize
+        || parameters.hysteresis != m_parameters.hysteresis;
+    m_parameters = parameters;
+    m_parameters.cellSize = std::max(parameters.cellSize, 1.0);
+    m_parameters.hysteresis = std::max(parameters.hysteresis, 0.0);
+    if (rebuild && !m_units.empty()) {
+        build();
+    }
+}
+
+void RoadsideUnits::build() {
+    const auto start = std::chrono::steady_clock::now();
+    
+    m_frame.setMetric(LinkMetric::Chord);
+    m_frame.reserve(m_units.size());
+    m_cellStart.clear();
+    m_coverage.clear();
+    m_cellUnit.clear();
+    m_coveredCells = 0;
+    m_fullCells = 0;
+    m_decidedCells = 0;
+    m_cols = 0;
+    m_rows = 0;
+    resetStatistics();
+    if (m_units.empty()) {
+        return;
+    }
+    
+    // Emprise des disques, en degrés
+    auto lonSpan = [](const Unit& unit) {
+        const double cosLat = std::max(std::cos(data::GeometryUtils::degToRad(unit.latitude)), 1e-6);
+        return unit.radius / (METERS_PER_DEGREE * cosLat);
+    };
+    double minLon = std::numeric_limits<double>::max();
+    double minLat = std::numeric_limits<double>::max();
+    double maxLon = std::numeric_limits<double>::lowest();
+    double maxLat = std::numeric_limits<double>::lowest();
+    for (const Unit& unit : m_units) {
+        m_frame.push(unit.latitude, unit.longitude, unit.radius);
+        minLon = std::min(minLon, unit.longitude - lonSpan(unit));
+        maxLon = std::max(maxLon, unit.longitude + lonSpan(unit));
+        minLat = std::min(minLat, unit.latitude - unit.radius / METERS_PER_DEGREE);
+        maxLat = std::max(maxLat, unit.latitude + unit.radius / METERS_PER_DEGREE);
+    }
+    
+    // Cellules d'environ cellSize mètres de côté à la latitude moyenne,
+    // agrandies si l'emprise en demanderait trop
+    const double midCos = std::max(std::cos(data::GeometryUtils::degToRad(0.5 * (minLat + maxLat))), 1e-6);
+    m_cellLat = m_parameters.cellSize / METERS_PER_DEGREE;
+    m_cellLon = m_parameters.cellSize / (METERS_PER_DEGREE * midCos);
+    const double cells = std::ceil((maxLon - minLon) / m_cellLon) * std::ceil((maxLat - minLat) / m_cellLat);
+    if (cells > MAX_COVERAGE_CELLS) {
+        const double scale = std::sqrt(cells / MAX_COVERAGE_CELLS) * 1.01;
+        m_cellLat *= scale;
+        m_cellLon *= scale;
+    }
+    // Une cellule de marge: l'emprise en longitude d'un disque est calculée à
+    // la latitude de son centre (écart de quelques centimètres aux bords)
+    m_minLon = minLon - m_cellLon;
+    m_minLat = minLat - m_cellLat;
+    m_cols = static_cast<int>(std::ceil((maxLon - minLon) / m_cellLon)) + 2;
+    m_rows = static_cast<int>(std::ceil((maxLat - minLat) / m_cellLat)) + 2;
+    const size_t cellCount = static_cast<size_t>(m_cols) * m_rows;
+    
+    // Sommets de la grille dans le repère des RSU (mêmes formules que
+    // LinkFrame::project): sinus et cosinus par ligne et par colonne
+    std::vector<double> rowCos(m_rows + 1), rowSin(m_rows + 1), colCos(m_cols + 1), colSin(m_cols + 1);
+    for (int row = 0; row <= m_rows; ++row) {
+        const double lat = data::GeometryUtils::degToRad(m_minLat + row * m_cellLat);
+        rowCos[row] = data::GeometryUtils::EARTH_RADIUS_M * std::cos(lat);
+        rowSin[row] = data::GeometryUtils::EARTH_RADIUS_M * std::sin(lat);
+    }
+    for (int col = 0; col <= m_cols; ++col) {
+        const double lon = data::GeometryUtils::degToRad(m_minLon + col * m_cellLon);
+        colCos[col] = std::cos(lon);
+        colSin[col] = std::sin(lon);
+    }
+    
+    // Carré de la plus grande distance (corde) de la RSU aux 4 coins de la cellule
+    auto farthestCorner = [&](size_t unitIndex, int row, int col) {
+        double farthest = 0.0;
+        for (int corner = 0; corner < 4; ++corner) {
+            const int r = row + (corner >> 1);
+            const int c = col + (corner & 1);
+            const double cx = rowCos[r] * colCos[c] - m_frame.originX() - m_frame.x[unitIndex];
+            const double cy = rowCos[r] * colSin[c] - m_frame.originY() - m_frame.y[unitIndex];
+            const double cz = rowSin[r] - m_frame.originZ() - m_frame.z[unitIndex];
+            farthest = std::max(farthest, cx * cx + cy * cy + cz * cz);
+        }
+        return farthest;
+    };
+    
+    std::vector<double> unitCos(m_units.size());
+    for (size_t unitIndex = 0; unitIndex < m_units.size(); ++unitIndex) {
+        unitCos[unitIndex] = std::max(std::cos(data::GeometryUtils::degToRad(m_units[unitIndex].latitude)), 1e-6);
+    }
+    
+    // Entrées (cellule, RSU) de chaque disque, puis tri par cellule (CSR)
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    for (size_t unitIndex = 0; unitIndex < m_units.size(); ++unitIndex) {
+        const Unit& unit = m_units[unitIndex];
+        const double reach = unit.radius + exclusionMargin(unit);
+        const double fullChord = m_frame.chordRadius[unitIndex] - FULL_CELL_MARGIN;
+        
+        const int col0 = std::clamp(static_cast<int>((unit.longitude - lonSpan(unit) - m_minLon) / m_cellLon) - 1, 0, m_cols - 1);
+        const int col1 = std::clamp(static_cast<int>((unit.longitude + lonSpan(unit) - m_minLon) / m_cellLon) + 1, 0, m_cols - 1);
+        const int row0 = std::clamp(static_cast<int>((unit.latitude - unit.radius / METERS_PER_DEGREE - m_minLat) / m_cellLat) - 1, 0, m_rows - 1);
+        const int row1 = std::clamp(static_cast<int>((unit.latitude + unit.radius / METERS_PER_DEGREE - m_minLat) / m_cellLat) + 1, 0, m_rows - 1);
+        
+        for (int row = row0; row <= row1; ++row) {
+            const double lat0 = m_minLat + row * m_cellLat;
+            const double lat1 = lat0 + m_cellLat;
+            for (int col = col0; col <= col1; ++col) {
+                const double lon0 = m_minLon + col * m_cellLon;
+                const double lon1 = lon0 + m_cellLon;
+                
+                if (minimumDistance(unit, unitCos[unitIndex], lat0, lat1, lon0, lon1) > reach) continue;
+                
+                // Pleine si les 4 coins sont dans le disque (distance exacte)
+                const bool full = fullChord > 0.0 && farthestCorner(unitIndex, row, col) <= fullChord * fullChord;
+                entries.emplace_back(static_cast<uint32_t>(static_cast<size_t>(row) * m_cols + col),
+                                     static_cast<uint32_t>(unitIndex) | (full ? FULL_CELL : 0u));
+            }
+        }
+    }
+    
+    m_cellStart.assign(cellCount + 1, 0);
+    for (const auto& entry : entries) {
+        ++m_cellStart[entry.first + 1];
+    }
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        if (m_cellStart[cell + 1] > 0) ++m_coveredCells;
+        m_cellStart[cell + 1] += m_cellStart[cell];
+    }
+    m_coverage.resize(entries.size());
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (const auto& entry : entries) {
+        m_coverage[cursor[entry.first]++] = entry.second;
+    }
+    
+    // Cellules décidées d'avance: une RSU U couvre toute la cellule et toute
+    // autre RSU en est plus loin, en tout point, que U (coin le plus éloigné)
+    // plus l'hystérésis: U est choisie quelle que soit la RSU servante
+    m_cellUnit.assign(cellCount, NO_UNIT);
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        const uint32_t begin = m_cellStart[cell];
+        const uint32_t end = m_cellStart[cell + 1];
+        if (begin == end) continue;
+        
+        const int row = static_cast<int>(cell / m_cols);
+        const int col = static_cast<int>(cell % m_cols);
+        const double lat0 = m_minLat + row * m_cellLat;
+        const double lat1 = lat0 + m_cellLat;
+        const double lon0 = m_minLon + col * m_cellLon;
+        const double lon1 = lon0 + m_cellLon;
+        int best = -1;
+        double bestReach = std::numeric_limits<double>::max();
+        for (uint32_t entry = begin; entry < end; ++entry) {
+            if (!(m_coverage[entry] & FULL_CELL)) continue;
+            const int unit = static_cast<int>(m_coverage[entry] & ~FULL_CELL);
+            const double farthest = std::sqrt(farthestCorner(unit, row, col));
+            if (farthest < bestReach) {
+                best = unit;
+                bestReach = farthest;
+            }
+        }
+        m_cellUnit[cell] = MIXED_CELL;
+        if (best < 0) continue;
+        ++m_fullCells;
+        
+        bool decided = true;
+        for (uint32_t entry = begin; entry < end && decided; ++entry) {
+            const int unit = static_cast<int>(m_coverage[entry] & ~FULL_CELL);
+            decided = unit == best
+                || minimumDistance(m_units[unit], unitCos[unit], lat0, lat1, lon0, lon1) - exclusionMargin(m_units[unit])
+                   > bestReach + FULL_CELL_MARGIN + m_parameters.hysteresis;
+        }
+        if (decided) {
+            m_cellUnit[cell] = best;
+            ++m_decidedCells;
+        }
+    }
+    
+    const size_t backhaulUnits = std::count_if(m_units.begin(), m_units.end(),
+                                               [](const Unit& unit) { return unit.backhaul; });
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    LOG_INFO(QString("Roadside units: %1 (%2 with backhaul), coverage grid %3 x %4 cells, "
+                     "%5 covered (%6 fully, %7 decided), %8 entries, %9 ms")
+             .arg(m_units.size())
+             .arg(backhaulUnits)
+             .arg(m_cols)
+             .arg(m_rows)
+             .arg(m_coveredCells)
+             .arg(m_fullCells)
+             .arg(m_decidedCells)
+             .arg(m_coverage.size())
+             .arg(elapsedMs, 0, 'f', 1));
+}
+
+int RoadsideUnits::associate(double latitude, double longitude, int current) const {
+    const double col = std::floor((longitude - m_minLon) / m_cellLon);
+    const double row = std::floor((latitude - m_minLat) / m_cellLat);
+    if (!(col >= 0.0 && col < m_cols && row >= 0.0 && row < m_rows)) {
+        return -1;
+    }
+    
+    const size_t cell = static_cast<size_t>(row) * m_cols + static_cast<size_t>(col);
+    if (m_cellUnit[cell] != MIXED_CELL) {
+        return m_cellUnit[cell];
+    }
+    
+    // Cellule partielle ou partagée: distances exactes aux RSU de la cellule
+    // (corde ~ mètres à ces portées, écart sous le micromètre pour l'hystérésis)
+    const uint32_t begin = m_cellStart[cell];
+    const uint32_t end = m_cellStart[cell + 1];
+    double px, py, pz;
+    m_frame.project(latitude, longitude, px, py, pz);
+    int best = -1;
+    double bestDistance = std::numeric_limits<double>::max();
+    double currentDistance = -1.0;
+    for (uint32_t entry = begin; entry < end; ++entry) {
+        const int unit = static_cast<int>(m_coverage[entry] & ~FULL_CELL);
+        const double dx = px - m_frame.x[unit];
+        const double dy = py - m_frame.y[unit];
+        const double dz = pz - m_frame.z[unit];
+        const double squared = dx * dx + dy * dy + dz * dz;
+        const double chordRadius = m_frame.chordRadius[unit];
+        if (!(m_coverage[entry] & FULL_CELL) && squared > chordRadius * chordRadius) continue;
+        
+        const double distance = std::sqrt(squared);
+        if (distance < bestDistance || (best >= 0 && distance == bestDistance && m_units[unit].id < m_units[best].id)) {
+            best = unit;
+            bestDistance = distance;
+        }
+        if (unit == current) {
+            currentDistance = distance;
+        }
+    }
+    
+    if (currentDistance >= 0.0 && currentDistance <= bestDistance + m_parameters.hysteresis) {
+        return current;
+    }
+    return best;
+}
+
+int RoadsideUnits::findServingUnit(double latitude, double longitude) const {
+    if (m_cellStart.empty()) {
+        return -1;
+    }
+    const int unit = associate(latitude, longitude, -1);
+    return unit >= 0 ? m_units[unit].id : -1;
+}
+
+int RoadsideUnits::getServingUnit(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_states.size()) {
+        return -1;
+    }
+    const VehicleState& state = m_states[vehicleId];
+    return state.seenEpoch == m_epoch && state.serving >= 0 ? m_units[state.serving].id : -1;
+}
+
+void RoadsideUnits::countCoverage(int unit, int delta) {
+    UnitStats& stats = m_unitStats[unit];
+    stats.attached += delta;
+    stats.peakAttached = std::max(stats.peakAttached, stats.attached);
+    m_covered += delta;
+    if (m_units[unit].backhaul) {
+        m_backhaulCovered += delta;
+    }
+}
+
+void RoadsideUnits::detach(VehicleState& state, double time) {
+    m_serviceTimes.add(time - state.servingSince);
+    countCoverage(state.serving, -1);
+    state.serving = -1;
+}
+
+void RoadsideUnits::update(const std::vector<std::shared_ptr<core::Vehicle>>& vehicles,
+                           double simulationTime, const ComponentTracker* clusters) {
+    if (m_cellStart.empty()) {
+        return;
+    }
+    
+    // Durées écoulées depuis l'update précédent, avec les associations d'alors
+    if (m_hasTime && simulationTime > m_lastTime) {
+        const double elapsed = simulationTime - m_lastTime;
+        m_vehicleTime += m_present.size() * elapsed;
+        m_coveredTime += m_covered * elapsed;
+        m_backhaulTime += m_backhaulCovered * elapsed;
+        for (UnitStats& stats : m_unitStats) {
+            stats.servedTime += stats.attached * elapsed;
+        }
+    }
+    m_lastTime = simulationTime;
+    m_hasTime = true;
+    
+    ++m_epoch;
+    m_seen.clear();
+    for (const auto& vehicle : vehicles) {
+        if (!vehicle->isActive() || vehicle->getId() < 0) continue;
+        
+        const int vehicleId = vehicle->getId();
+        if (static_cast<size_t>(vehicleId) >= m_states.size()) {
+            m_states.resize(vehicleId + 1);
+        }
+        VehicleState& state = m_states[vehicleId];
+        if (state.seenEpoch != m_epoch - 1) {
+            state.previous = -1;    // Réapparu: pas de ping-pong avec une RSU d'avant
+        }
+        state.seenEpoch = m_epoch;
+        m_seen.push_back(vehicleId);
+        
+        const int next = associate(vehicle->getLatitude(), vehicle->getLongitude(), state.serving);
+        if (next == state.serving) continue;
+        
+        if (state.serving >= 0 && next >= 0) {
+            ++m_handovers;
+            ++m_unitStats[state.serving].handoversOut;
+            ++m_unitStats[next].handoversIn;
+            if (next == state.previous && simulationTime - state.handoverTime <= m_parameters.pingPongWindow) {
+                ++m_pingPongs;
+            }
+            state.previous = state.serving;
+            state.handoverTime = simulationTime;
+            detach(state, simulationTime);
+        } else if (state.serving >= 0) {
+            ++m_detachments;
+            detach(state, simulationTime);
+            continue;
+        } else {
+            ++m_attachments;
+        }
+        
+        ++m_unitStats[next].attachments;
+        countCoverage(next, 1);
+        state.serving = next;
+        state.servingSince = simulationTime;
+    }
+    
+    // Véhicules disparus (retirés ou inactifs): fin de service sans sortie de couverture
+    for (int vehicleId : m_present) {
+        VehicleState& state = m_states[vehicleId];
+        if (state.seenEpoch != m_epoch && state.serving >= 0) {
+            detach(state, simulationTime);
+        }
+    }
+    m_present.swap(m_seen);
+    
+    // Portée multi-saut: véhicules d'un cluster V2V qui contient un véhicule
+    // servi par une RSU reliée au backhaul
+    if (!clusters) {
+        m_relayReachable = m_backhaulCovered;
+        return;
+    }
+    m_relayReachable = 0;
+    for (int vehicleId : m_present) {
+        const VehicleState& state = m_states[vehicleId];
+        const int cluster = clusters->getClusterId(vehicleId);
+        if (state.serving < 0 || !m_units[state.serving].backhaul || cluster < 0) continue;
+        if (static_cast<size_t>(cluster) >= m_clusterMarks.size()) {
+            m_clusterMarks.resize(cluster + 1, 0);
+        }
+        m_clusterMarks[cluster] = m_epoch;
+    }
+    for (int vehicleId : m_present) {
+        const int cluster = clusters->getClusterId(vehicleId);
+        const bool served = m_states[vehicleId].serving >= 0 && m_units[m_states[vehicleId].serving].backhaul;
+        if (served || (cluster >= 0 && static_cast<size_t>(cluster) < m_clusterMarks.size()
+                       && m_clusterMarks[cluster] == m_epoch)) {
+            ++m_relayReachable;
+        }
+    }
+}
+
+RoadsideUnits::Summary RoadsideUnits::getSummary() const {
+    Summary summary;
+    summary.units = m_units.size();
+    summary.backhaulUnits = std::count_if(m_units.begin(), m_units.end(),
+                                          [](const Unit& unit) { return unit.backhaul; });
+    summary.vehicles = m_present.size();
+    summary.covered = m_covered;
+    summary.backhaulCovered = m_backhaulCovered;
+    summary.relayReachable = m_relayReachable;
+    if (m_vehicleTime > 0.0) {
+        summary.coverageRatio = m_coveredTime / m_vehicleTime;
+        summary.backhaulCoverageRatio = m_backhaulTime / m_vehicleTime;
+    }
+    summary.attachments = m_attachments;
+    summary.detachments = m_detachments;
+    summary.handovers = m_handovers;
+    summary.pingPongs = m_pingPongs;
+    if (m_coveredTime > 0.0) {
+        summary.handoverRate = m_handovers * 3600.0 / m_coveredTime;
+    }
+    summary.meanServiceTime = m_serviceTimes.mean();
+    return summary;
+}
+
+void RoadsideUnits::logSummary() const {
+    const Summary summary = getSummary();
+    LOG_INFO(QString("Roadside units: %1 (%2 with backhaul), coverage %3% (backhaul %4%), "
+                     "%5 vehicles served, %6 reach backhaul over V2V")
+             .arg(summary.units)
+             .arg(summary.backhaulUnits)
+             .arg(summary.coverageRatio * 100.0, 0, 'f', 1)
+             .arg(summary.backhaulCoverageRatio * 100.0, 0, 'f', 1)
+             .arg(summary.covered)
+             .arg(summary.relayReachable));
+    LOG_INFO(QString("  %1 attachments, %2 detachments, %3 handovers (%4 ping-pong, %5 per service hour)")
+             .arg(summary.attachments)
+             .arg(summary.detachments)
+             .arg(summary.handovers)
+             .arg(summary.pingPongs)
+             .arg(summary.handoverRate, 0, 'f', 1));
+    LOG_INFO(QString("  service time (s): n=%1 mean %2 p50 %3 p90 %4 max %5")
+             .arg(m_serviceTimes.count())
+             .arg(m_serviceTimes.mean(), 0, 'g', 4)
+             .arg(m_serviceTimes.quantile(0.5), 0, 'g', 4)
+             .arg(m_serviceTimes.quantile(0.9), 0, 'g', 4)
+             .arg(m_serviceTimes.max(), 0, 'g', 4));
+}
+
+bool RoadsideUnits::writeReport(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out) {
+        LOG_ERROR(QString("Cannot write roadside unit statistics: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    const Summary summary = getSummary();
+    out << "metric,value\n"
+        << "units," << summary.units << '\n'
+        << "backhaul_units," << summary.backhaulUnits << '\n'
+        << "coverage_ratio," << summary.coverageRatio << '\n'
+        << "backhaul_coverage_ratio," << summary.backhaulCoverageRatio << '\n'
+        << "attachments," << summary.attachments << '\n'
+        << "detachments," << summary.detachments << '\n'
+        << "handovers," << summary.handovers << '\n'
+        << "ping_pongs," << summary.pingPongs << '\n'
+        << "handovers_per_service_hour," << summary.handoverRate << '\n'
+        << "service_time_mean_s," << m_serviceTimes.mean() << '\n'
+        << "service_time_p50_s," << m_serviceTimes.quantile(0.5) << '\n'
+        << "service_time_p90_s," << m_serviceTimes.quantile(0.9) << '\n';
+    
+    out << "\nid,latitude,longitude,radius_m,backhaul,attached,peak_attached,attachments,"
+           "handovers_in,handovers_out,served_vehicle_s\n";
+    for (size_t unit = 0; unit < m_units.size(); ++unit) {
+        const Unit& info = m_units[unit];
+        const UnitStats& stats = m_unitStats[unit];
+        out << info.id << ',' << info.latitude << ',' << info.longitude << ',' << info.radius << ','
+            << (info.backhaul ? 1 : 0) << ',' << stats.attached << ',' << stats.peakAttached << ','
+            << stats.attachments << ',' << stats.handoversIn << ',' << stats.handoversOut << ','
+            << stats.servedTime << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+void RoadsideUnits::resetStatistics() {
+    m_states.clear();
+    m_present.clear();
+    m_seen.clear();
+    m_unitStats.assign(m_units.size(), UnitStats{});
+    m_hasTime = false;
+    m_lastTime = 0.0;
+    m_covered = 0;
+    m_backhaulCovered = 0;
+    m_relayReachable = 0;
+    m_vehicleTime = 0.0;
+    m_coveredTime = 0.0;
+    m_backhaulTime = 0.0;
+    m_attachments = 0;
+    m_detachments = 0;
+    m_handovers = 0;
+    m_pingPongs = 0;
+    m_serviceTimes.clear();
+}
+
+void RoadsideUnits::clear() {
+    m_units.clear();
+    m_frame.clear();
+    m_cellStart.clear();
+    m_coverage.clear();
+    m_cellUnit.clear();
+    m_cols = 0;
+    m_rows = 0;
+    m_coveredCells = 0;
+    m_fullCells = 0;
+    m_decidedCells = 0;
+    resetStatistics();
+}
+
+} // namespace network
+} // namespace v2v
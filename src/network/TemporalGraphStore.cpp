@@ -0,0 +1,644 @@
+#include "network/TemporalGraphStore.hpp"
+#include "network/InterferenceGraph.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <span>
+
+namespace v2v {
+namespace network {
+
+namespace {
+constexpr char FILE_MAGIC[8] = {'V', '2', 'V', 'T', 'G', 'S', '0', '1'};
+constexpr size_t DEFAULT_MEMORY_LIMIT = size_t(256) << 20;
+
+uint64_t pairKey(int vehicleId1, int vehicleId2) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(vehicleId1)) << 32) | static_cast<uint32_t>(vehicleId2);
+}
+
+// Entiers variables LEB128: 7 bits par octet, bit de poids fort = suite
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        const uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Plages triées codées par écarts: (début - fin précédente, longueur)
+template <typename Runs>
+void putRuns(std::vector<uint8_t>& out, const Runs& runs) {
+    putVarint(out, runs.size());
+    uint32_t previousEnd = 0;
+    for (const auto& run : runs) {
+        putVarint(out, run.start - previousEnd);
+        putVarint(out, run.end - run.start);
+        previousEnd = run.end;
+    }
+}
+
+bool getRuns(const uint8_t*& in, const uint8_t* end, uint32_t updateCount,
+             std::vector<TemporalGraphStore::Run>& runs) {
+    uint64_t count;
+    if (!getVarint(in, end, count) || count > updateCount) return false;
+    
+    runs.clear();
+    uint64_t previousEnd = 0;
+    for (uint64_t k = 0; k < count; ++k) {
+        uint64_t gap, length;
+        if (!getVarint(in, end, gap) || !getVarint(in, end, length)) return false;
+        const uint64_t start = previousEnd + gap;
+        previousEnd = start + length;
+        if (length == 0 || previousEnd > updateCount) return false;
+        runs.push_back({static_cast<uint32_t>(start), static_cast<uint32_t>(previousEnd)});
+    }
+    return true;
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool contains(const TemporalGraphStore::Run& run, int64_t update) {
+    return run.start <= update && update < run.end;
+}
+}
+
+TemporalGraphStore::TemporalGraphStore()
+    : m_resync(false)
+    , m_memoryLimit(DEFAULT_MEMORY_LIMIT)
+    , m_droppedUpdates(0)
+{
+    m_presenceOffsets.assign(1, 0);
+    m_linkOffsets.assign(1, 0);
+}
+
+// ============================================================================
+// Enregistrement
+// ============================================================================
+
+void TemporalGraphStore::update(const InterferenceGraph& graph) {
+    // Limite atteinte: historique figé, les plages ouvertes le restent
+    // jusqu'au dernier update enregistré
+    if (m_droppedUpdates > 0 || (m_memoryLimit > 0 && getMemoryBytes() >= m_memoryLimit)) {
+        if (m_droppedUpdates++ == 0) {
+            LOG_WARNING(QString("Temporal graph memory limit reached (%1 MB): recording stopped after %2 updates")
+                        .arg(m_memoryLimit >> 20).arg(m_timeline.size()));
+        }
+        return;
+    }
+    
+    const auto update = static_cast<uint32_t>(m_timeline.size());
+    const bool first = m_timeline.empty();
+    m_timeline.push_back(graph.getUpdateTime());
+    
+    // Présence: un véhicule absent à l'update précédent ouvre une nouvelle plage
+    for (int id : graph.getVehicleIds()) {
+        if (static_cast<size_t>(id) >= m_lastSeen.size()) {
+            m_presenceStart.resize(id + 1, ABSENT);
+            m_lastSeen.resize(id + 1, ABSENT);
+        }
+        if (m_presenceStart[id] != ABSENT && m_lastSeen[id] + 1 != update) {
+            closePresence(id);
+        }
+        if (m_presenceStart[id] == ABSENT) {
+            m_presenceStart[id] = update;
+        }
+        m_lastSeen[id] = update;
+    }
+    
+    // Premier update, ou reprise: l'adjacence courante fait foi (delta du
+    // graphe incomplet). Liens ouverts absents clos au dernier update
+    // enregistré, liens présents ouverts s'ils ne l'étaient pas.
+    if (first || m_resync) {
+        m_resync = false;
+        std::unordered_map<uint64_t, uint32_t> stillOpen;
+        for (const auto& [id1, id2] : graph.getAllConnections()) {
+            const uint64_t key = pairKey(id1, id2);
+            const auto it = m_openLinks.find(key);
+            stillOpen.emplace(key, it != m_openLinks.end() ? it->second : update);
+        }
+        for (const auto& [key, start] : m_openLinks) {
+            if (!stillOpen.contains(key)) {
+                m_closedLinks.push_back({static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key)),
+                                         start, update});
+            }
+        }
+        m_openLinks.swap(stillOpen);
+        return;
+    }
+    
+    for (const LinkEvent& event : graph.getLinkEvents()) {
+        if (event.type == LinkEvent::Type::Up) {
+            openLink(event.vehicleId1, event.vehicleId2, update);
+            continue;
+        }
+        
+        const auto it = m_openLinks.find(pairKey(event.vehicleId1, event.vehicleId2));
+        if (it != m_openLinks.end()) {
+            m_closedLinks.push_back({event.vehicleId1, event.vehicleId2, it->second, update});
+            m_openLinks.erase(it);
+        }
+    }
+}
+
+void TemporalGraphStore::openLink(int vehicleId1, int vehicleId2, uint32_t update) {
+    m_openLinks.emplace(pairKey(vehicleId1, vehicleId2), update);
+}
+
+void TemporalGraphStore::closePresence(int vehicleId) {
+    m_closedPresence.push_back({vehicleId, -1, m_presenceStart[vehicleId], m_lastSeen[vehicleId] + 1});
+    m_presenceStart[vehicleId] = ABSENT;
+}
+
+void TemporalGraphStore::finish() {
+    const auto updateCount = static_cast<uint32_t>(m_timeline.size());
+    const size_t closedLinks = m_closedLinks.size();
+    const size_t closedPresence = m_closedPresence.size();
+    
+    // Plages encore ouvertes ajoutées le temps de l'indexation seulement:
+    // l'enregistrement continue avec les mêmes plages ouvertes
+    for (const auto& [key, start] : m_openLinks) {
+        m_closedLinks.push_back({static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key)),
+                                 start, updateCount});
+    }
+    for (size_t id = 0; id < m_presenceStart.size(); ++id) {
+        if (m_presenceStart[id] != ABSENT) {
+            m_closedPresence.push_back({static_cast<int>(id), -1, m_presenceStart[id], m_lastSeen[id] + 1});
+        }
+    }
+    
+    buildIndex(m_closedLinks, m_closedPresence);
+    
+    m_closedLinks.resize(closedLinks);
+    m_closedPresence.resize(closedPresence);
+}
+
+void TemporalGraphStore::buildIndex(const std::vector<Record>& links, const std::vector<Record>& presence) {
+    // Véhicules connus: tout véhicule d'un lien a une plage de présence
+    m_vehicleIds.clear();
+    for (const Record& record : presence) {
+        m_vehicleIds.push_back(record.id1);
+    }
+    std::sort(m_vehicleIds.begin(), m_vehicleIds.end());
+    m_vehicleIds.erase(std::unique(m_vehicleIds.begin(), m_vehicleIds.end()), m_vehicleIds.end());
+    
+    m_indexOfId.assign(m_vehicleIds.empty() ? 0 : m_vehicleIds.back() + 1, -1);
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        m_indexOfId[m_vehicleIds[i]] = static_cast<int>(i);
+    }
+    
+    const size_t n = m_vehicleIds.size();
+    
+    // Présence: comptage, offsets, remplissage puis tri de chaque ligne
+    m_presenceOffsets.assign(n + 1, 0);
+    for (const Record& record : presence) {
+        ++m_presenceOffsets[indexOf(record.id1) + 1];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        m_presenceOffsets[i + 1] += m_presenceOffsets[i];
+    }
+    m_presenceRuns.resize(m_presenceOffsets[n]);
+    std::vector<size_t> cursor(m_presenceOffsets.begin(), m_presenceOffsets.end() - 1);
+    for (const Record& record : presence) {
+        m_presenceRuns[cursor[indexOf(record.id1)]++] = {record.start, record.end};
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::sort(m_presenceRuns.begin() + m_presenceOffsets[i], m_presenceRuns.begin() + m_presenceOffsets[i + 1],
+                  [](const Run& a, const Run& b) { return a.start < b.start; });
+    }
+    
+    // Liens: chaque plage rangée chez ses deux extrémités, lignes triées par
+    // (voisin, début)
+    m_linkOffsets.assign(n + 1, 0);
+    for (const Record& record : links) {
+        const int i1 = indexOf(record.id1);
+        const int i2 = indexOf(record.id2);
+        if (i1 < 0 || i2 < 0) continue;
+        ++m_linkOffsets[i1 + 1];
+        ++m_linkOffsets[i2 + 1];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        m_linkOffsets[i + 1] += m_linkOffsets[i];
+    }
+    m_links.resize(m_linkOffsets[n]);
+    cursor.assign(m_linkOffsets.begin(), m_linkOffsets.end() - 1);
+    for (const Record& record : links) {
+        const int i1 = indexOf(record.id1);
+        const int i2 = indexOf(record.id2);
+        if (i1 < 0 || i2 < 0) continue;
+        m_links[cursor[i1]++] = {record.id2, {record.start, record.end}};
+        m_links[cursor[i2]++] = {record.id1, {record.start, record.end}};
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::sort(m_links.begin() + m_linkOffsets[i], m_links.begin() + m_linkOffsets[i + 1],
+                  [](const LinkEntry& a, const LinkEntry& b) {
+                      return a.neighbor != b.neighbor ? a.neighbor < b.neighbor : a.run.start < b.run.start;
+                  });
+    }
+}
+
+// ============================================================================
+// Requêtes
+// ============================================================================
+
+int TemporalGraphStore::indexOf(int vehicleId) const {
+    if (vehicleId < 0 || static_cast<size_t>(vehicleId) >= m_indexOfId.size()) {
+        return -1;
+    }
+    return m_indexOfId[vehicleId];
+}
+
+int64_t TemporalGraphStore::updateAt(double time) const {
+    return std::upper_bound(m_timeline.begin(), m_timeline.end(), time) - m_timeline.begin() - 1;
+}
+
+bool TemporalGraphStore::isConnected(int vehicleId1, int vehicleId2, double time) const {
+    const int64_t update = updateAt(time);
+    const int index = indexOf(vehicleId1);
+    if (update < 0 || index < 0) return false;
+    
+    // Dernière plage du lien commencée au plus tard à cet update
+    const auto begin = m_links.begin() + m_linkOffsets[index];
+    const auto end = m_links.begin() + m_linkOffsets[index + 1];
+    const auto after = std::upper_bound(begin, end, std::make_pair(vehicleId2, update),
+        [](const std::pair<int, int64_t>& key, const LinkEntry& entry) {
+            return key.first != entry.neighbor ? key.first < entry.neighbor : key.second < entry.run.start;
+        });
+    return after != begin && std::prev(after)->neighbor == vehicleId2 && contains(std::prev(after)->run, update);
+}
+
+bool TemporalGraphStore::isPresent(int vehicleId, double time) const {
+    const int64_t update = updateAt(time);
+    const int index = indexOf(vehicleId);
+    if (update < 0 || index < 0) return false;
+    
+    const auto begin = m_presenceRuns.begin() + m_presenceOffsets[index];
+    const auto end = m_presenceRuns.begin() + m_presenceOffsets[index + 1];
+    const auto after = std::upper_bound(begin, end, update,
+        [](int64_t value, const Run& run) { return value < run.start; });
+    return after != begin && contains(*std::prev(after), update);
+}
+
+std::vector<int> TemporalGraphStore::getNeighborsAt(int vehicleId, double time) const {
+    std::vector<int> neighbors;
+    const int64_t update = updateAt(time);
+    const int index = indexOf(vehicleId);
+    if (update < 0 || index < 0) return neighbors;
+    
+    // Plages d'un même lien disjointes: chaque voisin apparaît au plus une fois
+    for (size_t k = m_linkOffsets[index]; k < m_linkOffsets[index + 1]; ++k) {
+        if (contains(m_links[k].run, update)) {
+            neighbors.push_back(m_links[k].neighbor);
+        }
+    }
+    return neighbors;
+}
+
+size_t TemporalGraphStore::getDegreeAt(int vehicleId, double time) const {
+    return getNeighborsAt(vehicleId, time).size();
+}
+
+std::vector<int> TemporalGraphStore::getNeighborsDuring(int vehicleId, double time0, double time1) const {
+    std::vector<int> neighbors;
+    const int64_t first = std::max<int64_t>(updateAt(time0), 0);
+    const int64_t last = updateAt(time1);
+    const int index = indexOf(vehicleId);
+    if (last < first || index < 0) return neighbors;
+    
+    for (size_t k = m_linkOffsets[index]; k < m_linkOffsets[index + 1]; ++k) {
+        const LinkEntry& entry = m_links[k];
+        if (entry.run.start <= last && entry.run.end > first &&
+            (neighbors.empty() || neighbors.back() != entry.neighbor)) {
+            neighbors.push_back(entry.neighbor);
+        }
+    }
+    return neighbors;
+}
+
+std::vector<std::pair<double, size_t>> TemporalGraphStore::getDegreeSeries(int vehicleId, double time0,
+                                                                           double time1) const {
+    const int64_t first = updateAt(time0);
+    const int64_t last = updateAt(time1);
+    const int index = indexOf(vehicleId);
+    
+    // Degré au début de l'intervalle, puis variations aux updates de (first, last]
+    size_t degree = 0;
+    std::vector<std::pair<int64_t, int>> changes;
+    if (index >= 0) {
+        for (size_t k = m_linkOffsets[index]; k < m_linkOffsets[index + 1]; ++k) {
+            const Run& run = m_links[k].run;
+            if (first >= 0 && contains(run, first)) {
+                ++degree;
+            }
+            if (run.start > first && run.start <= last) {
+                changes.emplace_back(run.start, +1);
+            }
+            if (run.end > first && run.end <= last) {
+                changes.emplace_back(run.end, -1);
+            }
+        }
+    }
+    std::sort(changes.begin(), changes.end());
+    
+    std::vector<std::pair<double, size_t>> series;
+    series.emplace_back(time0, degree);
+    for (size_t k = 0; k < changes.size();) {
+        const int64_t update = changes[k].first;
+        int64_t delta = 0;
+        for (; k < changes.size() && changes[k].first == update; ++k) {
+            delta += changes[k].second;
+        }
+        if (delta != 0) {
+            degree = static_cast<size_t>(static_cast<int64_t>(degree) + delta);
+            series.emplace_back(m_timeline[update], degree);
+        }
+    }
+    return series;
+}
+
+std::vector<TemporalGraphStore::Run> TemporalGraphStore::getLinkRuns(int vehicleId1, int vehicleId2) const {
+    std::vector<Run> runs;
+    const int index = indexOf(vehicleId1);
+    if (index < 0) return runs;
+    
+    const auto begin = m_links.begin() + m_linkOffsets[index];
+    const auto end = m_links.begin() + m_linkOffsets[index + 1];
+    auto it = std::lower_bound(begin, end, vehicleId2,
+        [](const LinkEntry& entry, int neighbor) { return entry.neighbor < neighbor; });
+    for (; it != end && it->neighbor == vehicleId2; ++it) {
+        runs.push_back(it->run);
+    }
+    return runs;
+}
+
+std::vector<int> TemporalGraphStore::getVehiclesAt(double time) const {
+    std::vector<int> vehicles;
+    for (int id : m_vehicleIds) {
+        if (isPresent(id, time)) {
+            vehicles.push_back(id);
+        }
+    }
+    return vehicles;
+}
+
+template <typename Visitor>
+void TemporalGraphStore::forEachLinkAt(int64_t update, Visitor&& visit) const {
+    if (update < 0) return;
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        const int id = m_vehicleIds[i];
+        for (size_t k = m_linkOffsets[i]; k < m_linkOffsets[i + 1]; ++k) {
+            const LinkEntry& entry = m_links[k];
+            if (entry.neighbor > id && contains(entry.run, update)) {
+                visit(id, entry.neighbor, entry.run);
+            }
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> TemporalGraphStore::getConnectionsAt(double time) const {
+    std::vector<std::pair<int, int>> connections;
+    forEachLinkAt(updateAt(time), [&](int id1, int id2, const Run&) {
+        connections.emplace_back(id1, id2);
+    });
+    return connections;
+}
+
+// ============================================================================
+// Exports et format disque
+// ============================================================================
+
+bool TemporalGraphStore::exportCsv(const std::string& filename, double time) const {
+    std::ofstream out(filename);
+    if (!out) {
+        LOG_ERROR(QString("Cannot write graph snapshot: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    // Une ligne par lien, avec l'instant de formation de sa plage en cours
+    out << "vehicle1,vehicle2,since_s\n";
+    forEachLinkAt(updateAt(time), [&](int id1, int id2, const Run& run) {
+        out << id1 << ',' << id2 << ',' << m_timeline[run.start] << '\n';
+    });
+    return static_cast<bool>(out);
+}
+
+bool TemporalGraphStore::exportGraphML(const std::string& filename, double time) const {
+    std::ofstream out(filename);
+    if (!out) {
+        LOG_ERROR(QString("Cannot write graph snapshot: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    const int64_t update = updateAt(time);
+    const std::vector<int> vehicles = getVehiclesAt(time);
+    
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+        << "  <key id=\"time\" for=\"graph\" attr.name=\"time\" attr.type=\"double\"/>\n"
+        << "  <key id=\"degree\" for=\"node\" attr.name=\"degree\" attr.type=\"int\"/>\n"
+        << "  <key id=\"since\" for=\"edge\" attr.name=\"since\" attr.type=\"double\"/>\n"
+        << "  <graph id=\"v2v\" edgedefault=\"undirected\">\n"
+        << "    <data key=\"time\">" << time << "</data>\n";
+    for (int id : vehicles) {
+        out << "    <node id=\"v" << id << "\"><data key=\"degree\">"
+            << getNeighborsAt(id, time).size() << "</data></node>\n";
+    }
+    forEachLinkAt(update, [&](int id1, int id2, const Run& run) {
+        out << "    <edge source=\"v" << id1 << "\" target=\"v" << id2 << "\"><data key=\"since\">"
+            << m_timeline[run.start] << "</data></edge>\n";
+    });
+    out << "  </graph>\n</graphml>\n";
+    return static_cast<bool>(out);
+}
+
+bool TemporalGraphStore::save(const std::string& filename) const {
+    // Données: par véhicule, présence puis liens vers les IDs supérieurs
+    // groupés par voisin (écart d'ID, nombre de plages, plages)
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> offsets(m_vehicleIds.size());
+    std::vector<Run> runs;
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        const int id = m_vehicleIds[i];
+        offsets[i] = data.size();
+        putRuns(data, std::span<const Run>(m_presenceRuns.data() + m_presenceOffsets[i],
+                                           m_presenceOffsets[i + 1] - m_presenceOffsets[i]));
+        
+        const auto begin = m_links.begin() + m_linkOffsets[i];
+        const auto end = m_links.begin() + m_linkOffsets[i + 1];
+        const auto upper = std::upper_bound(begin, end, id,
+            [](int value, const LinkEntry& entry) { return value < entry.neighbor; });
+        
+        uint64_t groups = 0;
+        for (auto it = upper; it != end; ++it) {
+            groups += it == upper || it->neighbor != std::prev(it)->neighbor;
+        }
+        putVarint(data, groups);
+        
+        int previousNeighbor = id;
+        for (auto it = upper; it != end;) {
+            runs.clear();
+            const int neighbor = it->neighbor;
+            for (; it != end && it->neighbor == neighbor; ++it) {
+                runs.push_back(it->run);
+            }
+            putVarint(data, static_cast<uint64_t>(neighbor - previousNeighbor));
+            putRuns(data, runs);
+            previousNeighbor = neighbor;
+        }
+    }
+    
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        LOG_ERROR(QString("Cannot write temporal graph: %1").arg(QString::fromStdString(filename)));
+        return false;
+    }
+    
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    writeValue(out, static_cast<uint32_t>(m_timeline.size()));
+    out.write(reinterpret_cast<const char*>(m_timeline.data()), m_timeline.size() * sizeof(double));
+    writeValue(out, static_cast<uint32_t>(m_vehicleIds.size()));
+    for (size_t i = 0; i < m_vehicleIds.size(); ++i) {
+        writeValue(out, static_cast<int32_t>(m_vehicleIds[i]));
+        writeValue(out, offsets[i]);
+    }
+    writeValue(out, static_cast<uint64_t>(data.size()));
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    
+    LOG_INFO(QString("Temporal graph saved: %1 updates, %2 vehicles, %3 link runs, %4 KB (%5 bytes/run)")
+             .arg(m_timeline.size())
+             .arg(m_vehicleIds.size())
+             .arg(getLinkRunCount())
+             .arg(data.size() / 1024)
+             .arg(getLinkRunCount() > 0 ? static_cast<double>(data.size()) / getLinkRunCount() : 0.0, 0, 'f', 1));
+    return static_cast<bool>(out);
+}
+
+bool TemporalGraphStore::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    auto fail = [&](const char* reason) {
+        LOG_ERROR(QString("Cannot load temporal graph %1: %2").arg(QString::fromStdString(filename)).arg(reason));
+        return false;
+    };
+    if (!in) return fail("cannot open file");
+    
+    char magic[sizeof(FILE_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        return fail("not a temporal graph file");
+    }
+    
+    // Tailles lues dans l'en-tête bornées par les octets restants avant toute
+    // allocation: un fichier tronqué ou corrompu ne peut pas en demander plus
+    const auto bodyStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto fileEnd = in.tellg();
+    in.seekg(bodyStart);
+    auto remaining = [&]() { return static_cast<uint64_t>(fileEnd - in.tellg()); };
+    
+    uint32_t updateCount = 0;
+    uint32_t vehicleCount = 0;
+    uint64_t dataSize = 0;
+    std::vector<double> timeline;
+    if (!readValue(in, updateCount)) return fail("truncated header");
+    if (updateCount > remaining() / sizeof(double)) return fail("truncated timeline");
+    timeline.resize(updateCount);
+    if (!in.read(reinterpret_cast<char*>(timeline.data()), updateCount * sizeof(double)) ||
+        !readValue(in, vehicleCount)) {
+        return fail("truncated timeline");
+    }
+    
+    if (vehicleCount > remaining() / (sizeof(int32_t) + sizeof(uint64_t))) return fail("truncated index");
+    std::vector<std::pair<int32_t, uint64_t>> index(vehicleCount);
+    for (auto& [id, offset] : index) {
+        if (!readValue(in, id) || !readValue(in, offset) || id < 0) return fail("bad index");
+    }
+    if (!readValue(in, dataSize)) return fail("truncated index");
+    if (dataSize > remaining()) return fail("truncated data");
+    std::vector<uint8_t> data(dataSize);
+    if (!in.read(reinterpret_cast<char*>(data.data()), dataSize)) return fail("truncated data");
+    
+    // Décodage de chaque véhicule à son offset
+    std::vector<Record> links;
+    std::vector<Record> presence;
+    std::vector<Run> runs;
+    for (const auto& [id, offset] : index) {
+        if (offset > data.size()) return fail("bad offset");
+        const uint8_t* cursor = data.data() + offset;
+        const uint8_t* end = data.data() + data.size();
+        
+        if (!getRuns(cursor, end, updateCount, runs)) return fail("bad presence runs");
+        for (const Run& run : runs) {
+            presence.push_back({id, -1, run.start, run.end});
+        }
+        
+        uint64_t groups;
+        if (!getVarint(cursor, end, groups)) return fail("bad link groups");
+        int64_t neighbor = id;
+        for (uint64_t g = 0; g < groups; ++g) {
+            uint64_t gap;
+            if (!getVarint(cursor, end, gap) || gap == 0) return fail("bad neighbor");
+            neighbor += static_cast<int64_t>(gap);
+            if (neighbor > INT32_MAX || !getRuns(cursor, end, updateCount, runs)) return fail("bad link runs");
+            for (const Run& run : runs) {
+                links.push_back({id, static_cast<int>(neighbor), run.start, run.end});
+            }
+        }
+    }
+    
+    clear();
+    m_timeline = std::move(timeline);
+    buildIndex(links, presence);
+    
+    LOG_INFO(QString("Temporal graph loaded: %1 updates, %2 vehicles, %3 link runs")
+             .arg(m_timeline.size()).arg(m_vehicleIds.size()).arg(getLinkRunCount()));
+    return true;
+}
+
+size_t TemporalGraphStore::getMemoryBytes() const {
+    return m_timeline.capacity() * sizeof(double)
+         + (m_closedLinks.capacity() + m_closedPresence.capacity()) * sizeof(Record)
+         + m_openLinks.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void*))
+         + (m_presenceStart.capacity() + m_lastSeen.capacity()) * sizeof(uint32_t)
+         + (m_vehicleIds.capacity() + m_indexOfId.capacity()) * sizeof(int)
+         + (m_presenceOffsets.capacity() + m_linkOffsets.capacity()) * sizeof(size_t)
+         + m_presenceRuns.capacity() * sizeof(Run)
+         + m_links.capacity() * sizeof(LinkEntry);
+}
+
+void TemporalGraphStore::clear() {
+    m_timeline.clear();
+    m_closedLinks.clear();
+    m_closedPresence.clear();
+    m_openLinks.clear();
+    m_presenceStart.clear();
+    m_lastSeen.clear();
+    m_resync = false;
+    m_droppedUpdates = 0;
+    m_vehicleIds.clear();
+    m_indexOfId.clear();
+    m_presenceOffsets.assign(1, 0);
+    m_presenceRuns.clear();
+    m_linkOffsets.assign(1, 0);
+    m_links.clear();
+}
+
+} // namespace network
+} // namespace v2v
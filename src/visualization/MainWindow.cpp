@@ -3,6 +3,14 @@
 #include "core/SimulationEngine.hpp"
 #include "network/RoadGraph.hpp"
 #include "network/InterferenceGraph.hpp"
+#include "network/GraphSnapshot.hpp"
+#include "network/ComponentTracker.hpp"
+#include "network/GraphMetrics.hpp"
+#include "network/MacLayer.hpp"
+#include "network/BeaconScheduler.hpp"
+#include "network/BuildingIndex.hpp"
+#include "network/RoadsideUnits.hpp"
+#include "network/ChannelAssignment.hpp"
 #include "data/OSMParser.hpp"
 #include "utils/Logger.hpp"
 #include <QVBoxLayout>
@@ -14,6 +22,7 @@
 #include <QMenu>
 #include <QLabel>
 #include <QFrame>
+#include <QSignalBlocker>
 
 namespace v2v {
 namespace visualization {
@@ -36,6 +45,9 @@ MainWindow::MainWindow(QWidget* parent)
     // Link engine to view
     m_mapView->setSimulationEngine(m_engine);
     
+    // Graphe V2V complet seulement quand un consommateur le demande
+    m_engine->setLazyGraph(true);
+    
     LOG_INFO("MainWindow constructed");
 }
 
@@ -101,6 +113,55 @@ void MainWindow::createUI() {
     });
     leftLayout->addWidget(btnToggleRoads);
     
+    // Bouton pour activer la simulation MAC (beacons CSMA/CA à 10 Hz)
+    QPushButton* btnToggleMac = new QPushButton("📡 Simulation MAC", leftPanel);
+    btnToggleMac->setCheckable(true);
+    btnToggleMac->setStyleSheet("QPushButton { background-color: #00796B; color: white; padding: 8px; border-radius: 5px; }"
+                               "QPushButton:hover { background-color: #00695C; }"
+                               "QPushButton:checked { background-color: #4CAF50; }");
+    connect(btnToggleMac, &QPushButton::toggled, [this](bool checked) {
+        m_engine->getMacLayer()->setEnabled(checked);
+        m_statusMac->setVisible(checked);
+    });
+    leftLayout->addWidget(btnToggleMac);
+    
+    // Bouton pour activer les beacons CAM (10 Hz, débit adapté par DCC)
+    QPushButton* btnToggleBeacons = new QPushButton("📶 Beacons CAM (DCC)", leftPanel);
+    btnToggleBeacons->setCheckable(true);
+    btnToggleBeacons->setStyleSheet("QPushButton { background-color: #00796B; color: white; padding: 8px; border-radius: 5px; }"
+                                   "QPushButton:hover { background-color: #00695C; }"
+                                   "QPushButton:checked { background-color: #4CAF50; }");
+    connect(btnToggleBeacons, &QPushButton::toggled, [this](bool checked) {
+        m_engine->getBeaconScheduler()->setEnabled(checked);
+        m_statusBeacons->setVisible(checked);
+    });
+    leftLayout->addWidget(btnToggleBeacons);
+    
+    // Bouton pour activer l'attribution des canaux de service (véhicules colorés par canal)
+    QPushButton* btnToggleChannels = new QPushButton("🎚️ Canaux SCH", leftPanel);
+    btnToggleChannels->setCheckable(true);
+    btnToggleChannels->setStyleSheet("QPushButton { background-color: #00796B; color: white; padding: 8px; border-radius: 5px; }"
+                                    "QPushButton:hover { background-color: #00695C; }"
+                                    "QPushButton:checked { background-color: #4CAF50; }");
+    connect(btnToggleChannels, &QPushButton::toggled, [this](bool checked) {
+        m_engine->getChannelAssignment()->setEnabled(checked);
+        m_statusChannels->setVisible(checked);
+    });
+    leftLayout->addWidget(btnToggleChannels);
+    
+    // Bouton pour l'enregistrement des liens (statistiques de contacts et
+    // historique); désactivé, le graphe V2V n'est plus reconstruit à chaque update
+    QPushButton* btnToggleRecording = new QPushButton("⏺️ Enregistrement des liens", leftPanel);
+    btnToggleRecording->setCheckable(true);
+    btnToggleRecording->setChecked(m_engine->isRecording());
+    btnToggleRecording->setStyleSheet("QPushButton { background-color: #00796B; color: white; padding: 8px; border-radius: 5px; }"
+                                     "QPushButton:hover { background-color: #00695C; }"
+                                     "QPushButton:checked { background-color: #4CAF50; }");
+    connect(btnToggleRecording, &QPushButton::toggled, [this](bool checked) {
+        m_engine->setRecording(checked);
+    });
+    leftLayout->addWidget(btnToggleRecording);
+    
     // Séparateur
     QFrame* line2 = new QFrame(leftPanel);
     line2->setFrameShape(QFrame::HLine);
@@ -156,10 +217,19 @@ void MainWindow::createUI() {
     radiusLabel->setStyleSheet("font-weight: bold; color: #4CAF50;");
     leftLayout->addWidget(radiusLabel);
     
+    // Profil de rayon par classe, appliqué à toute la flotte de la classe
+    // (RSU: celles chargées sans rayon dans le CSV)
+    m_radiusClassComboBox = new QComboBox(leftPanel);
+    m_radiusClassComboBox->addItem("Cars", static_cast<int>(core::VehicleClass::Car));
+    m_radiusClassComboBox->addItem("Trucks", static_cast<int>(core::VehicleClass::Truck));
+    m_radiusClassComboBox->addItem("Roadside units", static_cast<int>(core::VehicleClass::RoadsideUnit));
+    m_radiusClassComboBox->setStyleSheet("QComboBox { background-color: #3b3b3b; color: white; padding: 8px; border: 1px solid #555; border-radius: 5px; font-size: 14px; }");
+    leftLayout->addWidget(m_radiusClassComboBox);
+    
     m_transmissionRadiusSpinBox = new QSpinBox(leftPanel);
     m_transmissionRadiusSpinBox->setMinimum(100);
     m_transmissionRadiusSpinBox->setMaximum(500);
-    m_transmissionRadiusSpinBox->setValue(300);
+    m_transmissionRadiusSpinBox->setValue(m_engine->getClassRadius(core::VehicleClass::Car));
     m_transmissionRadiusSpinBox->setSuffix(" m");
     m_transmissionRadiusSpinBox->setStyleSheet("QSpinBox { background-color: #3b3b3b; color: white; padding: 8px; border: 1px solid #555; border-radius: 5px; font-size: 14px; }"
                                               "QSpinBox::up-button, QSpinBox::down-button { background-color: #4CAF50; }");
@@ -184,18 +254,39 @@ void MainWindow::createToolbar() {
 void MainWindow::createStatusBar() {
     m_statusVehicles = new QLabel("Vehicles: 0", this);
     m_statusConnections = new QLabel("Connections: 0", this);
+    m_statusClusters = new QLabel("Clusters: 0", this);
+    m_statusMac = new QLabel("MAC: -", this);
+    m_statusMac->setVisible(false);
+    m_statusBeacons = new QLabel("CAM: -", this);
+    m_statusBeacons->setVisible(false);
+    m_statusRsu = new QLabel("RSU: -", this);
+    m_statusRsu->setVisible(false);
+    m_statusChannels = new QLabel("SCH: -", this);
+    m_statusChannels->setVisible(false);
+    m_statusTopology = new QLabel("Topology: -", this);
     m_statusSimTime = new QLabel("Time: 0.0s", this);
     
     statusBar()->addWidget(m_statusVehicles);
     statusBar()->addWidget(new QLabel(" | ", this));
     statusBar()->addWidget(m_statusConnections);
     statusBar()->addWidget(new QLabel(" | ", this));
+    statusBar()->addWidget(m_statusClusters);
+    statusBar()->addWidget(m_statusMac);
+    statusBar()->addWidget(m_statusBeacons);
+    statusBar()->addWidget(m_statusRsu);
+    statusBar()->addWidget(m_statusChannels);
+    statusBar()->addWidget(new QLabel(" | ", this));
+    statusBar()->addWidget(m_statusTopology);
+    statusBar()->addWidget(new QLabel(" | ", this));
     statusBar()->addWidget(m_statusSimTime);
 }
 
 void MainWindow::createMenuBar() {
     QMenu* fileMenu = menuBar()->addMenu("&File");
     fileMenu->addAction("&Load OSM...", this, &MainWindow::onLoadOSMFile);
+    fileMenu->addAction("Load &RSUs...", this, &MainWindow::onLoadRoadsideUnits);
+    fileMenu->addSeparator();
+    fileMenu->addAction("Run &Reports Folder...", this, &MainWindow::onSelectReportDirectory);
     fileMenu->addSeparator();
     fileMenu->addAction("E&xit", this, &QWidget::close);
 }
@@ -210,6 +301,8 @@ void MainWindow::connectSignals() {
             this, &MainWindow::onVehicleCountChanged);
     connect(m_transmissionRadiusSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
             this, &MainWindow::onTransmissionRadiusChanged);
+    connect(m_radiusClassComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onRadiusClassChanged);
     
     // Update status bar on each simulation tick
     connect(m_engine, &core::SimulationEngine::tick, this, [this]() {
@@ -217,11 +310,68 @@ void MainWindow::connectSignals() {
         int vehicleCount = m_engine->getVehicles().size();
         m_statusVehicles->setText(QString("Vehicles: %1").arg(vehicleCount));
         
-        // Update connection count
+        // Update connection count (version publiée du graphe, O(1); non
+        // comptées après un update paresseux)
         auto* interferenceGraph = m_engine->getInterferenceGraph();
         if (interferenceGraph) {
-            auto connections = interferenceGraph->getAllConnections();
-            m_statusConnections->setText(QString("Connections: %1").arg(connections.size()));
+            const auto snapshot = interferenceGraph->acquireSnapshot();
+            m_statusConnections->setText(snapshot->isComplete()
+                ? QString("Connections: %1").arg(snapshot->getConnectionCount())
+                : QString("Connections: - (lazy)"));
+        }
+        
+        // Update partition metrics (clusters, plus grand cluster, véhicules isolés)
+        auto* componentTracker = m_engine->getComponentTracker();
+        if (componentTracker) {
+            m_statusClusters->setText(QString("Clusters: %1 (largest %2, isolated %3%)")
+                .arg(componentTracker->getClusterCount())
+                .arg(componentTracker->getLargestClusterSize())
+                .arg(componentTracker->getIsolatedFraction() * 100.0, 0, 'f', 1));
+        }
+        
+        // Update MAC metrics (taux de livraison et occupation moyenne du canal)
+        auto* macLayer = m_engine->getMacLayer();
+        if (macLayer && macLayer->isEnabled()) {
+            const auto summary = macLayer->getSummary();
+            m_statusMac->setText(QString(" | MAC: PDR %1%, CBR %2% (max %3%)")
+                .arg(summary.packetDeliveryRatio * 100.0, 0, 'f', 1)
+                .arg(summary.channelBusyRatio * 100.0, 0, 'f', 1)
+                .arg(summary.maxChannelBusyRatio * 100.0, 0, 'f', 1));
+        }
+        
+        // Update CAM metrics (débit moyen, occupation du canal, véhicules bridés par DCC)
+        auto* beaconScheduler = m_engine->getBeaconScheduler();
+        if (beaconScheduler && beaconScheduler->isEnabled()) {
+            const auto summary = beaconScheduler->getSummary();
+            const size_t restricted = summary.vehicles - summary.dccStates[0];
+            m_statusBeacons->setText(QString(" | CAM: %1 Hz, CBR %2% (max %3%), DCC %4%")
+                .arg(summary.beaconRate, 0, 'f', 1)
+                .arg(summary.channelBusyRatio * 100.0, 0, 'f', 1)
+                .arg(summary.maxChannelBusyRatio * 100.0, 0, 'f', 1)
+                .arg(summary.vehicles > 0 ? restricted * 100.0 / summary.vehicles : 0.0, 0, 'f', 1));
+        }
+        
+        // Update V2I metrics (véhicules couverts, dont backhaul, handovers par heure de service)
+        auto* roadsideUnits = m_engine->getRoadsideUnits();
+        if (roadsideUnits && !roadsideUnits->empty()) {
+            const auto summary = roadsideUnits->getSummary();
+            const double percent = summary.vehicles > 0 ? 100.0 / summary.vehicles : 0.0;
+            m_statusRsu->setText(QString(" | RSU: covered %1% (backhaul %2%, V2V relay %3%), %4 handovers/h")
+                .arg(summary.covered * percent, 0, 'f', 1)
+                .arg(summary.backhaulCovered * percent, 0, 'f', 1)
+                .arg(summary.relayReachable * percent, 0, 'f', 1)
+                .arg(summary.handoverRate, 0, 'f', 0));
+        }
+        
+        // Update channel metrics (liens en conflit, changements de canal au dernier update du graphe)
+        auto* channelAssignment = m_engine->getChannelAssignment();
+        if (channelAssignment && channelAssignment->isEnabled()) {
+            const auto& summary = channelAssignment->getSummary();
+            m_statusChannels->setText(QString(" | SCH: %1 channels, conflicts %2 (%3%), %4 switches")
+                .arg(summary.channelsUsed)
+                .arg(summary.conflicts)
+                .arg(summary.conflictRatio * 100.0, 0, 'f', 1)
+                .arg(summary.recolored));
         }
         
         // Update simulation time
@@ -229,6 +379,21 @@ void MainWindow::connectSignals() {
         m_statusSimTime->setText(QString("Time: %1s").arg(simTime, 0, 'f', 1));
     });
     
+    // Update topology metrics (recalculées tous les N updates du graphe)
+    connect(m_engine, &core::SimulationEngine::graphMetricsUpdated, this, [this]() {
+        const auto& summary = m_engine->getGraphMetrics()->getSummary();
+        m_statusTopology->setText(QString("Topology: degree %1 (max %2), clustering %3, diameter >= %4, path %5")
+            .arg(summary.meanDegree, 0, 'f', 1)
+            .arg(summary.maxDegree)
+            .arg(summary.averageClustering, 0, 'f', 2)
+            .arg(summary.diameter)
+            .arg(summary.averagePathLength, 0, 'f', 1));
+        m_statusTopology->setToolTip(QString("Max betweenness %1 (vehicle %2), %3 ms")
+            .arg(summary.maxBetweenness, 0, 'f', 3)
+            .arg(summary.maxBetweennessVehicle)
+            .arg(summary.computeMs, 0, 'f', 0));
+    });
+    
     // Repaint map view on each simulation tick so vehicles update smoothly
     connect(m_engine, &core::SimulationEngine::tick, m_mapView, qOverload<>(&QWidget::update));
 }
@@ -274,7 +439,16 @@ void MainWindow::onVehicleCountChanged(int value) {
 }
 
 void MainWindow::onTransmissionRadiusChanged(int value) {
-    LOG_INFO(QString("Transmission radius set to: %1m").arg(value));
+    // Appliqué en bloc à la classe choisie (et aux véhicules créés ensuite)
+    const auto vehicleClass = static_cast<core::VehicleClass>(m_radiusClassComboBox->currentData().toInt());
+    m_engine->setClassRadius(vehicleClass, value);
+}
+
+void MainWindow::onRadiusClassChanged(int index) {
+    // Affiche le profil de la classe sans le réappliquer
+    const auto vehicleClass = static_cast<core::VehicleClass>(m_radiusClassComboBox->itemData(index).toInt());
+    QSignalBlocker blocker(m_transmissionRadiusSpinBox);
+    m_transmissionRadiusSpinBox->setValue(m_engine->getClassRadius(vehicleClass));
 }
 
 void MainWindow::updateControls() {
@@ -297,10 +471,16 @@ void MainWindow::onLoadOSMFile() {
         v2v::data::OSMParser parser;
         
         auto* roadGraph = m_engine->getRoadGraph();
-        if (parser.loadFile(filename.toStdString(), roadGraph)) {
-            LOG_INFO(QString("OSM file loaded successfully: %1 nodes, %2 edges")
+        auto buildings = std::make_shared<v2v::network::BuildingIndex>();
+        if (parser.loadFile(filename.toStdString(), roadGraph, buildings.get())) {
+            LOG_INFO(QString("OSM file loaded successfully: %1 nodes, %2 edges, %3 buildings")
                      .arg(roadGraph->getNodeCount())
-                     .arg(roadGraph->getEdgeCount()));
+                     .arg(roadGraph->getEdgeCount())
+                     .arg(buildings->getBuildingCount()));
+            
+            // Les bâtiments obstruent les liens V2V (aucun: espace dégagé)
+            m_engine->getInterferenceGraph()->setBuildingIndex(
+                buildings->empty() ? nullptr : std::move(buildings));
             
             // Recréer les véhicules pour qu'ils utilisent le nouveau graphe routier
             int currentVehicleCount = m_vehicleCountSpinBox->value();
@@ -331,6 +511,56 @@ void MainWindow::onLoadOSMFile() {
     }
 }
 
+void MainWindow::onLoadRoadsideUnits() {
+    QString filename = QFileDialog::getOpenFileName(
+        this,
+        "Load Roadside Units",
+        "../data",
+        "RSU Files (*.csv *.txt);;All Files (*)"
+    );
+    
+    if (filename.isEmpty()) {
+        return;
+    }
+    
+    LOG_INFO(QString("Loading roadside units: %1").arg(filename));
+    if (m_engine->loadRoadsideUnits(filename.toStdString())) {
+        const auto* roadsideUnits = m_engine->getRoadsideUnits();
+        const auto summary = roadsideUnits->getSummary();
+        m_statusRsu->setVisible(true);
+        
+        QMessageBox::information(
+            this,
+            "RSUs Loaded",
+            QString("Roadside units loaded successfully!\n\nUnits: %1 (%2 with backhaul)\nCoverage cells: %3")
+                .arg(summary.units)
+                .arg(summary.backhaulUnits)
+                .arg(roadsideUnits->getCoveredCellCount())
+        );
+        
+        m_mapView->update();
+    } else {
+        QMessageBox::warning(
+            this,
+            "Error",
+            "Failed to load roadside units. Check the log for details."
+        );
+    }
+}
+
+void MainWindow::onSelectReportDirectory() {
+    // Annulé: plus de rapports écrits à l'arrêt des runs
+    const QString directory = QFileDialog::getExistingDirectory(
+        this,
+        "Run Reports Folder",
+        QString::fromStdString(m_engine->getReportDirectory())
+    );
+    
+    m_engine->setReportDirectory(directory.toStdString());
+    LOG_INFO(directory.isEmpty() ? QString("Run reports disabled")
+                                 : QString("Run reports written to %1").arg(directory));
+}
+
 void MainWindow::loadSettings() {
     QSettings settings;
     restoreGeometry(settings.value("geometry").toByteArray());
@@ -2,6 +2,9 @@
 #include "core/SimulationEngine.hpp"
 #include "network/RoadGraph.hpp"
 #include "network/InterferenceGraph.hpp"
+#include "network/GraphSnapshot.hpp"
+#include "network/RoadsideUnits.hpp"
+#include "network/ChannelAssignment.hpp"
 #include "data/TileManager.hpp"
 #include "utils/Logger.hpp"
 #include <QPainter>
@@ -70,6 +73,9 @@ MapView::~MapView() {
 
 void MapView::setSimulationEngine(core::SimulationEngine* engine) {
     m_engine = engine;
+    if (m_engine) {
+        m_engine->setConnectionsVisible(m_showConnections);
+    }
 }
 
 void MapView::setCenter(double latitude, double longitude) {
@@ -101,6 +107,11 @@ void MapView::setShowVehicles(bool show) {
 
 void MapView::setShowConnections(bool show) {
     m_showConnections = show;
+    
+    // Graphe paresseux: l'affichage des liens demande l'adjacence complète
+    if (m_engine) {
+        m_engine->setConnectionsVisible(show);
+    }
     update();
 }
 
@@ -135,6 +146,31 @@ void MapView::paintEvent(QPaintEvent* event) {
     // Dessiner les tuiles OSM
     drawOSMTiles(painter);
     
+    // Dessiner les RSU (zone de couverture, puis nœud fixe: carré, vert si
+    // reliée au backhaul)
+    const network::RoadsideUnits* roadsideUnits = m_engine ? m_engine->getRoadsideUnits() : nullptr;
+    if (roadsideUnits && !roadsideUnits->empty()) {
+        for (const auto& unit : roadsideUnits->getUnits()) {
+            QPointF screenPos = latLonToScreen(unit.latitude, unit.longitude);
+            double radiusPixels = metersToPixels(unit.radius, unit.latitude);
+            
+            // Culling: disque entièrement hors écran
+            if (screenPos.x() + radiusPixels < 0 || screenPos.x() - radiusPixels > width() ||
+                screenPos.y() + radiusPixels < 0 || screenPos.y() - radiusPixels > height()) {
+                continue;
+            }
+            
+            const QColor color = unit.backhaul ? QColor(46, 125, 50) : QColor(255, 143, 0);
+            painter.setPen(QPen(QColor(color.red(), color.green(), color.blue(), 120), 1.5));
+            painter.setBrush(QColor(color.red(), color.green(), color.blue(), 25));
+            painter.drawEllipse(screenPos, radiusPixels, radiusPixels);
+            
+            painter.setPen(QPen(Qt::white, 1.5));
+            painter.setBrush(color);
+            painter.drawRect(QRectF(screenPos.x() - 6, screenPos.y() - 6, 12, 12));
+        }
+    }
+    
     // Dessiner les véhicules si activé
     if (m_showVehicles && m_engine) {
         const auto& vehicles = m_engine->getVehicles();
@@ -195,6 +231,10 @@ void MapView::paintEvent(QPaintEvent* event) {
         if (m_showConnections && visibleVehicles.size() < 500) {  // Seulement si < 500 véhicules visibles
             auto* interferenceGraph = m_engine->getInterferenceGraph();
             if (interferenceGraph) {
+                // Version publiée: cohérente pendant tout le dessin, même si le
+                // moteur reconstruit le graphe entre-temps
+                const auto snapshot = interferenceGraph->acquireSnapshot();
+                
                 // Limiter le nombre de connexions à dessiner (max 2000 pour performance)
                 const size_t maxConnectionsToDraw = 2000;
                 size_t connectionsDrawn = 0;
@@ -207,7 +247,7 @@ void MapView::paintEvent(QPaintEvent* event) {
                     if (connectionsDrawn >= maxConnectionsToDraw) break;
                     
                     int id1 = vehicle1->getId();
-                    auto neighbors = interferenceGraph->getNeighbors(id1);
+                    auto neighbors = snapshot->getNeighbors(id1);
                     
                     for (int id2 : neighbors) {
                         if (connectionsDrawn >= maxConnectionsToDraw) break;
@@ -233,11 +273,37 @@ void MapView::paintEvent(QPaintEvent* event) {
             }
         }
         
+        // Dessiner les liens V2I (véhicule -> RSU servante)
+        if (m_showConnections && roadsideUnits && !roadsideUnits->empty() && visibleVehicles.size() < 500) {
+            std::unordered_map<int, QPointF> unitIdToScreenPos;
+            for (const auto& unit : roadsideUnits->getUnits()) {
+                unitIdToScreenPos[unit.id] = latLonToScreen(unit.latitude, unit.longitude);
+            }
+            
+            painter.setPen(QPen(QColor(255, 143, 0, 150), 1.5, Qt::DashLine));
+            for (const auto& [vehicle, screenPos] : visibleVehicles) {
+                auto it = unitIdToScreenPos.find(roadsideUnits->getServingUnit(vehicle->getId()));
+                if (it != unitIdToScreenPos.end()) {
+                    painter.drawLine(screenPos, it->second);
+                }
+            }
+        }
+        
         // Dessiner les véhicules ULTRA-SIMPLIFIÉ pour supporter 2000 véhicules
         painter.setPen(Qt::NoPen);
         painter.setBrush(QColor(255, 50, 50));
         
+        // Attribution de canaux active: une teinte par canal de service
+        const network::ChannelAssignment* channels = m_engine->getChannelAssignment();
+        const bool colorByChannel = channels && channels->isEnabled();
+        const int channelCount = colorByChannel ? channels->getParameters().channelCount : 1;
+        
         for (const auto& [vehicle, screenPos] : visibleVehicles) {
+            if (colorByChannel) {
+                const int channel = channels->getChannel(vehicle->getId());
+                painter.setBrush(channel >= 0 ? QColor::fromHsv(channel * 360 / channelCount, 220, 255)
+                                              : QColor(160, 160, 160));
+            }
             // Simple cercle sans rotation ni flèche
             painter.drawEllipse(screenPos, 4, 4);
         }
@@ -246,8 +312,8 @@ void MapView::paintEvent(QPaintEvent* event) {
     // Dessiner le graphe routier si activé
     if (m_showRoadGraph && m_engine) {
         auto* roadGraph = m_engine->getRoadGraph();
-        if (roadGraph && roadGraph->getNodeCount() > 0) {
-            const auto& graph = roadGraph->getGraph();
+        if (roadGraph && !roadGraph->getNetwork().empty()) {
+            const network::RoadNetwork& roads = roadGraph->getNetwork();
             
             // Calculer la bounding box visible pour le culling
             const double margin = 100.0;
@@ -281,25 +347,24 @@ void MapView::paintEvent(QPaintEvent* event) {
             // Dessiner les arêtes (routes)
             painter.setPen(QPen(roadColor, roadWidth));
             
+            // Arêtes sortantes de chaque nœud (CSR), source projetée une fois
             int drawnEdges = 0;
-            auto [ei, ei_end] = boost::edges(graph);
-            for (auto it = ei; it != ei_end && drawnEdges < maxEdgesToDraw; ++it) {
-                auto source = boost::source(*it, graph);
-                auto target = boost::target(*it, graph);
-                
-                const auto& nodeSource = graph[source];
-                const auto& nodeTarget = graph[target];
-                
-                QPointF p1 = latLonToScreen(nodeSource.latitude, nodeSource.longitude);
-                QPointF p2 = latLonToScreen(nodeTarget.latitude, nodeTarget.longitude);
-                
-                // Culling: ne dessiner que si au moins un point est visible
+            const auto nodeCount = static_cast<network::RoadNetwork::NodeId>(roads.getNodeCount());
+            for (network::RoadNetwork::NodeId source = 0; source < nodeCount && drawnEdges < maxEdgesToDraw; ++source) {
+                QPointF p1 = latLonToScreen(roads.getLatitude(source), roads.getLongitude(source));
                 bool p1Visible = (p1.x() >= minX && p1.x() <= maxX && p1.y() >= minY && p1.y() <= maxY);
-                bool p2Visible = (p2.x() >= minX && p2.x() <= maxX && p2.y() >= minY && p2.y() <= maxY);
                 
-                if (p1Visible || p2Visible) {
-                    painter.drawLine(p1, p2);
-                    drawnEdges++;
+                for (auto e = roads.outBegin(source); e != roads.outEnd(source) && drawnEdges < maxEdgesToDraw; ++e) {
+                    const auto target = roads.getTarget(e);
+                    QPointF p2 = latLonToScreen(roads.getLatitude(target), roads.getLongitude(target));
+                    
+                    // Culling: ne dessiner que si au moins un point est visible
+                    bool p2Visible = (p2.x() >= minX && p2.x() <= maxX && p2.y() >= minY && p2.y() <= maxY);
+                    
+                    if (p1Visible || p2Visible) {
+                        painter.drawLine(p1, p2);
+                        drawnEdges++;
+                    }
                 }
             }
             
@@ -321,10 +386,8 @@ void MapView::paintEvent(QPaintEvent* event) {
                     nodeSize = 3;
                 }
                 
-                auto [vi, vi_end] = boost::vertices(graph);
-                for (auto it = vi; it != vi_end && drawnNodes < maxNodes; ++it) {
-                    const auto& node = graph[*it];
-                    QPointF p = latLonToScreen(node.latitude, node.longitude);
+                for (network::RoadNetwork::NodeId node = 0; node < nodeCount && drawnNodes < maxNodes; ++node) {
+                    QPointF p = latLonToScreen(roads.getLatitude(node), roads.getLongitude(node));
                     
                     // Culling: ne dessiner que les nœuds visibles
                     if (p.x() >= minX && p.x() <= maxX && p.y() >= minY && p.y() <= maxY) {